@@ -0,0 +1,140 @@
+/*!
+*      \file CurvatureKernel.h
+*      \brief Corner angles of blocks of triangles, stored as structure of arrays
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_CURVATURE_KERNEL_H_
+#define _MESHLIB_CURVATURE_KERNEL_H_
+
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "Geometry/Point.h"
+#include "Parallel/ThreadPool.h"
+
+namespace MeshLib
+{
+
+/*!
+*	\brief CTriangleBlock, the corners of up to SIZE triangles and their angles
+*
+*	The coordinates are stored per corner and per axis, x[i][t] is the x coordinate of
+*	corner i of triangle t, such that angles() runs plain loops over contiguous arrays,
+*	which the compiler vectorizes. The angle at a corner with edge vectors u and w is
+*	atan2( |u x w|, u.w ), accurate for small and flat angles, where the law of cosines
+*	loses digits in acos, and 0 instead of NaN for a degenerate corner. |u x w| is twice
+*	the area at every corner, and the third angle is PI minus the others, so a triangle
+*	costs one cross product, two dot products and two atan2.
+*/
+struct CTriangleBlock
+{
+	enum { SIZE = 64 };
+
+	/*! number of triangles in the block */
+	int    n;
+	/*! corner coordinates */
+	double x[3][SIZE], y[3][SIZE], z[3][SIZE];
+	/*! corner angles, filled by angles() */
+	double angle[3][SIZE];
+
+	/*! Store p as corner i of triangle t. */
+	void set( int t, int i, const CPoint & p )
+	{
+		x[i][t] = p[0];
+		y[i][t] = p[1];
+		z[i][t] = p[2];
+	};
+
+	/*! Compute the angles of the n triangles. */
+	void angles()
+	{
+		double s[SIZE], c0[SIZE], c1[SIZE];
+		for( int t = 0; t < n; t ++ )
+		{
+			//edge vectors e0 = p1 - p0, e1 = p2 - p1, e2 = p0 - p2
+			double e0x = x[1][t] - x[0][t], e0y = y[1][t] - y[0][t], e0z = z[1][t] - z[0][t];
+			double e1x = x[2][t] - x[1][t], e1y = y[2][t] - y[1][t], e1z = z[2][t] - z[1][t];
+			double e2x = x[0][t] - x[2][t], e2y = y[0][t] - y[2][t], e2z = z[0][t] - z[2][t];
+			double cx = e0y * e1z - e0z * e1y;
+			double cy = e0z * e1x - e0x * e1z;
+			double cz = e0x * e1y - e0y * e1x;
+			s[t]  = sqrt( cx * cx + cy * cy + cz * cz );
+			c0[t] = - ( e0x * e2x + e0y * e2y + e0z * e2z );
+			c1[t] = - ( e1x * e0x + e1y * e0y + e1z * e0z );
+		}
+		for( int t = 0; t < n; t ++ ) angle[0][t] = atan2( s[t], c0[t] );
+		for( int t = 0; t < n; t ++ ) angle[1][t] = atan2( s[t], c1[t] );
+		for( int t = 0; t < n; t ++ ) angle[2][t] = 3.14159265358979323846 - angle[0][t] - angle[1][t];
+	};
+};
+
+/*!
+	Corner angles of a single triangle, the same arithmetic as CTriangleBlock::angles(), so
+	the angles are equal to those of a block.
+	\param p0,p1,p2 corners of the triangle
+	\param angle the angles at p0, p1 and p2
+*/
+inline void triangle_angles( const CPoint & p0, const CPoint & p1, const CPoint & p2, double angle[3] )
+{
+	double e0x = p1[0] - p0[0], e0y = p1[1] - p0[1], e0z = p1[2] - p0[2];
+	double e1x = p2[0] - p1[0], e1y = p2[1] - p1[1], e1z = p2[2] - p1[2];
+	double e2x = p0[0] - p2[0], e2y = p0[1] - p2[1], e2z = p0[2] - p2[2];
+	double cx = e0y * e1z - e0z * e1y;
+	double cy = e0z * e1x - e0x * e1z;
+	double cz = e0x * e1y - e0y * e1x;
+	double s  = sqrt( cx * cx + cy * cy + cz * cz );
+	angle[0] = atan2( s, - ( e0x * e2x + e0y * e2y + e0z * e2z ) );
+	angle[1] = atan2( s, - ( e1x * e0x + e1y * e0y + e1z * e0z ) );
+	angle[2] = 3.14159265358979323846 - angle[0] - angle[1];
+};
+
+/*!
+	Compute the corner angles of the triangles [first,last) block by block.
+	\param gather  gather( f, block, t ) stores the corners of triangle f as triangle t of block
+	\param scatter scatter( f, block, t ) reads the angles of triangle f, triangle t of block
+*/
+template<typename G, typename S>
+void for_triangle_blocks( size_t first, size_t last, const G & gather, const S & scatter )
+{
+	CTriangleBlock block;
+	for( size_t f = first; f < last; f += CTriangleBlock::SIZE )
+	{
+		block.n = (int) std::min( (size_t) CTriangleBlock::SIZE, last - f );
+		for( int t = 0; t < block.n; t ++ ) gather( f + t, block, t );
+		block.angles();
+		for( int t = 0; t < block.n; t ++ ) scatter( f + t, block, t );
+	}
+};
+
+/*!
+	Corner angles of all the faces of a triangle mesh, in parallel blocks of triangles. The
+	angle at the target of a halfedge is stored in the halfedge.
+	\tparam M mesh class, with faceVertices, faceHalfedges and an angle() halfedge trait
+*/
+template<typename M>
+void face_corner_angles( M * pMesh )
+{
+	std::vector<typename M::CFace*> faces( pMesh->faces().begin(), pMesh->faces().end() );
+	parallel_for_chunks( 0, faces.size(), [&]( size_t first, size_t last, int )
+	{
+		for_triangle_blocks( first, last, [&]( size_t f, CTriangleBlock & block, int t )
+		{
+			std::array<typename M::CVertex*,3> v = pMesh->faceVertices( faces[f] );
+			for( int i = 0; i < 3; i ++ ) block.set( t, i, v[i]->point() );
+		},
+		[&]( size_t f, const CTriangleBlock & block, int t )
+		{
+			//the halfedge faceHalfedges( f )[i] targets faceVertices( f )[i]
+			std::array<typename M::CHalfEdge*,3> h = pMesh->faceHalfedges( faces[f] );
+			for( int i = 0; i < 3; i ++ ) h[i]->angle() = block.angle[i][t];
+		} );
+	} );
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_CURVATURE_KERNEL_H_ defined
@@ -1,225 +1,632 @@
-/*!
-*      \file GaussCurvature.h
-*      \brief Algorithm for Gauss Curvature
-*	   \author David Gu
-*      \date Document 02/13/2014
-*
-*/
-
-
-#ifndef _GAUSS_CURVATURE_H_
-#define _GAUSS_CURVATURE_H_
-
-#include <vector>
-#include "Mesh/iterators.h"
-#include "GaussCurvatureMesh.h"
-
-#ifndef PI
-#define PI 3.14159265358979323846
-#endif
-namespace MeshLib
-{
-
-	template<typename M>
-	class CGaussCurvature
-	{
-	public:
-		/*!	CGaussCurvature constructor
-		 *	\param pMesh the input mesh
-		 */
-		CGaussCurvature( M* pMesh);
-		/*!	CHarmonicMapper destructor
-		 */
-		~CGaussCurvature();
-		/*!  Compute the harmonic map using direct method
-		 */
-		void _calculate_curvature();
-		/*!	Compute face normal
-		 */
-		void _calculate_face_normal();
-		/*!	Compute vertex normal
-		 */
-		void _calculate_vertex_normal();
-		/*! Compute Euler number
-		 */
-		void _calculate_Euler_characteristics();
-
-	protected:
-		/*!	The input surface mesh
-		 */
-		M* m_pMesh;
-		/*	boundary
-		 */
-		typename M::CBoundary m_boundary;
-	};
-
-double _cosine_law( double a, double b, double c )
-{
-          double cs =  ( a*a + b * b  - c * c )/( 2.0 * a * b );
-          assert( cs <= 1.0 && cs >= -1.0 );
-          return acos( cs );    
-};
-
-
-/*!	CHarmonicMapper constructor 
-*	Count the number of interior vertices, boundary vertices and the edge weight
-*
-*/
-template<typename M>
-CGaussCurvature<M>::CGaussCurvature( M* pMesh ): m_pMesh( pMesh ), m_boundary( pMesh )
-{
-	for( M::MeshVertexIterator viter( m_pMesh ); !viter.end(); ++ viter )
-	{
-		M::CVertex * pV = *viter;
-		pV->k() = 0;
-	}
-};
-
-/*!
- *	CGaussCurvature destructor
- */
-template<typename M>
-CGaussCurvature<M>::~CGaussCurvature()
-{
-};
-
-
-//Set the boundary vertices to the unit circle
-/*!
- *	Fix the boundary using arc length parameter
- */
-template<typename M>
-void CGaussCurvature<M>::_calculate_curvature()
-{
-	//insert your code here	
-	double sum=0.0;
-	double k_i;
-	//calculate edge length
-	for(M::MeshEdgeIterator eiter(m_pMesh);!eiter.end();++eiter)
-	{
-		M::CEdge *pE = *eiter;
-		M::CVertex *pV1 = m_pMesh->edgeVertex1(pE);
-		M::CVertex *pV2 = m_pMesh->edgeVertex2(pE);
-		pE->length() = (pV1->point() - pV2->point()).norm();
-	}
-	//calculate corner angle
-    //std::cout << "I am here!"<< std::endl;;
-	for(M::MeshFaceIterator fiter(m_pMesh);!fiter.end();++fiter)
-	{
-			M::CFace *pF = *fiter;
-			std::vector<M::CHalfEdge*> v;
-			std::vector<double> len;
-		for(M::FaceHalfedgeIterator fhiter(pF);!fhiter.end();++fhiter)
-		{
-			M::CHalfEdge *he = *fhiter;
-			v.push_back(he); 
-			len.push_back(((CGaussEdge*)he->edge())->length());
-		}	
-			 v[0]->angle() = _cosine_law(len[0],len[1],len[2]);
-			 v[1]->angle() = _cosine_law(len[1],len[2],len[0]);
-			 v[2]->angle() = _cosine_law(len[0],len[2],len[1]);	
-			 v.clear();
-			 len.clear();
-			// std::cout<<"I am here!"<<std::endl;
-	}
-
-	//caculate curvature
-	for(M::MeshVertexIterator viter(m_pMesh); !viter.end();++viter)
-	{
-		M::CVertex *pV = *viter;
-		//if vertex is on the boundary
-		if(pV->boundary()){
-			 k_i = PI;
-			for(M::VertexInHalfedgeIterator vihiter(m_pMesh,pV);!vihiter.end();++vihiter)
-			{
-				M::CHalfEdge *ihe = *vihiter;
-				k_i -= ihe->angle();
-			}
-		}
-		//if vertex is not on the boundary
-		else{
-			 k_i = 2*PI;
-			for(M::VertexInHalfedgeIterator vihiter(m_pMesh,pV);!vihiter.end();++vihiter)
-			{
-				M::CHalfEdge *ihe = *vihiter;
-				k_i -= ihe->angle();
-			}
-		}
-		sum += k_i; 
-	}
-	std::cout << "Total Curvature is " <<  sum/PI << " PI" << std::endl;;
-}
-
-/*!
- *	Compute face normal
- */
-template<typename M>
-void CGaussCurvature<M>::_calculate_face_normal()
-{
-	//insert your code here
-	for(M::MeshFaceIterator fiter(m_pMesh);!fiter.end();++fiter)
-	{
-
-		M::CFace *pF=*fiter;	
-		CPoint d;
-		std::vector<CPoint> v;
-		for(M::FaceVertexIterator fviter(pF);!fviter.end();++fviter)
-		{
-			M::CVertex *pV=*fviter;		
-			CPoint p= pV->point();
-			v.push_back(p);
-		}
-			d=(v[1]-v[0])^(v[2]-v[0]);
-			pF->area() = 1/2*d.norm();
-			pF->normal() = d/d.norm();
-			v.clear();
-	}
-}
-
-/*!
- *	Compute vertex normal
- */
-template<typename M>
-void CGaussCurvature<M>::_calculate_vertex_normal()
-{
-	//insert your code here 
-	for(M::MeshVertexIterator viter(m_pMesh);!viter.end();++viter)
-	{
-		M::CVertex *pV=*viter;
-		CPoint d,d_i; //d is the sum of the normal, d_i is the average normal
-		double s=0.0; //the area for each face
-		for(M::VertexFaceIterator vfiter(pV);!vfiter.end();++vfiter)
-		{
-			M::CFace *pF= *vfiter;
-			d += (pF->normal())*(pF->area());
-			s += pF->area();
-		}
-		d_i = d/s;
-		pV->normal()=d_i/d_i.norm();
-	}
-}
-
-/*!
- *  Calculate Euler characteristics number
- */
-template<typename M>
-void CGaussCurvature<M>::_calculate_Euler_characteristics()
-{
-	//insert your code in this function
-	int V, E, F;
-	V = m_pMesh->numVertices();
-	E = m_pMesh->numEdges();
-	F = m_pMesh->numFaces();
-	std::cout << "Vertices: " << V << " Faces: " << F << " Edges: " << E << std::endl;
-	int euler = V + F - E;
-	std::cout << "Euler Characteristic Number " << euler << std::endl;	
-	int b;
-	int g;
-	b = M::CBoundary(m_boundary).loops().size(); 
-	std::cout << "Number of boundaries " << b << std::endl;
-	g = (2-b-euler)/2;
-	std::cout << "Genus " << g << std::endl;
-}
-};
-#endif
-
+/*!
+*      \file GaussCurvature.h
+*      \brief Algorithm for Gauss Curvature
+*	   \author David Gu
+*      \date Document 02/13/2014
+*
+*/
+
+
+#ifndef _GAUSS_CURVATURE_H_
+#define _GAUSS_CURVATURE_H_
+
+#include <vector>
+#include <algorithm>
+#include "Mesh/iterators.h"
+#include "GaussCurvatureMesh.h"
+#include "Mesh/CornerTable.h"
+#include "Mesh/PairedHalfEdgeMesh.h"
+#include "Parallel/ParallelFor.h"
+#include "CurvatureKernel.h"
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+namespace MeshLib
+{
+
+	template<typename M>
+	class CGaussCurvature
+	{
+	public:
+		/*!	CGaussCurvature constructor
+		 *	\param pMesh the input mesh
+		 */
+		CGaussCurvature( M* pMesh);
+		/*!	CHarmonicMapper destructor
+		 */
+		~CGaussCurvature();
+		/*!  Compute the harmonic map using direct method
+		 */
+		void _calculate_curvature();
+		/*!	Compute face normal
+		 */
+		void _calculate_face_normal();
+		/*!	Compute vertex normal
+		 */
+		void _calculate_vertex_normal();
+		/*! Compute Euler number
+		 */
+		void _calculate_Euler_characteristics();
+
+		/*!	Update the curvature after an edit, which created the faces f[0..n-1], e.g. the three
+		 *	faces of a split or the two of a flip. The corner angles of the faces are computed,
+		 *	their vertices sum up their rings again, the other vertices keep their curvature.
+		 *	Vertices without faces are not counted, until faces are created around them. It is
+		 *	the observer of the edits of a CDelaunayTriangulation, for instance.
+		 */
+		void _update_faces( typename M::CFace * f[], int n );
+		/*!	Update the curvature after the point of v moved, the angles of the faces around v
+		 *	and the curvature of v and its neighbors are computed again.
+		 */
+		void _update_vertex( typename M::CVertex * v );
+		/*!	Total curvature, computed by _calculate_curvature and kept up to date by the updates
+		 */
+		double _total_curvature() { return m_total.value(); };
+
+	protected:
+		/*!	Corner angles of a face, stored in its halfedges
+		 */
+		void _face_angles( typename M::CFace * f );
+		/*!	Curvature of a vertex, 2PI ( PI on the boundary ) minus the angles of its ring
+		 */
+		double _vertex_curvature( typename M::CVertex * v );
+		/*!	Compute the curvature of the vertices again, and the total with it
+		 */
+		void _update_curvature( std::vector<typename M::CVertex*> & verts );
+
+		/*!	The input surface mesh
+		 */
+		M* m_pMesh;
+		/*	boundary
+		 */
+		typename M::CBoundary m_boundary;
+		/*	total curvature
+		 */
+		CCompensatedSum m_total;
+	};
+
+/*!
+ *	Print the Euler characteristic and genus of every component, if there are several
+ */
+inline void _print_components( const std::vector<CComponent> & components )
+{
+	if( components.size() < 2 ) return;
+	std::cout << "Number of components " << components.size() << std::endl;
+	for( size_t c = 0; c < components.size(); c ++ )
+	{
+		const CComponent & comp = components[c];
+		std::cout << "Component " << c << ": Vertices: " << comp.vertices << " Faces: " << comp.faces << " Edges: " << comp.edges
+			<< " Euler Characteristic Number " << comp.euler() << " Number of boundaries " << comp.boundaries
+			<< " Genus " << comp.genus() << std::endl;
+	}
+};
+
+
+/*!	CHarmonicMapper constructor 
+*	Count the number of interior vertices, boundary vertices and the edge weight
+*
+*/
+template<typename M>
+CGaussCurvature<M>::CGaussCurvature( M* pMesh ): m_pMesh( pMesh ), m_boundary( pMesh )
+{
+	for( M::MeshVertexIterator viter( m_pMesh ); !viter.end(); ++ viter )
+	{
+		M::CVertex * pV = *viter;
+		pV->k() = 0;
+	}
+};
+
+/*!
+ *	CGaussCurvature destructor
+ */
+template<typename M>
+CGaussCurvature<M>::~CGaussCurvature()
+{
+};
+
+/*!
+ *	Compute the edge lengths, the corner angles and the curvature of the vertices
+ */
+template<typename M>
+void CGaussCurvature<M>::_calculate_curvature()
+{
+	//every pass runs in parallel, an element only writes its own traits
+	//calculate edge length
+	parallel_for_edges( m_pMesh, [&]( M::CEdge * pE )
+	{
+		pE->length() = ( m_pMesh->edgeVertex1( pE )->point() - m_pMesh->edgeVertex2( pE )->point() ).norm();
+	} );
+
+	//calculate corner angle, from the vertex positions in blocks of triangles, see CTriangleBlock
+	face_corner_angles( m_pMesh );
+
+	//caculate curvature, 2PI ( PI on the boundary ) minus the corner angles, and the sum
+	//a vertex sums its own angles in ring order, the total is compensated and summed in list
+	//order, such that the output does not depend on the number of threads
+	m_total = parallel_reduce_vertices( m_pMesh, CCompensatedSum(), [&]( M::CVertex * pV, CCompensatedSum & s )
+	{
+		pV->k() = _vertex_curvature( pV );
+		s.add( pV->k() ); 
+	}, []( CCompensatedSum & s, const CCompensatedSum & t ){ s.add( t ); } );
+	std::cout << "Total Curvature is " <<  m_total.value()/PI << " PI" << std::endl;;
+}
+
+/*!
+ *	Corner angles of a face, the angle of a halfedge is at its target
+ */
+template<typename M>
+void CGaussCurvature<M>::_face_angles( typename M::CFace * f )
+{
+	std::array<M::CVertex*,3>   v = m_pMesh->faceVertices( f );
+	std::array<M::CHalfEdge*,3> h = m_pMesh->faceHalfedges( f );
+	double angle[3];
+	triangle_angles( v[0]->point(), v[1]->point(), v[2]->point(), angle );
+	for( int i = 0; i < 3; i ++ ) h[i]->angle() = angle[i];
+}
+
+/*!
+ *	Curvature of a vertex from the angles of its ring
+ */
+template<typename M>
+double CGaussCurvature<M>::_vertex_curvature( typename M::CVertex * v )
+{
+	double k = v->boundary() ? PI : 2*PI;
+	for( M::CHalfEdge * ihe : vertex_in_halfedges( m_pMesh, v ) )
+	{
+		k -= ihe->angle();
+	}
+	return k;
+}
+
+/*!
+ *	Curvature of the vertices, the total changes by the differences
+ */
+template<typename M>
+void CGaussCurvature<M>::_update_curvature( std::vector<typename M::CVertex*> & verts )
+{
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		M::CVertex * pV = verts[i];
+		double k = _vertex_curvature( pV );
+		m_total.add( k - pV->k() );
+		pV->k() = k;
+	}
+}
+
+/*!
+ *	Update after the faces f[0..n-1] were created
+ */
+template<typename M>
+void CGaussCurvature<M>::_update_faces( typename M::CFace * f[], int n )
+{
+	std::vector<M::CVertex*> verts;
+	for( int i = 0; i < n; i ++ )
+	{
+		_face_angles( f[i] );
+		for( M::CVertex * pV : m_pMesh->faceVertices( f[i] ) )
+		{
+			if( std::find( verts.begin(), verts.end(), pV ) == verts.end() ) verts.push_back( pV );
+		}
+	}
+	_update_curvature( verts );
+}
+
+/*!
+ *	Update after v moved
+ */
+template<typename M>
+void CGaussCurvature<M>::_update_vertex( typename M::CVertex * v )
+{
+	std::vector<M::CVertex*> verts( 1, v );
+	for( M::CFace * pF : vertex_faces<M>( v ) )
+	{
+		_face_angles( pF );
+	}
+	for( M::CVertex * pW : vertex_vertices<M>( v ) )
+	{
+		verts.push_back( pW );
+	}
+	_update_curvature( verts );
+}
+
+/*!
+ *	Compute face normal
+ */
+template<typename M>
+void CGaussCurvature<M>::_calculate_face_normal()
+{
+	parallel_for_faces( m_pMesh, [&]( M::CFace * pF )
+	{
+		CPoint d;
+		std::array<M::CVertex*,3> v = m_pMesh->faceVertices( pF );
+			d=(v[1]->point()-v[0]->point())^(v[2]->point()-v[0]->point());
+			pF->area() = d.norm()/2.0;
+			pF->normal() = d/d.norm();
+	} );
+}
+
+/*!
+ *	Compute vertex normal
+ */
+template<typename M>
+void CGaussCurvature<M>::_calculate_vertex_normal()
+{
+	parallel_for_vertices( m_pMesh, [&]( M::CVertex * pV )
+	{
+		CPoint d,d_i; //d is the sum of the normal, d_i is the average normal
+		double s=0.0; //the area for each face
+		for( M::CFace * pF : vertex_faces<M>( pV ) )
+		{
+			d += (pF->normal())*(pF->area());
+			s += pF->area();
+		}
+		d_i = d/s;
+		pV->normal()=d_i/d_i.norm();
+	} );
+}
+
+/*!
+ *  Calculate Euler characteristics number
+ */
+template<typename M>
+void CGaussCurvature<M>::_calculate_Euler_characteristics()
+{
+	int V, E, F;
+	V = m_pMesh->numVertices();
+	E = m_pMesh->numEdges();
+	F = m_pMesh->numFaces();
+	std::cout << "Vertices: " << V << " Faces: " << F << " Edges: " << E << std::endl;
+	int euler = V + F - E;
+	std::cout << "Euler Characteristic Number " << euler << std::endl;	
+	int b;
+	int g;
+	b = (int) m_boundary.loops().size(); 
+	std::cout << "Number of boundaries " << b << std::endl;
+	g = (2-b-euler)/2;
+	std::cout << "Genus " << g << std::endl;
+
+	//the genus above assumes one component, report each of several
+	typename M::CComponents components( m_pMesh, m_boundary );
+	_print_components( components.components() );
+}
+
+/*!
+ *	\brief CGaussCurvature<CCornerTable>, the same algorithm on a corner table
+ *
+ *	Every step is a parallel loop over faces or vertices. A vertex gathers the values of its
+ *	corners by swinging around it, in the same order on any number of threads, so the
+ *	results do not depend on the number of threads. The results are stored in the optional arrays of the
+ *	corner table, such that CCornerTable::write_m outputs them as traits.
+ */
+template<>
+class CGaussCurvature<CCornerTable>
+{
+public:
+	/*!	CGaussCurvature constructor
+	 *	\param pMesh the input mesh
+	 */
+	CGaussCurvature( CCornerTable * pMesh ) : m_pMesh( pMesh )
+	{
+		m_pMesh->vertexCurvatures().assign( m_pMesh->numVertices(), 0.0 );
+	};
+	/*!	Compute the Gaussian curvature of every vertex
+	 */
+	void _calculate_curvature();
+	/*!	Compute face normal and area
+	 */
+	void _calculate_face_normal();
+	/*!	Compute vertex normal
+	 */
+	void _calculate_vertex_normal();
+	/*! Compute Euler number
+	 */
+	void _calculate_Euler_characteristics();
+
+protected:
+	/*!	The input surface mesh
+	 */
+	CCornerTable * m_pMesh;
+	/*!	Corner angles
+	 */
+	std::vector<double> m_angle;
+};
+
+/*!
+ *	Compute the Gaussian curvature, 2PI ( PI on the boundary ) minus the corner angles
+ */
+inline void CGaussCurvature<CCornerTable>::_calculate_curvature()
+{
+	int nv = m_pMesh->numVertices();
+	int nf = m_pMesh->numFaces();
+	const std::vector<int>    & V = m_pMesh->corners();
+	const std::vector<CPoint> & P = m_pMesh->points();
+
+	//corner angles, in blocks of triangles, see CTriangleBlock
+	m_angle.resize( 3 * nf );
+	parallel_for_chunks( 0, nf, [&]( size_t first, size_t last, int )
+	{
+		for_triangle_blocks( first, last, [&]( size_t f, CTriangleBlock & block, int t )
+		{
+			for( int i = 0; i < 3; i ++ ) block.set( t, i, P[V[3*f+i]] );
+		},
+		[&]( size_t f, const CTriangleBlock & block, int t )
+		{
+			for( int i = 0; i < 3; i ++ ) m_angle[3*f+i] = block.angle[i][t];
+		} );
+	} );
+
+	//a vertex subtracts the angles of its corners ccwly from the most clw one,
+	//isolated vertices have no curvature; the sum of the small deficits is compensated
+	std::vector<double> & k = m_pMesh->vertexCurvatures();
+	k.resize( nv );
+	double sum = parallel_sum( 0, nv, [&]( size_t v ) -> double
+	{
+		int c0 = m_pMesh->vertexCorner( (int) v );
+		if( c0 < 0 ) return k[v] = 0;
+		double k_v = m_pMesh->vertexBoundary( (int) v ) ? PI : 2*PI;
+		int c = c0;
+		while( c >= 0 )
+		{
+			k_v -= m_angle[c];
+			c = m_pMesh->ccw_swing( c );
+			if( c == c0 ) break;
+		}
+		return k[v] = k_v;
+	} );
+	std::cout << "Total Curvature is " <<  sum/PI << " PI" << std::endl;;
+}
+
+/*!
+ *	Compute face normal and area
+ */
+inline void CGaussCurvature<CCornerTable>::_calculate_face_normal()
+{
+	int nf = m_pMesh->numFaces();
+	const std::vector<int>    & V = m_pMesh->corners();
+	const std::vector<CPoint> & P = m_pMesh->points();
+	std::vector<CPoint> & normal  = m_pMesh->faceNormals();
+	std::vector<double> & area    = m_pMesh->faceAreas();
+
+	normal.resize( nf );
+	area.resize( nf );
+	parallel_for( 0, nf, [&]( size_t f )
+	{
+		const CPoint & p0 = P[V[3*f]];
+		CPoint d = ( P[V[3*f+1]] - p0 ) ^ ( P[V[3*f+2]] - p0 );
+		double n = d.norm();
+		area[f]   = n / 2.0;
+		normal[f] = d / n;
+	} );
+}
+
+/*!
+ *	Compute vertex normal, the area weighted average of the face normals
+ */
+inline void CGaussCurvature<CCornerTable>::_calculate_vertex_normal()
+{
+	int nv = m_pMesh->numVertices();
+
+	if( (int) m_pMesh->faceNormals().size() != m_pMesh->numFaces() ) _calculate_face_normal();
+	const std::vector<CPoint> & fn = m_pMesh->faceNormals();
+	const std::vector<double> & fa = m_pMesh->faceAreas();
+
+	//a vertex gathers its faces ccwly from the most clw corner
+	std::vector<CPoint> & normal = m_pMesh->vertexNormals();
+	normal.resize( nv );
+	parallel_for( 0, nv, [&]( size_t v )
+	{
+		CPoint d( 0, 0, 0 );
+		int c0 = m_pMesh->vertexCorner( (int) v );
+		int c  = c0;
+		while( c >= 0 )
+		{
+			d += fn[c/3] * fa[c/3];
+			c = m_pMesh->ccw_swing( c );
+			if( c == c0 ) break;
+		}
+		double n = d.norm();
+		normal[v] = ( n > 0 ) ? d / n : d;
+	} );
+}
+
+/*!
+ *  Calculate Euler characteristics number, the boundary loops are traced through the
+ *	corners facing boundary edges
+ */
+inline void CGaussCurvature<CCornerTable>::_calculate_Euler_characteristics()
+{
+	int V = m_pMesh->numVertices();
+	int E = m_pMesh->numEdges();
+	int F = m_pMesh->numFaces();
+	std::cout << "Vertices: " << V << " Faces: " << F << " Edges: " << E << std::endl;
+	int euler = V + F - E;
+	std::cout << "Euler Characteristic Number " << euler << std::endl;
+
+	//the boundary edge facing corner c runs from V[next(c)] to V[prev(c)]
+	int nc = m_pMesh->numCorners();
+	std::vector<int> boundary_out( V, -1 );
+	for( int c = 0; c < nc; c ++ )
+	{
+		if( !m_pMesh->cornerBoundary( c ) ) continue;
+		boundary_out[ m_pMesh->V( CCornerTable::next( c ) ) ] = c;
+	}
+
+	int b = 0;
+	std::vector<char> visited( nc, 0 );
+	std::vector<int> loop_start;
+	for( int c = 0; c < nc; c ++ )
+	{
+		if( !m_pMesh->cornerBoundary( c ) || visited[c] ) continue;
+		b ++;
+		loop_start.push_back( c );
+		int d = c;
+		while( d >= 0 && !visited[d] )
+		{
+			visited[d] = 1;
+			d = boundary_out[ m_pMesh->V( CCornerTable::prev( d ) ) ];
+		}
+	}
+	std::cout << "Number of boundaries " << b << std::endl;
+	int g = (2-b-euler)/2;
+	std::cout << "Genus " << g << std::endl;
+
+	//the genus above assumes one component, label them by the vertices of the corners
+	CUnionFind sets( V );
+	for( int c = 0; c < nc; c ++ )
+		sets.unite( m_pMesh->V( c ), m_pMesh->V( CCornerTable::next( c ) ) );
+	std::vector<int> label;
+	std::vector<CComponent> components( sets.labels( label ) );
+	for( int v = 0; v < V; v ++ ) components[ label[v] ].vertices ++;
+	for( int c = 0; c < nc; c ++ )
+	{
+		//an interior edge has two corners facing it, a boundary edge one
+		CComponent & comp = components[ label[ m_pMesh->V( c ) ] ];
+		int o = m_pMesh->O( c );
+		if( o < 0 || c < o ) comp.edges ++;
+		if( c % 3 == 0 ) comp.faces ++;
+	}
+	for( size_t l = 0; l < loop_start.size(); l ++ )
+		components[ label[ m_pMesh->V( loop_start[l] ) ] ].boundaries ++;
+	_print_components( components );
+}
+
+/*!
+ *	\brief CGaussCurvature<CPairedHalfEdgeMesh>, the same algorithm on the paired halfedge layout
+ *
+ *	The rings are visited by the paired iterators, whose rotations find the dual of a halfedge
+ *	as h^1 instead of through its edge. The angle of a face halfedge is at its target, as in
+ *	CGaussCurvature<M>, and a vertex sums the angles of its ring ccwly, so the results are those
+ *	of the pointer based mesh up to the rounding of an interior ring starting elsewhere. They
+ *	are stored in the optional arrays of the mesh.
+ */
+template<>
+class CGaussCurvature<CPairedHalfEdgeMesh>
+{
+public:
+	/*!	CGaussCurvature constructor
+	 *	\param pMesh the input mesh
+	 */
+	CGaussCurvature( CPairedHalfEdgeMesh * pMesh ) : m_pMesh( pMesh )
+	{
+		m_pMesh->vertexCurvatures().assign( m_pMesh->numVertices(), 0.0 );
+		m_total = 0;
+	};
+	/*!	Compute the Gaussian curvature of every vertex
+	 */
+	void _calculate_curvature();
+	/*!	Compute face normal and area
+	 */
+	void _calculate_face_normal();
+	/*!	Compute vertex normal
+	 */
+	void _calculate_vertex_normal();
+	/*!	Total curvature of the last _calculate_curvature
+	 */
+	double _total_curvature() { return m_total; };
+
+protected:
+	/*!	The input surface mesh
+	 */
+	CPairedHalfEdgeMesh * m_pMesh;
+	/*!	Corner angle of every halfedge, at its target, zero on the boundary
+	 */
+	std::vector<double>   m_angle;
+	/*!	Total curvature
+	 */
+	double                m_total;
+};
+
+/*!
+ *	Compute the Gaussian curvature, 2PI ( PI on the boundary ) minus the corner angles
+ */
+inline void CGaussCurvature<CPairedHalfEdgeMesh>::_calculate_curvature()
+{
+	int nv = m_pMesh->numVertices();
+	int nf = m_pMesh->numFaces();
+
+	m_angle.assign( m_pMesh->numHalfEdges(), 0.0 );
+	parallel_for( 0, nf, [&]( size_t f )
+	{
+		int h[3];
+		h[0] = m_pMesh->faceHalfedge( (int) f );
+		h[1] = m_pMesh->halfedgeNext( h[0] );
+		h[2] = m_pMesh->halfedgeNext( h[1] );
+		double angle[3];
+		triangle_angles( m_pMesh->vertexPoint( m_pMesh->halfedgeTarget( h[0] ) ),
+		                 m_pMesh->vertexPoint( m_pMesh->halfedgeTarget( h[1] ) ),
+		                 m_pMesh->vertexPoint( m_pMesh->halfedgeTarget( h[2] ) ), angle );
+		for( int i = 0; i < 3; i ++ ) m_angle[h[i]] = angle[i];
+	} );
+
+	//a vertex subtracts the angles of its in halfedges ccwly from the most clw one,
+	//isolated vertices have no curvature; the sum of the small deficits is compensated
+	std::vector<double> & k = m_pMesh->vertexCurvatures();
+	k.resize( nv );
+	m_total = parallel_sum( 0, nv, [&]( size_t v ) -> double
+	{
+		if( m_pMesh->vertexHalfedge( (int) v ) < 0 ) return k[v] = 0;
+		double k_v = m_pMesh->vertexBoundary( (int) v ) ? PI : 2*PI;
+		for( PairedVertexInHalfedgeIterator hiter( m_pMesh, (int) v ); !hiter.end(); ++ hiter )
+		{
+			k_v -= m_angle[*hiter];
+		}
+		return k[v] = k_v;
+	} );
+	std::cout << "Total Curvature is " <<  m_total/PI << " PI" << std::endl;;
+}
+
+/*!
+ *	Compute face normal and area
+ */
+inline void CGaussCurvature<CPairedHalfEdgeMesh>::_calculate_face_normal()
+{
+	int nf = m_pMesh->numFaces();
+	std::vector<CPoint> & normal = m_pMesh->faceNormals();
+	std::vector<double> & area   = m_pMesh->faceAreas();
+
+	normal.resize( nf );
+	area.resize( nf );
+	parallel_for( 0, nf, [&]( size_t f )
+	{
+		int h0 = m_pMesh->faceHalfedge( (int) f );
+		int h1 = m_pMesh->halfedgeNext( h0 );
+		const CPoint & p0 = m_pMesh->vertexPoint( m_pMesh->halfedgeSource( h0 ) );
+		const CPoint & p1 = m_pMesh->vertexPoint( m_pMesh->halfedgeTarget( h0 ) );
+		const CPoint & p2 = m_pMesh->vertexPoint( m_pMesh->halfedgeTarget( h1 ) );
+		CPoint d = ( p1 - p0 ) ^ ( p2 - p0 );
+		double n = d.norm();
+		area[f]   = n / 2.0;
+		normal[f] = d / n;
+	} );
+}
+
+/*!
+ *	Compute vertex normal, the area weighted average of the face normals
+ */
+inline void CGaussCurvature<CPairedHalfEdgeMesh>::_calculate_vertex_normal()
+{
+	int nv = m_pMesh->numVertices();
+
+	if( (int) m_pMesh->faceNormals().size() != m_pMesh->numFaces() ) _calculate_face_normal();
+	const std::vector<CPoint> & fn = m_pMesh->faceNormals();
+	const std::vector<double> & fa = m_pMesh->faceAreas();
+
+	//a vertex gathers the faces of its out halfedges ccwly from the most clw one
+	std::vector<CPoint> & normal = m_pMesh->vertexNormals();
+	normal.resize( nv );
+	parallel_for( 0, nv, [&]( size_t v )
+	{
+		CPoint d( 0, 0, 0 );
+		for( PairedVertexOutHalfedgeIterator hiter( m_pMesh, (int) v ); !hiter.end(); ++ hiter )
+		{
+			int f = m_pMesh->halfedgeFace( *hiter );
+			d += fn[f] * fa[f];
+		}
+		double n = d.norm();
+		normal[v] = ( n > 0 ) ? d / n : d;
+	} );
+}
+};
+#endif
+
@@ -1,181 +1,179 @@
-/*!
-*      \file GaussCurvatureMesh.h
-*      \brief Mesh for total Gaussian curvature
-*	   \author David Gu
-*      \date Documented 02/13/2014
-*
-*/
-
-#ifndef  _GAUSS_CURVATURE_MESH_H_
-#define  _GAUSS_CURVATURE_MESH_H_
-
-#include <map>
-#include <vector>
-
-#include "Mesh/BaseMesh.h"
-#include "Mesh/Vertex.h"
-#include "Mesh/HalfEdge.h"
-#include "Mesh/Edge.h"
-#include "Mesh/Face.h"
-#include "mesh/iterators.h"
-#include "mesh/boundary.h"
-#include "Parser/parser.h"
-
-namespace MeshLib
-{
-/*!
-*	\brief CGaussVertex class
-*
-*	Vertex class for Gauss Curvature
-*/
-class CGaussVertex : public CVertex
-{
-
-public:
-	/*!
-	 *	CHarmonicVertex constructor
-	 */
-	CGaussVertex() {m_k=0; };
-	/*!
-	 *	CHarmonicVertex destructor
-	 */
-	~CGaussVertex() {};
-	/*
-	 *	Gauss curvature
-	 */
-	double & k() { return m_k; };
-	/*
-	 *	Vertex normal
-	 */
-	CPoint & normal() { return m_normal; };
-
-protected:
-	/*
-	 *	Gauss curvature
-	 */
-	double m_k;
-	/*!
-	 *	Vertex normal
-	 */
-	CPoint m_point;
-};
-
-/*!
-*	\brief CGaussEdge class
-*
-*	Edge class for Gauss curvature
-*/
-class CGaussEdge : public  CEdge
-  {
-  public:
-    /*!	CGaussEdge constructor
-	 */
-	 CGaussEdge() { m_length=0;  };
-    /*!	CGaussEdge destructor
-	 */
-    ~CGaussEdge(){};
-	/*! edge length trait
-	 */
-	double & length() { return m_length; };
-
-  protected:
-	/*! edge length trait */
-	double   m_length;
-};
-
-
-
-/*!
-*	\brief CGaussEdge class
-*
-*	Face class for Gauss curvature
-*/
-class CGaussFace : public  CFace
-  {
-  public:
-    /*!	CGaussFace constructor
-	 */
-	 CGaussFace() {};
-    /*!	CGaussFace destructor
-	 */
-    ~CGaussFace(){};
-	/*!
-	 *	face area
-	 */
-	double & area() { return m_area; };
-	/*!
-	 *	face normal
-	 */
-	CPoint & normal(){ return m_normal; };
- 
-  protected:
-	double m_area;
-	CPoint m_normal;
-};
-
-
-/*!
-*	\brief CGaussHalfEdge class
-*
-*	HalfEdge class for Gauss curvature
-*/
-class CGaussHalfEdge : public  CHalfEdge
-  {
-  public:
-    /*!	CHarmonicHalfEdge constructor
-	 */
-	 CGaussHalfEdge() {};
-    /*!	CHarmonicHalfEdge destructor
-	 */
-    ~CGaussHalfEdge(){};
-	/*!	Corner angle trait
-	 */
-	double & angle() { return m_angle; };
-
-  protected:
-	  /*! Corner angle trait */
-	double m_angle;
-};
-
-/*-------------------------------------------------------------------------------------------------------------------------------------
-
-	GaussCurvature Mesh Class
-
---------------------------------------------------------------------------------------------------------------------------------------*/
-/*!
- *	\brief CGaussMesh class
- *
- *	Mesh class for Gauss curvature
- */
-template<typename V, typename E, typename F, typename H>
-class CGaussCurvatureMesh : public CBaseMesh<V,E,F,H>
-{
-public:
-	
-	typedef V CVertex;
-	typedef E CEdge;
-	typedef F CFace;
-	typedef H CHalfEdge;
-
-	typedef CGaussCurvatureMesh<V,E,F,H> M;
-
-	typedef CBoundary<M> CBoundary;
-	typedef CLoop<M> CLoop;
-	
-	typedef MeshVertexIterator<M> MeshVertexIterator;
-	typedef MeshEdgeIterator<M> MeshEdgeIterator;
-	typedef VertexVertexIterator<M> VertexVertexIterator;
-	typedef VertexEdgeIterator<M> VertexEdgeIterator;
-	typedef MeshFaceIterator<M> MeshFaceIterator;
-	typedef FaceVertexIterator<M> FaceVertexIterator;
-	typedef VertexFaceIterator<M> VertexFaceIterator;
-	typedef FaceHalfedgeIterator<M> FaceHalfedgeIterator;
-	typedef VertexInHalfedgeIterator<M> VertexInHalfedgeIterator;
-};
-
-/*! Mesh class for CHarmonicMapper class, Abbreviated as 'CGCMesh'
- */
-typedef CGaussCurvatureMesh<CGaussVertex, CGaussEdge, CGaussFace, CGaussHalfEdge> CGCMesh;	
-
-};
+/*!
+*      \file GaussCurvatureMesh.h
+*      \brief Mesh for total Gaussian curvature
+*	   \author David Gu
+*      \date Documented 02/13/2014
+*
+*/
+
+#ifndef  _GAUSS_CURVATURE_MESH_H_
+#define  _GAUSS_CURVATURE_MESH_H_
+
+#include <map>
+#include <vector>
+
+#include "Mesh/BaseMesh.h"
+#include "Mesh/Vertex.h"
+#include "Mesh/HalfEdge.h"
+#include "Mesh/Edge.h"
+#include "Mesh/Face.h"
+#include "Mesh/Attributes.h"
+#include "mesh/iterators.h"
+#include "mesh/boundary.h"
+#include "Mesh/OneRing.h"
+#include "Mesh/Components.h"
+#include "Parser/parser.h"
+
+namespace MeshLib
+{
+/*
+ *	The attributes are read from the traits of an .m file, write_m leaves them out, the
+ *	output is that of a mesh without attributes
+ */
+/*! Gauss curvature trait, k=(...) */
+MESHLIB_ATTRIBUTE( CAttrK,      double, "k"      )
+/*! Edge length trait, length=(...) */
+MESHLIB_ATTRIBUTE( CAttrLength, double, "length" )
+/*! Corner angle trait, angle=(...) */
+MESHLIB_ATTRIBUTE( CAttrAngle,  double, "angle"  )
+/*! Face area trait, area=(...) */
+MESHLIB_ATTRIBUTE( CAttrArea,   double, "area"   )
+/*! Face normal trait, normal=(x y z) */
+MESHLIB_ATTRIBUTE( CAttrNormal, CPoint, "normal" )
+
+/*!
+*	\brief CGaussVertex class
+*
+*	Vertex class for Gauss Curvature
+*/
+class CGaussVertex : public CVertex, public CAttributes<CAttrK>
+{
+
+public:
+	/*!
+	 *	CHarmonicVertex constructor
+	 */
+	CGaussVertex() {};
+	/*!
+	 *	CHarmonicVertex destructor
+	 */
+	~CGaussVertex() {};
+	/*
+	 *	Gauss curvature
+	 */
+	double & k() { return attr<CAttrK>(); };
+	/*
+	 *	Vertex normal
+	 */
+	CPoint & normal() { return m_normal; };
+};
+
+/*!
+*	\brief CGaussEdge class
+*
+*	Edge class for Gauss curvature
+*/
+class CGaussEdge : public  CEdge, public CAttributes<CAttrLength>
+  {
+  public:
+    /*!	CGaussEdge constructor
+	 */
+	 CGaussEdge() {};
+    /*!	CGaussEdge destructor
+	 */
+    ~CGaussEdge(){};
+	/*! edge length trait
+	 */
+	double & length() { return attr<CAttrLength>(); };
+};
+
+
+
+/*!
+*	\brief CGaussEdge class
+*
+*	Face class for Gauss curvature
+*/
+class CGaussFace : public  CFace, public CAttributes<CAttrArea, CAttrNormal>
+  {
+  public:
+    /*!	CGaussFace constructor
+	 */
+	 CGaussFace() {};
+    /*!	CGaussFace destructor
+	 */
+    ~CGaussFace(){};
+	/*!
+	 *	face area
+	 */
+	double & area() { return attr<CAttrArea>(); };
+	/*!
+	 *	face normal
+	 */
+	CPoint & normal(){ return attr<CAttrNormal>(); };
+};
+
+
+/*!
+*	\brief CGaussHalfEdge class
+*
+*	HalfEdge class for Gauss curvature
+*/
+class CGaussHalfEdge : public  CHalfEdge, public CAttributes<CAttrAngle>
+  {
+  public:
+    /*!	CHarmonicHalfEdge constructor
+	 */
+	 CGaussHalfEdge() {};
+    /*!	CHarmonicHalfEdge destructor
+	 */
+    ~CGaussHalfEdge(){};
+	/*!	Corner angle trait
+	 */
+	double & angle() { return attr<CAttrAngle>(); };
+};
+
+/*-------------------------------------------------------------------------------------------------------------------------------------
+
+	GaussCurvature Mesh Class
+
+--------------------------------------------------------------------------------------------------------------------------------------*/
+/*!
+ *	\brief CGaussMesh class
+ *
+ *	Mesh class for Gauss curvature
+ */
+template<typename V, typename E, typename F, typename H>
+class CGaussCurvatureMesh : public CBaseMesh<V,E,F,H>
+{
+public:
+	
+	typedef V CVertex;
+	typedef E CEdge;
+	typedef F CFace;
+	typedef H CHalfEdge;
+
+	typedef CGaussCurvatureMesh<V,E,F,H> M;
+
+	typedef CBoundary<M> CBoundary;
+	typedef CLoop<M> CLoop;
+	typedef COneRing<M> COneRing;
+	typedef CComponents<M> CComponents;
+	
+	typedef MeshVertexIterator<M> MeshVertexIterator;
+	typedef MeshEdgeIterator<M> MeshEdgeIterator;
+	typedef VertexVertexIterator<M> VertexVertexIterator;
+	typedef VertexEdgeIterator<M> VertexEdgeIterator;
+	typedef MeshFaceIterator<M> MeshFaceIterator;
+	typedef FaceVertexIterator<M> FaceVertexIterator;
+	typedef VertexFaceIterator<M> VertexFaceIterator;
+	typedef FaceHalfedgeIterator<M> FaceHalfedgeIterator;
+	typedef VertexInHalfedgeIterator<M> VertexInHalfedgeIterator;
+};
+
+/*! Mesh class for CHarmonicMapper class, Abbreviated as 'CGCMesh'
+ */
+typedef CGaussCurvatureMesh<CGaussVertex, CGaussEdge, CGaussFace, CGaussHalfEdge> CGCMesh;	
+
+};
 #endif  _GAUSS_CURVATURE_MESH_H_
\ No newline at end of file
@@ -0,0 +1,392 @@
+/*!
+*      \file StreamingCurvature.h
+*      \brief Total curvature and Euler characteristic of an .m file, without building a mesh
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_STREAMING_CURVATURE_H_
+#define _MESHLIB_STREAMING_CURVATURE_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "Geometry/Point.h"
+#include "Parser/MappedFile.h"
+#include "Parser/TextScanner.h"
+#include "Parallel/ThreadPool.h"
+#include "Mesh/Components.h"
+#include "CurvatureKernel.h"
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+namespace MeshLib
+{
+
+/*!
+*	\brief CStreamingCurvature, the counts and the total curvature of an .m file
+*
+*	The file is mapped and read once, line by line. A vertex gets the next index of flat
+*	arrays of positions and angle sums; a face adds its corner angles to its vertices, by
+*	triangle_angles like CGaussCurvature, and its edges to a hash table of vertex pairs,
+*	which counts how many faces share an edge. Edges of one face are on the boundary: their
+*	vertices have the curvature 2PI - angles ( PI on the boundary ). The loops are sets of
+*	boundary edges, by CUnionFind over the slots of the edge table: the two boundary edges
+*	of a vertex are united, and at a vertex where several loops touch, an edge is united with
+*	the one reached by turning through the faces around the vertex, which are found by a
+*	second pass over the Face lines. Faces which come before their vertices are kept until
+*	the end of the file. Vertices without faces are not counted, as the mesh readers drop
+*	them.
+*
+*	Nothing per face is stored, the memory is a few arrays per vertex, one 64 bit word per
+*	slot of the edge table and the two ints of CUnionFind per slot, a small part of what a
+*	CGaussCurvatureMesh of the file takes.
+*	Traits, Edge and Corner lines are skipped.
+*/
+class CStreamingCurvature
+{
+public:
+	/*!	Empty analyzer. */
+	CStreamingCurvature() { _clear(); };
+
+	/*!
+		Read an .m file.
+		\param filename name of the file
+		\return whether the file could be opened
+	*/
+	bool read( const char * filename );
+
+	/*! Number of vertices of the faces, the mesh readers drop the others. */
+	int    vertices()    const { return m_vertices; };
+	/*! Number of distinct edges. */
+	int    edges()       const { return m_edges; };
+	/*! Number of faces. */
+	int    faces()       const { return m_faces; };
+	/*! Number of boundary loops. */
+	int    boundaries()  const { return m_boundaries; };
+	/*! Number of edges shared by more than two faces. */
+	int    nonmanifold() const { return m_nonmanifold; };
+	/*! Euler characteristic V - E + F. */
+	int    euler()       const { return vertices() - edges() + faces(); };
+	/*! Genus, ( 2 - b - chi ) / 2 for one component. */
+	int    genus()       const { return ( 2 - boundaries() - euler() ) / 2; };
+	/*! Total Gaussian curvature. */
+	double total_curvature() const { return m_total; };
+
+protected:
+	/*! Reset all counts and arrays. */
+	void _clear();
+	/*! Index of the vertex id, -1 if it has not been read. */
+	int  _index( int id ) const;
+	/*! A Vertex line. */
+	void _vertex( int id, const CPoint & p );
+	/*! A Face line with the vertex ids ids[0..n-1], false if a vertex has not been read. */
+	bool _face( const int * ids, int n );
+	/*! Count the edge between the vertices a and b. */
+	void _edge( int a, int b );
+	/*! Slot of the edge between the vertices a and b, -1 if there is none. */
+	int  _find_edge( int a, int b ) const;
+	/*! First slot of the edge table to probe for a key. */
+	size_t _slot( uint64_t key ) const { return (size_t)( ( key * 0x9E3779B97F4A7C15ULL ) >> 20 ) & ( m_table.size() - 1 ); };
+	/*! Double the edge table. */
+	void _grow();
+	/*! The faces read before their vertices, the boundary and the total curvature, the file
+		[begin,end) is scanned again if boundary loops touch at a vertex. */
+	void _finish( const char * begin, const char * end );
+	/*! Unite the boundary edges at the vertices with pinched set, through the faces of the
+		file [begin,end) around them. */
+	void _unite_pinched( const char * begin, const char * end, const std::vector<char> & pinched, CUnionFind & loops );
+
+	/*! positions of the vertices */
+	std::vector<CPoint>  m_point;
+	/*! sum of the corner angles of every vertex */
+	std::vector<double>  m_angle;
+	/*! whether a face uses the vertex */
+	std::vector<char>    m_used;
+	/*! index of the vertex ids up to some multiple of the number of vertices */
+	std::vector<int>     m_dense;
+	/*! index of the larger vertex ids */
+	std::unordered_map<int,int> m_sparse;
+	/*! edge table, ( a << 31 | b ) << 2 | number of faces, up to 3, 0 for empty slots */
+	std::vector<uint64_t> m_table;
+	/*! vertex ids of faces read before their vertices, each preceded by its size */
+	std::vector<int>     m_pending;
+
+	/*! number of vertices, edges, faces, boundary loops and non manifold edges */
+	int    m_vertices;
+	int    m_edges;
+	int    m_faces;
+	int    m_boundaries;
+	int    m_nonmanifold;
+	/*! total curvature */
+	double m_total;
+};
+
+inline void CStreamingCurvature::_clear()
+{
+	m_point.clear();
+	m_angle.clear();
+	m_used.clear();
+	m_dense.clear();
+	m_sparse.clear();
+	m_table.assign( 1 << 10, 0 );
+	m_pending.clear();
+	m_vertices = m_edges = m_faces = m_boundaries = m_nonmanifold = 0;
+	m_total = 0;
+};
+
+inline int CStreamingCurvature::_index( int id ) const
+{
+	if( id >= 0 && id < (int) m_dense.size() ) return m_dense[id];
+	std::unordered_map<int,int>::const_iterator iter = m_sparse.find( id );
+	return ( iter == m_sparse.end() ) ? -1 : iter->second;
+};
+
+inline void CStreamingCurvature::_vertex( int id, const CPoint & p )
+{
+	int i = (int) m_point.size();
+	m_point.push_back( p );
+	m_angle.push_back( 0 );
+	m_used.push_back( 0 );
+
+	//the ids are mostly 1..n, those are indexed by an array
+	if( id >= 0 && id < 4 * i + 1024 )
+	{
+		if( id >= (int) m_dense.size() ) m_dense.resize( std::max( (size_t) id + 1, 2 * m_dense.size() ), -1 );
+		m_dense[id] = i;
+	}
+	else m_sparse[id] = i;
+};
+
+inline void CStreamingCurvature::_grow()
+{
+	std::vector<uint64_t> table( 2 * m_table.size(), 0 );
+	table.swap( m_table );
+	size_t mask = m_table.size() - 1;
+	for( size_t s = 0; s < table.size(); s ++ )
+	{
+		if( table[s] == 0 ) continue;
+		size_t slot = _slot( table[s] >> 2 );
+		while( m_table[slot] != 0 ) slot = ( slot + 1 ) & mask;
+		m_table[slot] = table[s];
+	}
+};
+
+inline void CStreamingCurvature::_edge( int a, int b )
+{
+	if( a > b ) std::swap( a, b );
+	uint64_t key  = ( (uint64_t) a << 31 ) | (uint64_t) b;
+	size_t   mask = m_table.size() - 1;
+	size_t   slot = _slot( key );
+	while( m_table[slot] != 0 )
+	{
+		if( ( m_table[slot] >> 2 ) == key )
+		{
+			//count up to 3 faces, more are as non manifold as 3
+			if( ( m_table[slot] & 3 ) < 3 ) m_table[slot] ++;
+			return;
+		}
+		slot = ( slot + 1 ) & mask;
+	}
+	m_table[slot] = ( key << 2 ) | 1;
+	//at most half full
+	if( 2 * ( ++ m_edges ) > (int) m_table.size() ) _grow();
+};
+
+inline int CStreamingCurvature::_find_edge( int a, int b ) const
+{
+	if( a > b ) std::swap( a, b );
+	uint64_t key  = ( (uint64_t) a << 31 ) | (uint64_t) b;
+	size_t   mask = m_table.size() - 1;
+	for( size_t slot = _slot( key ); m_table[slot] != 0; slot = ( slot + 1 ) & mask )
+	{
+		if( ( m_table[slot] >> 2 ) == key ) return (int) slot;
+	}
+	return -1;
+};
+
+inline bool CStreamingCurvature::_face( const int * ids, int n )
+{
+	int v[3];
+	for( int i = 0; i < n; i ++ )
+	{
+		if( _index( ids[i] ) < 0 ) return false;
+	}
+	for( int i = 0; i < n; i ++ )
+	{
+		int a = _index( ids[i] );
+		int b = _index( ids[ ( i + 1 ) % n ] );
+		_edge( a, b );
+		m_used[a] = 1;
+	}
+	//the corner angles of a polygon are those of the fan triangles around its first vertex
+	v[0] = _index( ids[0] );
+	for( int i = 1; i + 1 < n; i ++ )
+	{
+		v[1] = _index( ids[i] );
+		v[2] = _index( ids[i+1] );
+		double angle[3];
+		triangle_angles( m_point[ v[0] ], m_point[ v[1] ], m_point[ v[2] ], angle );
+		for( int k = 0; k < 3; k ++ ) m_angle[ v[k] ] += angle[k];
+	}
+	m_faces ++;
+	return true;
+};
+
+inline void CStreamingCurvature::_finish( const char * begin, const char * end )
+{
+	for( size_t k = 0; k < m_pending.size(); k += m_pending[k] + 1 )
+	{
+		_face( &m_pending[k+1], m_pending[k] );
+	}
+	std::vector<int>().swap( m_pending );
+
+	//the boundary edges belong to one face, a vertex has two of them unless loops touch there
+	int n = (int) m_point.size();
+	std::vector<int> boundary( n, 0 ), first( n, -1 );
+	for( size_t s = 0; s < m_table.size(); s ++ )
+	{
+		if( m_table[s] == 0 ) continue;
+		if( ( m_table[s] & 3 ) == 3 ) m_nonmanifold ++;
+		if( ( m_table[s] & 3 ) != 1 ) continue;
+		uint64_t key = m_table[s] >> 2;
+		int ends[2] = { (int)( key >> 31 ), (int)( key & 0x7fffffff ) };
+		for( int k = 0; k < 2; k ++ )
+		{
+			if( boundary[ ends[k] ] ++ == 0 ) first[ ends[k] ] = (int) s;
+		}
+	}
+
+	//the loops are the components of the boundary edges, joined at their common vertices
+	CUnionFind loops( (int) m_table.size() );
+	std::vector<char> pinched( n, 0 );
+	bool any_pinched = false;
+	for( size_t s = 0; s < m_table.size(); s ++ )
+	{
+		if( m_table[s] == 0 || ( m_table[s] & 3 ) != 1 ) continue;
+		uint64_t key = m_table[s] >> 2;
+		int ends[2] = { (int)( key >> 31 ), (int)( key & 0x7fffffff ) };
+		for( int k = 0; k < 2; k ++ )
+		{
+			if( boundary[ ends[k] ] == 2 ) loops.unite( (int) s, first[ ends[k] ] );
+			else pinched[ ends[k] ] = any_pinched = true;
+		}
+	}
+	if( any_pinched ) _unite_pinched( begin, end, pinched, loops );
+	for( size_t s = 0; s < m_table.size(); s ++ )
+	{
+		if( m_table[s] != 0 && ( m_table[s] & 3 ) == 1 && loops.find( (int) s ) == (int) s ) m_boundaries ++;
+	}
+
+	//the deficits of the vertices are summed, in file order
+	CCompensatedSum total;
+	for( int i = 0; i < n; i ++ )
+	{
+		if( !m_used[i] ) continue;
+		m_vertices ++;
+		total.add( ( boundary[i] ? PI : 2 * PI ) - m_angle[i] );
+	}
+	m_total = total.value();
+};
+
+inline void CStreamingCurvature::_unite_pinched( const char * begin, const char * end, const std::vector<char> & pinched, CUnionFind & loops )
+{
+	//the corners of the faces at the pinched vertices, as the previous and the next vertex
+	std::unordered_map< int, std::vector< std::pair<int,int> > > corners;
+	CTextScanner scanner( begin, end );
+	CStringView  line;
+	std::vector<int> ids;
+	while( scanner.next_line( line ) )
+	{
+		CLineScanner ls( line );
+		CStringView  token;
+		int id, vid;
+		if( !ls.token( token ) || !( token == "Face" ) || !ls.parse_int( id ) ) continue;
+		ids.clear();
+		while( ls.parse_int( vid ) ) ids.push_back( _index( vid ) );
+		if( ids.size() < 3 || std::find( ids.begin(), ids.end(), -1 ) != ids.end() ) continue;
+		int m = (int) ids.size();
+		for( int i = 0; i < m; i ++ )
+		{
+			if( pinched[ ids[i] ] ) corners[ ids[i] ].push_back( std::make_pair( ids[ ( i + m - 1 ) % m ], ids[ ( i + 1 ) % m ] ) );
+		}
+	}
+
+	//from the face of a boundary edge into the vertex, turn through the faces sharing an edge
+	//with the last one, up to the face whose edge out of the vertex is on the boundary
+	for( std::unordered_map< int, std::vector< std::pair<int,int> > >::iterator iter = corners.begin(); iter != corners.end(); ++ iter )
+	{
+		int v = iter->first;
+		std::vector< std::pair<int,int> > & fan = iter->second;
+		for( size_t c = 0; c < fan.size(); c ++ )
+		{
+			int in = _find_edge( fan[c].first, v );
+			if( in < 0 || ( m_table[in] & 3 ) != 1 ) continue;
+			size_t k = c;
+			for( size_t step = 0; step < fan.size(); step ++ )
+			{
+				int out = _find_edge( v, fan[k].second );
+				if( out >= 0 && ( m_table[out] & 3 ) == 1 )
+				{
+					loops.unite( in, out );
+					break;
+				}
+				size_t next = 0;
+				while( next < fan.size() && fan[next].first != fan[k].second ) next ++;
+				if( next == fan.size() ) break;
+				k = next;
+			}
+		}
+	}
+};
+
+inline bool CStreamingCurvature::read( const char * filename )
+{
+	_clear();
+	CMappedFile file;
+	if( !file.open( filename ) ) return false;
+
+	CTextScanner scanner( file.data(), file.end() );
+	CStringView  line;
+	std::vector<int> ids;
+	while( scanner.next_line( line ) )
+	{
+		CLineScanner ls( line );
+		CStringView  token;
+		int id;
+		if( !ls.token( token ) ) continue;
+
+		if( token == "Vertex" )
+		{
+			if( !ls.parse_int( id ) ) continue;
+			CPoint p;
+			for( int i = 0; i < 3; i ++ )
+			{
+				if( !ls.parse_double( p[i] ) ) break;
+			}
+			_vertex( id, p );
+			continue;
+		}
+
+		if( token == "Face" )
+		{
+			if( !ls.parse_int( id ) ) continue;
+			ids.clear();
+			int vid;
+			while( ls.parse_int( vid ) ) ids.push_back( vid );
+			if( ids.size() < 3 ) continue;
+			if( _face( &ids[0], (int) ids.size() ) ) continue;
+			m_pending.push_back( (int) ids.size() );
+			m_pending.insert( m_pending.end(), ids.begin(), ids.end() );
+		}
+	}
+	_finish( file.data(), file.end() );
+	return true;
+};
+
+}
+#endif //_MESHLIB_STREAMING_CURVATURE_H_ defined
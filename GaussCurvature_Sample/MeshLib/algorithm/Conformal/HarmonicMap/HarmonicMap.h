@@ -0,0 +1,252 @@
+/*!
+*      \file HarmonicMap.h
+*      \brief Harmonic map of a topological disk to the unit disk, with cotangent weights
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _HARMONIC_MAP_H_
+#define _HARMONIC_MAP_H_
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "Mesh/OneRing.h"
+#include "Mesh/boundary.h"
+#include "Mesh/Components.h"
+#include "Sparse/SparseMatrix.h"
+#include "Sparse/ConjugateGradient.h"
+#include "../GaussCurvature/CurvatureKernel.h"
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+namespace MeshLib
+{
+	/*!
+	 *	\brief CHarmonicMap, maps a mesh to the unit disk
+	 *
+	 *	The longest boundary loop is mapped to the unit circle by arc length, the other vertices
+	 *	solve the discrete Laplace equation with cotangent weights, w_ij = ( cot a + cot b ) / 2
+	 *	for the angles a, b facing the edge ij. The weights come from the corner angles of the
+	 *	halfedges, the rows of the Laplacian from the one-rings of COneRing, both in parallel.
+	 *	The two coordinates are solved by CConjugateGradient with the Jacobi preconditioner.
+	 *	The mesh must be connected, a mesh of several components is rejected before anything
+	 *	is computed. Vertices on other boundary loops are free, isolated vertices are mapped
+	 *	to the center.
+	 *
+	 *	\tparam M mesh class, with faceVertices, faceHalfedges and an angle() halfedge trait
+	 */
+	template<typename M>
+	class CHarmonicMap
+	{
+	public:
+		/*!	CHarmonicMap constructor
+		 *	\param pMesh the input mesh
+		 */
+		CHarmonicMap( M * pMesh ) : m_pMesh( pMesh ), m_ring( pMesh ), m_tolerance( 1e-10 ), m_iterations( 0 ) {};
+		/*!	Compute the map, the result is the uv of the vertices
+		 *	\return false if the mesh has several components or no boundary, or the solver did
+		 *	not converge
+		 */
+		bool _map();
+		/*!	Relative tolerance of the solver, 1e-10 by default
+		 */
+		double & tolerance() { return m_tolerance; };
+		/*!	Iterations of the solver, for both coordinates
+		 */
+		int iterations() const { return m_iterations; };
+
+	protected:
+		/*!	Map the longest boundary loop to the unit circle, mark its vertices fixed
+		 *	\param boundary the boundary loops of the mesh
+		 *	\return false if the mesh has no boundary
+		 */
+		bool _set_boundary( typename M::CBoundary & boundary );
+		/*!	Assemble the Laplacian of the free vertices, the fixed ones go to the right hand sides
+		 */
+		void _assemble( CSparseMatrix & A, std::vector<double> & bu, std::vector<double> & bv );
+		/*!	Cotangent of an angle, bounded for degenerate angles
+		 */
+		static double _cot( double angle )
+		{
+			double s = sin( angle );
+			return cos( angle ) / ( ( s > 1e-12 ) ? s : 1e-12 );
+		};
+
+		/*!	The input mesh
+		 */
+		M * m_pMesh;
+		/*!	One-rings of the vertices
+		 */
+		COneRing<M> m_ring;
+		/*!	Row of every vertex of m_ring in the Laplacian, -1 for fixed vertices
+		 */
+		std::vector<int> m_row;
+		/*!	Vertex of m_ring of every row
+		 */
+		std::vector<int> m_free;
+		/*!	Relative tolerance of the solver
+		 */
+		double m_tolerance;
+		/*!	Iterations of the last map
+		 */
+		int m_iterations;
+	};
+
+/*!
+ *	Fix the longest boundary loop to the unit circle, by arc length
+ */
+template<typename M>
+bool CHarmonicMap<M>::_set_boundary( typename M::CBoundary & boundary )
+{
+	int n = m_ring.size();
+	m_row.assign( n, 0 );
+	for( int i = 0; i < n; i ++ )
+	{
+		if( m_ring.vertices( i ).empty() )
+		{
+			m_row[i] = -1;
+			m_ring.vertex( i )->uv() = CPoint2( 0, 0 );
+		}
+	}
+
+	if( boundary.loops().empty() ) return false;
+
+	//the loops are sorted by length, longest first
+	typename M::CLoop * pL = boundary.loops()[0];
+	std::list<typename M::CHalfEdge*> & hes = pL->halfedges();
+	double s = 0;
+	for( typename std::list<typename M::CHalfEdge*>::iterator hiter = hes.begin(); hiter != hes.end(); hiter ++ )
+	{
+		typename M::CHalfEdge * pH = *hiter;
+		typename M::CVertex   * pV = m_pMesh->halfedgeSource( pH );
+		double angle = 2 * PI * s / pL->length();
+		pV->uv() = CPoint2( cos( angle ), sin( angle ) );
+		m_row[ m_ring.index( pV ) ] = -1;
+		s += m_pMesh->edgeLength( (typename M::CEdge*) pH->edge() );
+	}
+
+	m_free.clear();
+	for( int i = 0; i < n; i ++ )
+	{
+		if( m_row[i] < 0 ) continue;
+		m_row[i] = (int) m_free.size();
+		m_free.push_back( i );
+	}
+	return true;
+}
+
+/*!
+ *	Row r of the Laplacian is the free vertex i = m_free[r], with sum_j w_ij on the diagonal
+ *	and -w_ij for its free neighbors j. The fixed neighbors add w_ij uv_j to the right sides.
+ */
+template<typename M>
+void CHarmonicMap<M>::_assemble( CSparseMatrix & A, std::vector<double> & bu, std::vector<double> & bv )
+{
+	int nr = (int) m_free.size();
+
+	//the structure: the diagonal and the free neighbors
+	std::vector<int> sizes( nr );
+	parallel_for( 0, nr, [&]( size_t r )
+	{
+		int size = 1;
+		for( int j : m_ring.vertices( m_free[r] ) ) if( m_row[j] >= 0 ) size ++;
+		sizes[r] = size;
+	} );
+	A.reserve( sizes, nr );
+	bu.assign( nr, 0.0 );
+	bv.assign( nr, 0.0 );
+
+	parallel_for_chunks( 0, nr, [&]( size_t first, size_t last, int )
+	{
+		std::vector<double> w;
+		for( size_t r = first; r < last; r ++ )
+		{
+			int i = m_free[r];
+			CArrayRange<int> ring = m_ring.vertices( i );
+			w.assign( ring.size(), 0.0 );
+
+			//in the face of an incoming halfedge h from a to i, with third vertex b, the angle
+			//at b faces the edge ai and the angle at a faces the edge ib
+			for( typename M::CHalfEdge * h : m_ring.in_halfedges( i ) )
+			{
+				typename M::CHalfEdge * n = m_pMesh->halfedgeNext( h );
+				typename M::CHalfEdge * p = m_pMesh->halfedgePrev( h );
+				typename M::CVertex   * a = m_pMesh->halfedgeSource( h );
+				typename M::CVertex   * b = m_pMesh->halfedgeTarget( n );
+				for( size_t k = 0; k < ring.size(); k ++ )
+				{
+					typename M::CVertex * pW = m_ring.vertex( ring[k] );
+					if( pW == a ) w[k] += _cot( n->angle() ) / 2;
+					if( pW == b ) w[k] += _cot( p->angle() ) / 2;
+				}
+			}
+
+			size_t e = A.offset( (int) r );
+			A.column( e ) = (int) r;
+			double diagonal = 0;
+			for( size_t k = 0; k < ring.size(); k ++ )
+			{
+				diagonal += w[k];
+				int row = m_row[ ring[k] ];
+				if( row >= 0 )
+				{
+					e ++;
+					A.column( e ) = row;
+					A.value( e )  = -w[k];
+				}
+				else
+				{
+					CPoint2 uv = m_ring.vertex( ring[k] )->uv();
+					bu[r] += w[k] * uv[0];
+					bv[r] += w[k] * uv[1];
+				}
+			}
+			A.value( A.offset( (int) r ) ) = diagonal;
+		}
+	} );
+}
+
+/*!
+ *	Compute the harmonic map
+ */
+template<typename M>
+bool CHarmonicMap<M>::_map()
+{
+	//the disk is one component, isolated vertices aside
+	typename M::CBoundary   boundary( m_pMesh );
+	typename M::CComponents components( m_pMesh, boundary );
+	int surfaces = 0;
+	for( int c = 0; c < components.size(); c ++ ) if( components[c].faces > 0 ) surfaces ++;
+	if( surfaces > 1 )
+	{
+		fprintf( stderr, "The mesh has %d connected components, the harmonic map needs one\n", surfaces );
+		return false;
+	}
+
+	m_ring.update();
+	face_corner_angles( m_pMesh );
+	if( !_set_boundary( boundary ) ) return false;
+
+	CSparseMatrix A;
+	std::vector<double> bu, bv;
+	_assemble( A, bu, bv );
+
+	CConjugateGradient solver( A );
+	solver.tolerance() = m_tolerance;
+	std::vector<double> u, v;
+	int iu = solver.solve( bu, u );
+	int iv = solver.solve( bv, v );
+	m_iterations = ( iu < 0 || iv < 0 ) ? -1 : iu + iv;
+
+	parallel_for( 0, m_free.size(), [&]( size_t r )
+	{
+		m_ring.vertex( m_free[r] )->uv() = CPoint2( u[r], v[r] );
+	} );
+	return m_iterations >= 0;
+}
+
+}
+#endif
@@ -0,0 +1,516 @@
+/*!
+*      \file DelaunayTriangulation.h
+*      \brief Incremental Delaunay triangulation of planar points inside a frame triangle
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _DELAUNAY_TRIANGULATION_H_
+#define _DELAUNAY_TRIANGULATION_H_
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include "Geometry/Point.h"
+#include "Geometry/Point2.h"
+#include "Mesh/BaseMesh.h"
+#include "Mesh/MeshJournal.h"
+
+namespace MeshLib
+{
+	/*!
+	 *	\brief CDelaunayTriangulation, inserts points one at a time into a Delaunay triangulation
+	 *
+	 *	The points are triangulated inside a frame, a large triangle around their bounding box,
+	 *	whose vertices are removed with their faces by _remove_frame before the mesh is written.
+	 *	A point is located by walking from the last face, the face containing it is split into
+	 *	three, or the two faces of the edge it lies on into four, and the edges facing the new
+	 *	vertex are flipped until the empty circle property holds again. A point on a vertex is a
+	 *	duplicate and is not inserted. The uv of a vertex is its planar position, its point the
+	 *	position in space.
+	 *
+	 *	Every edit is recorded in the journal, if one is set, an insertion is committed as a whole.
+	 *	The observer, if one is set, is called with the faces created by every edit, e.g. to keep
+	 *	the curvature up to date by CGaussCurvature::_update_faces.
+	 *
+	 *	\tparam M mesh class, a CBaseMesh
+	 */
+	template<typename M>
+	class CDelaunayTriangulation
+	{
+	public:
+		/*!	result of an insertion */
+		enum { INSERTED, DUPLICATE, OUTSIDE };
+
+		/*!	CDelaunayTriangulation constructor
+		 *	\param pMesh the triangulation, empty or restored from a journal, see _resume
+		 */
+		CDelaunayTriangulation( M * pMesh ) : m_pMesh( pMesh ), m_journal( NULL ), m_id_f( 0 ), m_id_v( 0 ),
+			m_inserted( 0 ), m_duplicates( 0 ), m_outside( 0 ) {};
+
+		/*!	The journal of the edits, NULL for none
+		 */
+		CMeshJournal<M> *& journal() { return m_journal; };
+		/*!	Called with the faces f[0..n-1] created by every split, edge split and flip, empty for none
+		 */
+		std::function<void( typename M::tFace * f, int n )> & observer() { return m_observer; };
+		/*!	The vertices of the frame, empty if there is none
+		 */
+		const std::vector<typename M::tVertex> & frame() const { return m_frame; };
+
+		/*!	Create the frame, a triangle around the box, far enough to keep it out of the way.
+		 *	Its faces are created with the first point.
+		 */
+		void _create_frame( CPoint2 lo, CPoint2 hi );
+		/*!	Continue a triangulation restored from the journal, the frame vertices are the first ones
+		 */
+		void _resume();
+		/*!	Insert a point
+		 *	\param p     planar position, the uv of the vertex
+		 *	\param point position in space
+		 *	\param v     the new vertex, or the vertex at p for a duplicate, NULL outside the frame
+		 *	\return INSERTED, DUPLICATE or OUTSIDE
+		 */
+		int _insert_point( CPoint2 p, CPoint point, typename M::tVertex & v );
+		/*!	Insert a batch of points along a Morton curve of the box, points outside the box are
+		 *	skipped, duplicates are reported on stderr
+		 */
+		void _insert_batch( std::vector<CPoint> & batch, CPoint2 lo, CPoint2 hi );
+		/*!	Remove the frame vertices and their faces, the rest is the Delaunay triangulation of
+		 *	the points, except near their hull: the frame is at a finite distance, so a flat
+		 *	triangle along the hull whose circle contains a frame vertex is never created, the
+		 *	frame faces take its place. The boundary may then miss hull edges and be concave
+		 *	there, the pockets are not filled. Vertices which are left without faces, e.g. if
+		 *	all the points are collinear, are removed as well.
+		 */
+		void _remove_frame();
+
+		/*!	Create a vertex with the next id
+		 */
+		typename M::tVertex _create_vertex( CPoint2 p, CPoint point = CPoint() );
+		/*!	Create a triangle with the next id, ccw in the plane
+		 */
+		typename M::tFace _create_face( typename M::tVertex v0, typename M::tVertex v1, typename M::tVertex v2 );
+
+		/*!	Number of inserted points */
+		int inserted()   const { return m_inserted; };
+		/*!	Number of duplicate points */
+		int duplicates() const { return m_duplicates; };
+		/*!	Number of points outside the box or the frame */
+		int outside()    const { return m_outside; };
+
+		/*!	Twice the signed area of the triangle abc, positive if it is ccw
+		 */
+		static double _area( CPoint2 a, CPoint2 b, CPoint2 c )
+		{
+			return ( a[0] - c[0] ) * ( b[1] - c[1] ) - ( a[1] - c[1] ) * ( b[0] - c[0] );
+		};
+		/*!	_area( p, a, b ), evaluated with a and b in lexicographic order, such that the rounded
+		 *	values seen from the two faces of the edge ab are exact negatives of each other
+		 */
+		static double _side( CPoint2 p, CPoint2 a, CPoint2 b )
+		{
+			if( b[0] < a[0] || ( b[0] == a[0] && b[1] < a[1] ) ) return - _area( p, b, a );
+			return _area( p, a, b );
+		};
+
+	protected:
+		/*!	Walk to the face containing p
+		 *	\param p     the point
+		 *	\param edge  the halfedge of the face p lies on, NULL if p is inside the face
+		 *	\param vertex the vertex of the face at p, NULL if there is none
+		 *	\return the face, NULL if p is outside the triangulation
+		 */
+		typename M::tFace _locate_point( CPoint2 p, typename M::tHalfEdge & edge, typename M::tVertex & vertex );
+		/*!	Split a face into three at pv
+		 */
+		void _face_split( typename M::tFace pFace, typename M::tVertex pv );
+		/*!	Split the faces of the halfedge he, which contains pv, into four, two on the boundary
+		 */
+		void _edge_split( typename M::tHalfEdge he, typename M::tVertex pv );
+		/*!	Flip the edge e, whose faces are pv, v0, v1 and v0, v1, v2
+		 *	\return the new edge, between pv and v2
+		 */
+		typename M::tEdge _edge_swap( typename M::tEdge e, typename M::tVertex pv, typename M::tVertex v2 );
+		/*!	Flip e if pv is inside the circumcircle of the face across e, and the edges behind it
+		 *	\return whether e has been flipped
+		 */
+		bool _legalize_edge( typename M::tVertex pv, typename M::tEdge e );
+
+		/*!	The triangulation
+		 */
+		M * m_pMesh;
+		/*!	The journal, NULL for none
+		 */
+		CMeshJournal<M> * m_journal;
+		/*!	The observer of the edits, empty for none
+		 */
+		std::function<void( typename M::tFace *, int )> m_observer;
+		/*!	The frame vertices
+		 */
+		std::vector<typename M::tVertex> m_frame;
+		/*!	Next face and vertex ids
+		 */
+		int m_id_f, m_id_v;
+		/*!	Numbers of inserted, duplicate and outside points
+		 */
+		int m_inserted, m_duplicates, m_outside;
+	};
+
+template<typename M>
+typename M::tFace CDelaunayTriangulation<M>::_create_face( typename M::tVertex v0, typename M::tVertex v1, typename M::tVertex v2 )
+{
+	//keep all the faces ccw in the plane, such that the mesh is consistently oriented
+	if( _area( v0->uv(), v1->uv(), v2->uv() ) < 0 )
+		std::swap( v1, v2 );
+	return m_pMesh->createTriangle( v0, v1, v2, m_id_f ++ );
+};
+
+template<typename M>
+typename M::tVertex CDelaunayTriangulation<M>::_create_vertex( CPoint2 p, CPoint point )
+{
+	typename M::tVertex v = m_pMesh->createVertex( m_id_v ++ );
+	v->uv()    = p;
+	v->point() = point;
+	if( m_journal ) m_journal->insert( v );
+	return v;
+};
+
+/*!
+ *	The walk moves to the neighbor across the first edge p is outside of. The sides are
+ *	compared with 0 exactly on purpose: _side gives the two faces of an edge the same answer,
+ *	so the walk cannot step back and forth across an edge, and p is on an edge only if both
+ *	faces see it there. An epsilon would put points near an edge on it, and the split would
+ *	then create faces which are not ccw.
+ */
+template<typename M>
+typename M::tFace CDelaunayTriangulation<M>::_locate_point( CPoint2 p, typename M::tHalfEdge & edge, typename M::tVertex & vertex )
+{
+	edge   = NULL;
+	vertex = NULL;
+	typename M::tFace next = m_pMesh->faces().back();
+	while( next != NULL )
+	{
+		typename M::tFace f = next;
+		next = NULL;
+		std::array<typename M::tVertex,3>   v = m_pMesh->faceVertices( f );
+		std::array<typename M::tHalfEdge,3> h = m_pMesh->faceHalfedges( f );
+
+		//halfedge h[i] runs from v[i-1] to v[i], s[i] is the side of p, the face is ccw
+		double s[3];
+		int    zero = 0;
+		for( int i = 0; i < 3; i ++ )
+		{
+			s[i] = _side( p, v[(i+2)%3]->uv(), v[i]->uv() );
+			if( s[i] < 0 )
+			{
+				typename M::tHalfEdge twin = m_pMesh->halfedgeSym( h[i] );
+				if( twin == NULL ) return NULL;
+				next = m_pMesh->halfedgeFace( twin );
+				break;
+			}
+			if( s[i] == 0 ) zero ++;
+		}
+		if( next != NULL ) continue;
+
+		//on two edges p is their common vertex, on one edge it is inside the edge
+		for( int i = 0; i < 3; i ++ )
+		{
+			if( s[i] != 0 ) continue;
+			if( zero == 1 ) edge = h[i];
+			else if( s[(i+1)%3] == 0 ) vertex = v[i];
+		}
+		return f;
+	}
+	return NULL;
+};
+
+template<typename M>
+void CDelaunayTriangulation<M>::_face_split( typename M::tFace pFace, typename M::tVertex pv )
+{
+	std::array<typename M::tVertex,3> v = m_pMesh->faceVertices( pFace );
+	typename M::tVertex pv0 = v[0], pv1 = v[1], pv2 = v[2];
+	//first delete the current face
+	int removed = pFace->id();
+	m_pMesh->deleteFace( pFace );
+	//then split the face into three faces
+	typename M::tFace created[3];
+	created[0] = _create_face( pv0, pv1, pv );
+	created[1] = _create_face( pv1, pv2, pv );
+	created[2] = _create_face( pv0, pv2, pv );
+	if( m_journal ) m_journal->split( removed, created );
+	if( m_observer ) m_observer( created, 3 );
+
+	//legalize the three edges of the original face
+	_legalize_edge( pv, m_pMesh->vertexEdge( pv0, pv1 ) );
+	_legalize_edge( pv, m_pMesh->vertexEdge( pv1, pv2 ) );
+	_legalize_edge( pv, m_pMesh->vertexEdge( pv0, pv2 ) );
+};
+
+/*!
+ *	The halfedge runs from a to b in the face a, b, c, its twin is in the face b, a, d
+ */
+template<typename M>
+void CDelaunayTriangulation<M>::_edge_split( typename M::tHalfEdge he, typename M::tVertex pv )
+{
+	typename M::tHalfEdge twin = m_pMesh->halfedgeSym( he );
+	typename M::tVertex a = m_pMesh->halfedgeSource( he );
+	typename M::tVertex b = m_pMesh->halfedgeTarget( he );
+	typename M::tVertex c = m_pMesh->halfedgeTarget( m_pMesh->halfedgeNext( he ) );
+	typename M::tVertex d = ( twin == NULL ) ? NULL : m_pMesh->halfedgeTarget( m_pMesh->halfedgeNext( twin ) );
+
+	typename M::tFace f = m_pMesh->halfedgeFace( he );
+	typename M::tFace g = ( twin == NULL ) ? NULL : m_pMesh->halfedgeFace( twin );
+	int removed[2] = { f->id(), ( g == NULL ) ? -1 : g->id() };
+	m_pMesh->deleteFace( f );
+	if( g != NULL ) m_pMesh->deleteFace( g );
+
+	//a point on the hull is a boundary vertex
+	pv->boundary() = ( d == NULL );
+	typename M::tFace created[4] = { NULL, NULL, NULL, NULL };
+	created[0] = _create_face( a, pv, c );
+	created[1] = _create_face( pv, b, c );
+	if( d != NULL )
+	{
+		created[2] = _create_face( b, pv, d );
+		created[3] = _create_face( pv, a, d );
+	}
+	if( m_journal ) m_journal->split_edge( removed, created );
+	if( m_observer ) m_observer( created, ( d != NULL ) ? 4 : 2 );
+
+	//legalize the edges of the two faces, the halves of the split edge are legal
+	_legalize_edge( pv, m_pMesh->vertexEdge( b, c ) );
+	_legalize_edge( pv, m_pMesh->vertexEdge( c, a ) );
+	if( d != NULL )
+	{
+		_legalize_edge( pv, m_pMesh->vertexEdge( a, d ) );
+		_legalize_edge( pv, m_pMesh->vertexEdge( d, b ) );
+	}
+};
+
+template<typename M>
+typename M::tEdge CDelaunayTriangulation<M>::_edge_swap( typename M::tEdge e, typename M::tVertex pv, typename M::tVertex v2 )
+{
+	if( m_pMesh->isBoundary( e ) )
+		return e;
+
+	typename M::tVertex v0 = m_pMesh->edgeVertex1( e );
+	typename M::tVertex v1 = m_pMesh->edgeVertex2( e );
+
+	//first delete the current two faces
+	typename M::tFace currentFace1 = m_pMesh->halfedgeFace( m_pMesh->edgeHalfedge( e, 0 ) );
+	typename M::tFace currentFace2 = m_pMesh->halfedgeFace( m_pMesh->edgeHalfedge( e, 1 ) );
+	int removed[2] = { currentFace1->id(), currentFace2->id() };
+	m_pMesh->deleteFace( currentFace1 );
+	m_pMesh->deleteFace( currentFace2 );
+
+	//then create two new faces
+	typename M::tFace created[2];
+	created[0] = _create_face( pv, v0, v2 );
+	created[1] = _create_face( pv, v1, v2 );
+	if( m_journal ) m_journal->flip( removed, created );
+	if( m_observer ) m_observer( created, 2 );
+
+	return m_pMesh->vertexEdge( pv, v2 );
+};
+
+template<typename M>
+bool CDelaunayTriangulation<M>::_legalize_edge( typename M::tVertex pv, typename M::tEdge e )
+{
+	//first decide whether the edge is on the boundary
+	if( m_pMesh->isBoundary( e ) )
+		return false;
+
+	typename M::tVertex v0 = m_pMesh->edgeVertex1( e );
+	typename M::tVertex v1 = m_pMesh->edgeVertex2( e );
+	//find the vertex v2 across the edge from pv
+	typename M::tHalfEdge he = m_pMesh->vertexHalfedge( v0, v1 );
+	typename M::tVertex   v2;
+	if( m_pMesh->halfedgeTarget( m_pMesh->halfedgeNext( he ) ) == pv )
+		v2 = m_pMesh->halfedgeTarget( m_pMesh->halfedgeNext( m_pMesh->halfedgeSym( he ) ) );
+	else
+		v2 = m_pMesh->halfedgeTarget( m_pMesh->halfedgeNext( he ) );
+
+	CPoint2 p0  = v0->uv();
+	CPoint2 p1  = v1->uv();
+	CPoint2 p2  = v2->uv();
+	CPoint2 ppv = pv->uv();
+
+	//the circumcenter of pv, v0, v1
+	CPoint2 ps0( ppv[0]*ppv[0]+ppv[1]*ppv[1], ppv[1] );
+	CPoint2 ps1( p0[0]*p0[0]+p0[1]*p0[1], p0[1] );
+	CPoint2 ps2( p1[0]*p1[0]+p1[1]*p1[1], p1[1] );
+	CPoint2 ps3( ppv[0], ppv[0]*ppv[0]+ppv[1]*ppv[1] );
+	CPoint2 ps4( p0[0], p0[0]*p0[0]+p0[1]*p0[1] );
+	CPoint2 ps5( p1[0], p1[0]*p1[0]+p1[1]*p1[1] );
+
+	double S1 = _area( ps0, ps1, ps2 );
+	double S2 = _area( ppv, p0, p1 );
+	double S3 = _area( ps3, ps4, ps5 );
+	double circlex = S1 / ( 2 * S2 );
+	double circley = 1.0 / 2 * ( S3 / S2 );
+	double radius   = sqrt( ( ppv[0]-circlex )*( ppv[0]-circlex ) + ( ppv[1]-circley )*( ppv[1]-circley ) );
+	double distance = sqrt( ( p2[0]-circlex )*( p2[0]-circlex ) + ( p2[1]-circley )*( p2[1]-circley ) );
+	if( distance > radius )
+		return false;
+
+	_edge_swap( e, pv, v2 );
+	//the swap deletes boundary edges of the old faces, look the edges up again
+	_legalize_edge( pv, m_pMesh->vertexEdge( v1, v2 ) );
+	_legalize_edge( pv, m_pMesh->vertexEdge( v0, v2 ) );
+	return true;
+};
+
+template<typename M>
+int CDelaunayTriangulation<M>::_insert_point( CPoint2 p, CPoint point, typename M::tVertex & v )
+{
+	v = NULL;
+	//the first point is joined to the frame vertices, see _create_frame
+	if( m_pMesh->numFaces() == 0 )
+	{
+		if( m_frame.size() != 3 )
+		{
+			m_outside ++;
+			return OUTSIDE;
+		}
+		v = _create_vertex( p, point );
+		typename M::tFace created[3];
+		for( int k = 0; k < 3; k ++ )
+		{
+			created[k] = _create_face( m_frame[k], m_frame[(k+1)%3], v );
+		}
+		if( m_journal )
+		{
+			m_journal->split( -1, created );
+			m_journal->commit();
+		}
+		if( m_observer ) m_observer( created, 3 );
+		m_inserted ++;
+		return INSERTED;
+	}
+
+	typename M::tHalfEdge edge;
+	typename M::tVertex   vertex;
+	typename M::tFace pFace = _locate_point( p, edge, vertex );
+	if( pFace == NULL )
+	{
+		m_outside ++;
+		return OUTSIDE;
+	}
+	if( vertex != NULL )
+	{
+		v = vertex;
+		m_duplicates ++;
+		return DUPLICATE;
+	}
+
+	v = _create_vertex( p, point );
+	if( edge != NULL )
+		_edge_split( edge, v );
+	else
+		_face_split( pFace, v );
+	//the insertion is journaled as a whole, with its splits and flips
+	if( m_journal ) m_journal->commit();
+	m_inserted ++;
+	return INSERTED;
+};
+
+template<typename M>
+void CDelaunayTriangulation<M>::_create_frame( CPoint2 lo, CPoint2 hi )
+{
+	CPoint2 c( ( lo[0] + hi[0] ) / 2, ( lo[1] + hi[1] ) / 2 );
+	double r = sqrt( ( hi[0] - lo[0] ) * ( hi[0] - lo[0] ) + ( hi[1] - lo[1] ) * ( hi[1] - lo[1] ) ) / 2;
+	if( r <= 0 ) r = 1;
+
+	m_frame.clear();
+	for( int k = 0; k < 3; k ++ )
+	{
+		double angle = 3.14159265358979 / 2 + 2 * 3.14159265358979 * k / 3;
+		m_frame.push_back( _create_vertex( CPoint2( c[0] + 20 * r * cos( angle ), c[1] + 20 * r * sin( angle ) ) ) );
+		//the edits keep the hull, the frame vertices are the boundary vertices
+		m_frame.back()->boundary() = true;
+	}
+	if( m_journal ) m_journal->commit();
+};
+
+template<typename M>
+void CDelaunayTriangulation<M>::_resume()
+{
+	for( typename std::list<typename M::tVertex>::iterator viter = m_pMesh->vertices().begin(); viter != m_pMesh->vertices().end(); ++ viter )
+		m_id_v = std::max( m_id_v, (*viter)->id() + 1 );
+	for( typename std::list<typename M::tFace>::iterator fiter = m_pMesh->faces().begin(); fiter != m_pMesh->faces().end(); ++ fiter )
+		m_id_f = std::max( m_id_f, (*fiter)->id() + 1 );
+
+	m_frame.clear();
+	if( m_pMesh->numVertices() >= 3 )
+	{
+		for( int k = 0; k < 3; k ++ )
+		{
+			m_frame.push_back( m_pMesh->idVertex( k ) );
+			m_frame.back()->boundary() = true;
+		}
+	}
+};
+
+template<typename M>
+void CDelaunayTriangulation<M>::_insert_batch( std::vector<CPoint> & batch, CPoint2 lo, CPoint2 hi )
+{
+	//insert along a Morton curve, such that _locate_point starts next to the point
+	std::vector< std::pair<unsigned long long,size_t> > order( batch.size() );
+	double sx = ( hi[0] > lo[0] ) ? 0x1fffff / ( hi[0] - lo[0] ) : 0;
+	double sy = ( hi[1] > lo[1] ) ? 0x1fffff / ( hi[1] - lo[1] ) : 0;
+	for( size_t i = 0; i < batch.size(); i ++ )
+	{
+		double x = std::min( std::max( ( batch[i][0] - lo[0] ) * sx, 0.0 ), (double) 0x1fffff );
+		double y = std::min( std::max( ( batch[i][1] - lo[1] ) * sy, 0.0 ), (double) 0x1fffff );
+		order[i] = std::make_pair( _morton_spread( (unsigned long long) x ) | ( _morton_spread( (unsigned long long) y ) << 1 ), i );
+	}
+	std::sort( order.begin(), order.end() );
+
+	for( size_t j = 0; j < order.size(); j ++ )
+	{
+		CPoint & pt = batch[ order[j].second ];
+		if( pt[0] < lo[0] || pt[0] > hi[0] || pt[1] < lo[1] || pt[1] > hi[1] )
+		{
+			m_outside ++;
+			continue;
+		}
+		typename M::tVertex v;
+		if( _insert_point( CPoint2( pt[0], pt[1] ), pt, v ) == DUPLICATE && m_duplicates <= 10 )
+		{
+			fprintf( stderr, "Duplicate point %g %g %g of vertex %d%s\n", pt[0], pt[1], pt[2], v->id(),
+				m_duplicates == 10 ? ", further duplicates are only counted" : "" );
+		}
+	}
+};
+
+template<typename M>
+void CDelaunayTriangulation<M>::_remove_frame()
+{
+	if( m_frame.size() != 3 ) return;
+
+	//the faces without a frame vertex are built again, build drops the frame vertices
+	std::vector< std::array<int,3> > faces;
+	std::vector<int>                 ids;
+	for( typename std::list<typename M::tFace>::iterator fiter = m_pMesh->faces().begin(); fiter != m_pMesh->faces().end(); ++ fiter )
+	{
+		std::array<typename M::tVertex,3> v = m_pMesh->faceVertices( *fiter );
+		bool framed = false;
+		for( int i = 0; i < 3; i ++ )
+			framed = framed || std::find( m_frame.begin(), m_frame.end(), v[i] ) != m_frame.end();
+		if( framed ) continue;
+		std::array<int,3> f = {{ v[0]->id(), v[1]->id(), v[2]->id() }};
+		faces.push_back( f );
+		ids.push_back( (*fiter)->id() );
+	}
+	m_pMesh->deleteFaces();
+	m_pMesh->build( faces, ids );
+	m_frame.clear();
+};
+
+}//name space MeshLib
+
+#endif //_DELAUNAY_TRIANGULATION_H_ defined
@@ -0,0 +1,849 @@
+/*!
+*      \file Edgebreaker.h
+*      \brief Edgebreaker compression of corner tables with predicted, quantized coordinates
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_EDGEBREAKER_H_
+#define _MESHLIB_EDGEBREAKER_H_
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include "RangeCoder.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CCodecChannel, coordinates of every vertex, e.g. the points or the uv
+*/
+struct CCodecChannel
+{
+	/*! coordinates per vertex */
+	int                 dimension;
+	/*! dimension values per vertex */
+	std::vector<double> values;
+};
+
+/*!
+*	\brief CEdgebreaker, compresses a triangle mesh given as a corner table
+*
+*	Connectivity is coded by the Edgebreaker traversal of the corner table [Rossignac et al.,
+*	3D compression made simple]: every triangle is one of the CLERS symbols, which are
+*	coded with the previous symbol as context, about 1.5-2 bits per triangle. The decoder
+*	glues the triangles by zipping the free edges.
+*
+*	The traversal needs a closed, vertex manifold surface, so before coding
+*	- every boundary loop is closed by a fan of dummy triangles around a dummy vertex,
+*	- the vertices with several fans of triangles are split into one vertex per fan,
+*	and both are undone by the decoder. The zipping cannot glue the edges closing a handle,
+*	a few of them are sent as corner pairs and glued as soon as their triangle is decoded,
+*	the rest of the handle is zipped from there. The encoder finds them by running the
+*	decoder on its own symbols, a mesh it still does not reproduce, e.g. with inconsistent
+*	opposites, is sent as plain vertex indices.
+*
+*	Coordinates are quantized to the given number of bits in their bounding box. The
+*	vertex introduced by a C triangle is predicted by the parallelogram rule from the
+*	triangle it was entered from, the others by the previous vertex, and the residuals are
+*	coded adaptively.
+*
+*	Isolated vertices are dropped, vertex and face ids are not kept: the vertices and faces
+*	are numbered in the order of the traversal.
+*/
+class CEdgebreaker
+{
+public:
+	/*!
+		Compress a mesh.
+		\param V        vertex of every corner, corner 3f+i is the i-th corner of face f
+		\param O        opposite corner of every corner, -1 on the boundary
+		\param nv       number of vertices
+		\param channels coordinates of the vertices
+		\param bits     bits per quantized coordinate, 1..30
+		\param out      the compressed stream is appended
+	*/
+	static void encode( const std::vector<int> & V, const std::vector<int> & O, int nv,
+		const std::vector<CCodecChannel> & channels, int bits, std::vector<unsigned char> & out );
+	/*!
+		Decompress a mesh.
+		\param data     the stream
+		\param size     bytes of the stream
+		\param V        vertex of every corner
+		\param O        opposite corner of every corner, -1 on the boundary, empty if the
+		                stream does not give the adjacency
+		\param nv       number of vertices
+		\param channels coordinates of the vertices
+		\return false if the stream is corrupt
+	*/
+	static bool decode( const unsigned char * data, size_t size, std::vector<int> & V, std::vector<int> & O,
+		int & nv, std::vector<CCodecChannel> & channels );
+
+protected:
+	/*! CLERS symbols */
+	enum { SYM_C, SYM_L, SYM_E, SYM_R, SYM_S };
+	/*! connectivity coding */
+	enum { MODE_EDGEBREAKER, MODE_INDICES };
+	/*! handles searched before falling back to vertex indices, each costs a decoding */
+	enum { MAX_HANDLES = 64 };
+
+	static int _next( int c ) { return ( c % 3 == 2 ) ? c - 2 : c + 1; };
+	static int _prev( int c ) { return ( c % 3 == 0 ) ? c + 2 : c - 1; };
+
+	/*!
+	*	\brief CSymbolModel, CLERS symbols with the previous symbol as context, and the
+	*	flags telling whether a branch left by an S is still to be traversed
+	*/
+	struct CSymbolModel
+	{
+		CSymbolModel() { previous = SYM_C; };
+		CBitTreeModel<3> symbols[5];
+		CBitModel        skip;
+		int              previous;
+	};
+	/*! Symbols recorded by the encoder, read back by its check. */
+	struct CRecordedSymbols
+	{
+		CRecordedSymbols() { s = k = 0; };
+		int  symbol() { return ( s < symbols.size() ) ? symbols[s++] : -1; };
+		int  skip()   { return ( k < skips.size() ) ? skips[k++] : -1; };
+		std::vector<unsigned char> symbols;
+		std::vector<unsigned char> skips;
+		/*! symbols and skip flags in coding order, a flag f is SYM_S + 1 + f */
+		std::vector<unsigned char> events;
+		size_t s, k;
+	};
+	/*! Symbols decoded from a stream. */
+	struct CCodedSymbols
+	{
+		CCodedSymbols( CRangeDecoder & d, CSymbolModel & m ) : rc( d ), model( m ) {};
+		int symbol()
+		{
+			int s = (int) model.symbols[model.previous].decode( rc );
+			model.previous = ( s <= SYM_S ) ? s : SYM_C;
+			return ( s <= SYM_S && !rc.overrun() ) ? s : -1;
+		};
+		int skip() { return rc.overrun() ? -1 : rc.decode( model.skip ); };
+		CRangeDecoder & rc;
+		CSymbolModel  & model;
+	};
+
+	/*! Glue the free edge facing corner c to the free edge next to it, repeatedly, the
+	    glued corners facing the zipped edges are appended to glued if given. */
+	static void _zip( std::vector<int> & O, int c, std::vector<int> * glued );
+	/*!
+		Rebuild the opposites of the closed mesh from the symbols.
+		\param source   CRecordedSymbols or CCodedSymbols
+		\param nt       number of triangles
+		\param handles  pairs of corners glued directly, by increasing first corner
+		\param O        the opposites, -1 or -2 for edges not glued
+		\param assigned the vertex index of the corners which introduce a vertex, -1 otherwise
+		\param tip      for every vertex index, the corner of the C triangle introducing it, -1
+		                for the vertices of the first triangle of a component
+		\param glued    if given, the corners glued by zipping, in the order of zipping
+		\return false if the symbols do not describe nt triangles
+	*/
+	template<typename Source>
+	static bool _connectivity( Source & source, int nt, const std::vector<int> & handles,
+		std::vector<int> & O, std::vector<int> & assigned, std::vector<int> & tip, std::vector<int> * glued = NULL );
+	/*! Vertex of every corner, by spreading the assigned indices around the vertices. */
+	static bool _vertices( const std::vector<int> & O, const std::vector<int> & assigned, int nv, std::vector<int> & V );
+
+	/*! Quantization of a channel. */
+	struct CQuantizer
+	{
+		void   set( int bits, double lo_, double hi_ )
+		{
+			lo = lo_; hi = hi_; top = ( 1 << bits ) - 1;
+			scale = ( hi > lo ) ? top / ( hi - lo ) : 0;
+		};
+		int    quantize( double x ) const
+		{
+			double q = floor( ( x - lo ) * scale + 0.5 );
+			return ( q < 0 ) ? 0 : ( q > top ) ? top : (int) q;
+		};
+		double value( int q ) const { return ( scale > 0 ) ? lo + q / scale : lo; };
+		double lo, hi, scale;
+		int    top;
+	};
+	/*!
+		Predicted quantized coordinate of vertex i, from the known vertices.
+		\param q    quantized coordinates, known for the vertices before i
+		\param dim  coordinates per vertex
+		\param d    the coordinate
+		\param last the previous vertex with coordinates, -1 if none
+		\param top  largest quantized coordinate
+	*/
+	static int _predict( const std::vector<int> & V, const std::vector<int> & O, const std::vector<int> & tip,
+		const std::vector<int> & rep, const std::vector<char> & dummy, const std::vector<int> & q, int dim, int d,
+		int i, int last, int top );
+};
+
+inline void CEdgebreaker::_zip( std::vector<int> & O, int c, std::vector<int> * glued )
+{
+	int limit = (int) O.size();
+	while( true )
+	{
+		//the free edge around the vertex shared with c
+		int b = _next( c );
+		int steps = 0;
+		while( O[b] >= 0 && steps ++ < limit ) b = _next( O[b] );
+		if( O[b] != -1 ) return;
+		O[c] = b;
+		O[b] = c;
+		if( glued ) glued->push_back( c );
+
+		//the next edge to zip
+		c = _prev( c );
+		steps = 0;
+		while( O[c] >= 0 && c != b && steps ++ < limit ) c = _prev( O[c] );
+		if( O[c] != -2 ) return;
+	}
+};
+
+template<typename Source>
+inline bool CEdgebreaker::_connectivity( Source & source, int nt, const std::vector<int> & handles,
+	std::vector<int> & O, std::vector<int> & assigned, std::vector<int> & tip, std::vector<int> * glued )
+{
+	O.assign( 3 * nt, -3 );
+	assigned.assign( 3 * nt, -1 );
+	tip.clear();
+
+	//an edge facing a decoded triangle, glued if it closes a handle, zipped later otherwise
+	size_t h = 0;
+	struct CClose
+	{
+		static void edge( std::vector<int> & O, const std::vector<int> & handles, size_t & h, int x )
+		{
+			if( h < handles.size() && handles[h] == x && handles[h+1] >= 0 && handles[h+1] < (int) O.size() )
+			{
+				O[x] = handles[h+1];
+				O[ handles[h+1] ] = x;
+				h += 2;
+				return;
+			}
+			O[x] = -2;
+		};
+		static void zip( std::vector<int> & O, int x, std::vector<int> * glued ) { if( O[x] == -2 ) _zip( O, x, glued ); };
+	};
+
+	std::vector<int> stack;
+	int t = 0;
+	while( t < nt )
+	{
+		//the first triangle of a component, its vertices are the next three
+		int first = 3 * t ++;
+		O[first+1] = O[first+2] = -1;
+		for( int i = 0; i < 3; i ++ )
+		{
+			assigned[first+i] = (int) tip.size();
+			tip.push_back( -1 );
+		}
+
+		int c = first;
+		while( c >= 0 )
+		{
+			if( t >= nt ) return false;
+			int n = 3 * t ++;
+			O[c] = n;
+			O[n] = c;
+			c = n + 1;
+
+			switch( source.symbol() )
+			{
+			case SYM_C:
+				O[n+2] = -1;
+				assigned[n] = (int) tip.size();
+				tip.push_back( n );
+				break;
+			case SYM_L:
+				CClose::edge( O, handles, h, n + 2 );
+				CClose::zip( O, n + 2, glued );
+				break;
+			case SYM_R:
+				CClose::edge( O, handles, h, n + 1 );
+				c = n + 2;
+				break;
+			case SYM_S:
+				stack.push_back( n + 2 );
+				break;
+			case SYM_E:
+				CClose::edge( O, handles, h, n + 1 );
+				CClose::edge( O, handles, h, n + 2 );
+				CClose::zip( O, n + 2, glued );
+				CClose::zip( O, n + 1, glued );
+				//continue with the branches left by the S triangles, unless traversed already
+				c = -1;
+				while( c < 0 && !stack.empty() )
+				{
+					int b = stack.back();
+					stack.pop_back();
+					int skip = source.skip();
+					if( skip < 0 ) return false;
+					if( skip == 0 ) c = b;
+				}
+				break;
+			default:
+				return false;
+			}
+		}
+	}
+
+	//beyond the glued handles the free edges meet at the vertices from either side, they are
+	//zipped in both directions until nothing changes
+	for( int free = -1; ; )
+	{
+		int left = 0;
+		for( int x = 3 * nt - 1; x >= 0; x -- )
+		{
+			CClose::zip( O, x, glued );
+			if( O[x] != -2 ) continue;
+			int b = _prev( x );
+			for( int steps = 0; O[b] >= 0 && steps < 3 * nt; steps ++ ) b = _prev( O[b] );
+			if( O[b] == -1 )
+			{
+				O[x] = b;
+				O[b] = x;
+				if( glued ) glued->push_back( x );
+			}
+			else left ++;
+		}
+		if( left == free ) break;
+		free = left;
+	}
+	return stack.empty() && h == handles.size();
+};
+
+inline bool CEdgebreaker::_vertices( const std::vector<int> & O, const std::vector<int> & assigned, int nv, std::vector<int> & V )
+{
+	V.assign( O.size(), -1 );
+	for( size_t c = 0; c < O.size(); c ++ )
+	{
+		if( O[c] < 0 ) return false;
+	}
+	std::vector<char> seen( nv, 0 );
+	for( size_t c = 0; c < O.size(); c ++ )
+	{
+		int v = assigned[c];
+		if( v < 0 ) continue;
+		if( seen[v] ) return false;
+		seen[v] = 1;
+
+		int x = (int) c, steps = 0;
+		do{
+			if( V[x] >= 0 || steps ++ > (int) O.size() ) return false;
+			V[x] = v;
+			x = _next( O[ _next( x ) ] );
+		}while( x != (int) c );
+	}
+	for( size_t c = 0; c < V.size(); c ++ )
+	{
+		if( V[c] < 0 ) return false;
+	}
+	return true;
+};
+
+inline int CEdgebreaker::_predict( const std::vector<int> & V, const std::vector<int> & O, const std::vector<int> & tip,
+	const std::vector<int> & rep, const std::vector<char> & dummy, const std::vector<int> & q, int dim, int d,
+	int i, int last, int top )
+{
+	int c = tip[i];
+	if( c >= 0 )
+	{
+		//the gate the C triangle was entered through, and the triangle behind it
+		int a = rep[ V[c+1] ];
+		int b = rep[ V[c+2] ];
+		int o = rep[ V[ O[c] ] ];
+		if( !dummy[a] && !dummy[b] )
+		{
+			if( !dummy[o] ) return std::max( 0, std::min( top, q[a*dim+d] + q[b*dim+d] - q[o*dim+d] ) );
+			return ( q[a*dim+d] + q[b*dim+d] ) / 2;
+		}
+		if( !dummy[a] ) return q[a*dim+d];
+		if( !dummy[b] ) return q[b*dim+d];
+	}
+	return ( last >= 0 ) ? q[last*dim+d] : ( top + 1 ) / 2;
+};
+
+inline void CEdgebreaker::encode( const std::vector<int> & V, const std::vector<int> & O, int nv,
+	const std::vector<CCodecChannel> & channels, int bits, std::vector<unsigned char> & out )
+{
+	bits = std::max( 1, std::min( bits, 30 ) );
+	int nc = (int) V.size();
+	int nf = nc / 3;
+
+	//the bounding boxes
+	std::vector< std::vector<CQuantizer> > quantizers( channels.size() );
+	for( size_t k = 0; k < channels.size(); k ++ )
+	{
+		int dim = channels[k].dimension;
+		for( int d = 0; d < dim; d ++ )
+		{
+			double lo = 0, hi = 0;
+			for( int v = 0; v < nv; v ++ )
+			{
+				double x = channels[k].values[v*dim+d];
+				if( v == 0 || x < lo ) lo = x;
+				if( v == 0 || x > hi ) hi = x;
+			}
+			quantizers[k].push_back( CQuantizer() );
+			quantizers[k].back().set( bits, lo, hi );
+		}
+	}
+
+	//the mesh must have consistent opposites
+	bool valid = ( (int) O.size() == nc && nf > 0 );
+	for( int c = 0; c < nc && valid; c ++ )
+	{
+		valid = V[c] >= 0 && V[c] < nv && ( O[c] < 0 || ( O[c] < nc && O[O[c]] == c &&
+			V[_next(c)] == V[_prev(O[c])] && V[_prev(c)] == V[_next(O[c])] ) );
+	}
+
+	//close the boundary loops by fans around dummy vertices
+	std::vector<int>  CV( V ), CO( O );
+	std::vector<int>  origin( nv );
+	for( int v = 0; v < nv; v ++ ) origin[v] = v;
+	int cnv = nv;
+	if( valid )
+	{
+		std::vector<int> head( nv, -1 ), link( nc, -1 );
+		for( int c = 0; c < nc; c ++ )
+		{
+			if( O[c] >= 0 ) continue;
+			int a = V[_next(c)];
+			link[c] = head[a];
+			head[a] = c;
+		}
+		for( int c0 = 0; c0 < nc; c0 ++ )
+		{
+			if( O[c0] >= 0 || CO[c0] >= 0 ) continue;
+
+			int dv = cnv ++;
+			origin.push_back( -1 );
+			int first = -1, previous = -1;
+			int c = c0;
+			while( c >= 0 )
+			{
+				//the dummy triangle b,a,dv over the boundary edge a->b facing c
+				int a = V[_next(c)], b = V[_prev(c)];
+				int k = (int) CV.size();
+				CV.push_back( b ); CV.push_back( a ); CV.push_back( dv );
+				CO.push_back( -1 ); CO.push_back( -1 ); CO.push_back( c );
+				CO[c] = k + 2;
+				if( previous >= 0 ) { CO[previous+1] = k; CO[k] = previous + 1; }
+				else first = k;
+				previous = k;
+
+				//an unused boundary edge leaving b
+				int e = -1;
+				while( head[b] >= 0 )
+				{
+					int x = head[b];
+					head[b] = link[x];
+					if( CO[x] < 0 ) { e = x; break; }
+				}
+				c = e;
+			}
+			CO[previous+1] = first;
+			CO[first] = previous + 1;
+		}
+
+		//split the vertices with several fans
+		std::vector<char> fan( nv, 0 ), visited( CV.size(), 0 );
+		for( size_t c = 0; c < CV.size(); c ++ )
+		{
+			if( visited[c] ) continue;
+			int v = CV[c];
+			int w = v;
+			if( v < nv && fan[v] )
+			{
+				w = cnv ++;
+				origin.push_back( v );
+			}
+			if( v < nv ) fan[v] = 1;
+
+			int x = (int) c;
+			do{
+				visited[x] = 1;
+				CV[x] = w;
+				x = _next( CO[ _next( x ) ] );
+			}while( x != (int) c );
+		}
+	}
+
+	//the traversal, vertex order and corner correspondence with the decoder
+	int cnt = (int) CV.size() / 3;
+	CRecordedSymbols  recorded;
+	std::vector<int>  order;
+	std::vector<int>  index( cnv, -1 );
+	std::vector<int>  corner( CV.size(), -1 );
+	std::vector<char> U( cnt, 0 );
+	int T = 0;
+	std::vector<int>  stack;
+
+	for( int t0 = 0; t0 < cnt && valid; t0 ++ )
+	{
+		if( U[t0] ) continue;
+		int c0 = 3 * t0;
+		U[t0] = 1;
+		int cs[3] = { c0, _next( c0 ), _prev( c0 ) };
+		for( int i = 0; i < 3; i ++ )
+		{
+			corner[ cs[i] ] = 3 * T + i;
+			index[ CV[ cs[i] ] ] = (int) order.size();
+			order.push_back( CV[ cs[i] ] );
+		}
+		T ++;
+
+		int c = CO[c0];
+		while( c >= 0 )
+		{
+			int t = c / 3;
+			U[t] = 1;
+			corner[c] = 3 * T; corner[ _next(c) ] = 3 * T + 1; corner[ _prev(c) ] = 3 * T + 2;
+			T ++;
+
+			int r = CO[ _next(c) ], l = CO[ _prev(c) ];
+			if( index[ CV[c] ] < 0 )
+			{
+				recorded.symbols.push_back( SYM_C );
+				recorded.events.push_back( SYM_C );
+				index[ CV[c] ] = (int) order.size();
+				order.push_back( CV[c] );
+				c = r;
+			}
+			else if( U[ r / 3 ] )
+			{
+				if( U[ l / 3 ] )
+				{
+					recorded.symbols.push_back( SYM_E );
+					recorded.events.push_back( SYM_E );
+					c = -1;
+					while( c < 0 && !stack.empty() )
+					{
+						int b = stack.back();
+						stack.pop_back();
+						recorded.skips.push_back( U[ b / 3 ] ? 1 : 0 );
+						recorded.events.push_back( SYM_S + 1 + recorded.skips.back() );
+						if( !U[ b / 3 ] ) c = b;
+					}
+				}
+				else
+				{
+					recorded.symbols.push_back( SYM_R );
+					recorded.events.push_back( SYM_R );
+					c = l;
+				}
+			}
+			else if( U[ l / 3 ] )
+			{
+				recorded.symbols.push_back( SYM_L );
+				recorded.events.push_back( SYM_L );
+				c = r;
+			}
+			else
+			{
+				recorded.symbols.push_back( SYM_S );
+				recorded.events.push_back( SYM_S );
+				stack.push_back( l );
+				c = r;
+			}
+		}
+	}
+
+	//decode the symbols, the first edge zipped wrongly, or else the last one left free, closes
+	//a handle, which is glued when its triangle is decoded, then decode again
+	std::vector<int> DO, DV, assigned, tip, handles, glued;
+	std::vector<int> inverse( CV.size(), -1 );
+	for( int c = 0; c < (int) CV.size() && valid; c ++ ) inverse[ corner[c] ] = c;
+	for( int round = 0; valid; round ++ )
+	{
+		valid = round <= MAX_HANDLES;
+		recorded.s = recorded.k = 0;
+		glued.clear();
+		if( valid ) valid = _connectivity( recorded, cnt, handles, DO, assigned, tip, &glued );
+
+		int handle = -1;
+		for( size_t g = 0; g < glued.size() && valid && handle < 0; g ++ )
+		{
+			int x = glued[g];
+			if( DO[x] != corner[ CO[ inverse[x] ] ] ) handle = x;
+		}
+		bool wrong = ( handle >= 0 );
+		for( int c = 0; c < (int) CV.size() && valid && !wrong; c ++ )
+		{
+			int x = corner[c], y = corner[ CO[c] ];
+			if( DO[x] == y ) continue;
+			if( DO[x] >= 0 ) { valid = false; break; }
+			//the later of the two triangles is marked -2 when it is decoded
+			if( x > y && DO[x] == -2 && ( handle < 0 || x < handle ) ) handle = x;
+		}
+		if( !valid || handle < 0 ) break;
+
+		std::vector<int>::iterator pos = handles.begin();
+		while( pos != handles.end() && *pos < handle ) pos += 2;
+		pos = handles.insert( pos, corner[ CO[ inverse[handle] ] ] );
+		handles.insert( pos, handle );
+	}
+	if( valid ) valid = _vertices( DO, assigned, (int) order.size(), DV );
+	for( int c = 0; c < (int) CV.size() && valid; c ++ )
+	{
+		valid = ( DV[ corner[c] ] == index[ CV[c] ] );
+	}
+
+	CRangeEncoder rc( out );
+	CIntegerModel im;
+	rc.encode_direct( valid ? MODE_EDGEBREAKER : MODE_INDICES, 8 );
+	rc.encode_direct( bits, 8 );
+	rc.encode_direct( (unsigned int) channels.size(), 8 );
+	for( size_t k = 0; k < channels.size(); k ++ )
+	{
+		rc.encode_direct( channels[k].dimension, 8 );
+		for( int d = 0; d < channels[k].dimension; d ++ )
+		{
+			rc.encode_double( quantizers[k][d].lo );
+			rc.encode_double( quantizers[k][d].hi );
+		}
+	}
+
+	//vertex order, its representatives and dummies, in the decoder's numbering
+	int dn = valid ? (int) order.size() : nv;
+	std::vector<int>  rep( dn ), source( dn );
+	std::vector<char> dummy( dn, 0 );
+	for( int i = 0; i < dn; i ++ )
+	{
+		rep[i] = i;
+		source[i] = i;
+	}
+
+	if( valid )
+	{
+		rc.encode_direct( cnt, 32 );
+		rc.encode_direct( (unsigned int) handles.size() / 2, 32 );
+		for( size_t h = 0; h < handles.size(); h += 2 )
+		{
+			im.encode( rc, handles[h] - ( h ? handles[h-2] : 0 ) );
+			im.encode( rc, handles[h] - handles[h+1] );
+		}
+
+		CSymbolModel model;
+		for( size_t e = 0; e < recorded.events.size(); e ++ )
+		{
+			int symbol = recorded.events[e];
+			if( symbol > SYM_S )
+			{
+				rc.encode( model.skip, symbol - SYM_S - 1 );
+				continue;
+			}
+			model.symbols[model.previous].encode( rc, symbol );
+			model.previous = symbol;
+		}
+
+		//the copies of a split vertex are represented by the first one
+		std::vector<int> dummies, splits, first( nv, -1 );
+		for( int i = 0; i < dn; i ++ )
+		{
+			int w = order[i];
+			if( origin[w] < 0 ) { dummy[i] = 1; dummies.push_back( i ); continue; }
+			source[i] = origin[w];
+			if( first[ source[i] ] < 0 ) first[ source[i] ] = i;
+			rep[i] = first[ source[i] ];
+			if( rep[i] != i ) splits.push_back( i );
+		}
+		rc.encode_direct( (unsigned int) dummies.size(), 32 );
+		for( size_t j = 0; j < dummies.size(); j ++ ) im.encode( rc, dummies[j] - ( j ? dummies[j-1] : 0 ) );
+		rc.encode_direct( (unsigned int) splits.size(), 32 );
+		for( size_t j = 0; j < splits.size(); j ++ )
+		{
+			im.encode( rc, splits[j] - ( j ? splits[j-1] : 0 ) );
+			im.encode( rc, splits[j] - rep[ splits[j] ] );
+		}
+
+	}
+	else
+	{
+		rc.encode_direct( nv, 32 );
+		rc.encode_direct( nf, 32 );
+		for( int c = 0; c < nc; c ++ ) im.encode( rc, V[c] - ( c ? V[c-1] : 0 ) );
+		tip.assign( nv, -1 );
+	}
+
+	//coordinates, in the decoder's vertex order
+	for( size_t k = 0; k < channels.size(); k ++ )
+	{
+		int dim = channels[k].dimension;
+		std::vector<int>           q( dn * dim, 0 );
+		std::vector<CIntegerModel> residuals( dim );
+		int last = -1;
+		for( int i = 0; i < dn; i ++ )
+		{
+			if( dummy[i] || rep[i] != i ) continue;
+			for( int d = 0; d < dim; d ++ )
+			{
+				q[i*dim+d] = quantizers[k][d].quantize( channels[k].values[ source[i] * dim + d ] );
+				int p = _predict( DV, DO, tip, rep, dummy, q, dim, d, i, last, ( 1 << bits ) - 1 );
+				residuals[d].encode( rc, q[i*dim+d] - p );
+			}
+			last = i;
+		}
+	}
+	rc.finish();
+};
+
+inline bool CEdgebreaker::decode( const unsigned char * data, size_t size, std::vector<int> & V, std::vector<int> & O,
+	int & nv, std::vector<CCodecChannel> & channels )
+{
+	CRangeDecoder rc( data, size );
+	CIntegerModel im;
+	V.clear();
+	O.clear();
+	nv = 0;
+
+	int mode  = (int) rc.decode_direct( 8 );
+	int bits  = (int) rc.decode_direct( 8 );
+	int nch   = (int) rc.decode_direct( 8 );
+	if( mode > MODE_INDICES || bits < 1 || bits > 30 ) return false;
+
+	channels.resize( nch );
+	std::vector< std::vector<CQuantizer> > quantizers( nch );
+	for( int k = 0; k < nch; k ++ )
+	{
+		channels[k].dimension = (int) rc.decode_direct( 8 );
+		for( int d = 0; d < channels[k].dimension; d ++ )
+		{
+			double lo = rc.decode_double();
+			double hi = rc.decode_double();
+			quantizers[k].push_back( CQuantizer() );
+			quantizers[k].back().set( bits, lo, hi );
+		}
+	}
+
+	std::vector<int>  DV, DO, tip, rep;
+	std::vector<char> dummy;
+	int dn = 0;
+
+	if( mode == MODE_EDGEBREAKER )
+	{
+		int cnt = (int) rc.decode_direct( 32 );
+		if( rc.overrun() || cnt < 0 || (size_t) cnt > size * 8 + 16 ) return false;
+
+		int n = (int) rc.decode_direct( 32 );
+		if( rc.overrun() || n < 0 || n > cnt * 3 ) return false;
+		std::vector<int> handles( 2 * n );
+		for( int j = 0, x = 0; j < n; j ++ )
+		{
+			x += im.decode( rc );
+			handles[2*j]   = x;
+			handles[2*j+1] = x - im.decode( rc );
+		}
+
+		std::vector<int> assigned;
+		CSymbolModel  model;
+		CCodedSymbols coded( rc, model );
+		if( !_connectivity( coded, cnt, handles, DO, assigned, tip ) ) return false;
+		dn = (int) tip.size();
+
+		dummy.assign( dn, 0 );
+		rep.resize( dn );
+		for( int i = 0; i < dn; i ++ ) rep[i] = i;
+
+		n = (int) rc.decode_direct( 32 );
+		for( int j = 0, i = 0; j < n; j ++ )
+		{
+			i += im.decode( rc );
+			if( i < 0 || i >= dn ) return false;
+			dummy[i] = 1;
+		}
+		n = (int) rc.decode_direct( 32 );
+		for( int j = 0, i = 0; j < n; j ++ )
+		{
+			i += im.decode( rc );
+			int r = i - im.decode( rc );
+			if( i < 0 || i >= dn || r < 0 || r >= i ) return false;
+			rep[i] = rep[r];
+		}
+		if( rc.overrun() || !_vertices( DO, assigned, dn, DV ) ) return false;
+	}
+	else
+	{
+		dn = (int) rc.decode_direct( 32 );
+		int nf = (int) rc.decode_direct( 32 );
+		if( rc.overrun() || dn < 0 || nf < 0 || (size_t) nf > size * 8 + 16 ) return false;
+		V.resize( 3 * nf );
+		for( int c = 0; c < 3 * nf; c ++ )
+		{
+			V[c] = ( c ? V[c-1] : 0 ) + im.decode( rc );
+			if( V[c] < 0 || V[c] >= dn ) return false;
+		}
+		tip.assign( dn, -1 );
+		dummy.assign( dn, 0 );
+		rep.resize( dn );
+		for( int i = 0; i < dn; i ++ ) rep[i] = i;
+	}
+
+	//coordinates
+	std::vector< std::vector<int> > qs( nch );
+	for( int k = 0; k < nch; k ++ )
+	{
+		int dim = channels[k].dimension;
+		std::vector<int> & q = qs[k];
+		q.assign( dn * dim, 0 );
+		std::vector<CIntegerModel> residuals( dim );
+		int last = -1;
+		for( int i = 0; i < dn; i ++ )
+		{
+			if( dummy[i] || rep[i] != i ) continue;
+			for( int d = 0; d < dim; d ++ )
+			{
+				int p = _predict( DV, DO, tip, rep, dummy, q, dim, d, i, last, ( 1 << bits ) - 1 );
+				q[i*dim+d] = p + residuals[d].decode( rc );
+			}
+			last = i;
+		}
+	}
+	if( rc.overrun() ) return false;
+
+	//the vertices without dummies and copies
+	std::vector<int> final_index( dn, -1 );
+	for( int i = 0; i < dn; i ++ )
+	{
+		if( dummy[i] ) continue;
+		final_index[i] = ( rep[i] == i ) ? nv ++ : final_index[ rep[i] ];
+	}
+	for( int k = 0; k < nch; k ++ )
+	{
+		int dim = channels[k].dimension;
+		channels[k].values.assign( nv * dim, 0 );
+		for( int i = 0; i < dn; i ++ )
+		{
+			if( dummy[i] || rep[i] != i ) continue;
+			for( int d = 0; d < dim; d ++ )
+				channels[k].values[ final_index[i] * dim + d ] = quantizers[k][d].value( qs[k][i*dim+d] );
+		}
+	}
+	if( mode == MODE_INDICES ) return true;
+
+	//the faces without dummy vertices
+	int cnt = (int) DV.size() / 3;
+	std::vector<int> new_corner( DV.size(), -1 );
+	for( int t = 0; t < cnt; t ++ )
+	{
+		int c = 3 * t;
+		if( dummy[ DV[c] ] || dummy[ DV[c+1] ] || dummy[ DV[c+2] ] ) continue;
+		for( int i = 0; i < 3; i ++ )
+		{
+			new_corner[c+i] = (int) V.size();
+			V.push_back( final_index[ DV[c+i] ] );
+		}
+	}
+	O.assign( V.size(), -1 );
+	for( size_t c = 0; c < DV.size(); c ++ )
+	{
+		if( new_corner[c] >= 0 ) O[ new_corner[c] ] = new_corner[ DO[c] ];
+	}
+	return true;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_EDGEBREAKER_H_ defined
@@ -0,0 +1,293 @@
+/*!
+*      \file RangeCoder.h
+*      \brief Adaptive binary range coder and the models built on it
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_RANGE_CODER_H_
+#define _MESHLIB_RANGE_CODER_H_
+
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+namespace MeshLib{
+
+/*!
+*	\brief CBitModel, adaptive probability of a binary decision
+*
+*	The probability of a 0 is prob / 2^PROB_BITS, it moves by 1/2^MOVE_BITS of the
+*	distance towards every coded bit.
+*/
+struct CBitModel
+{
+	enum { PROB_BITS = 11, MOVE_BITS = 5 };
+	/*!	Constructor, both bits equally likely. */
+	CBitModel() { prob = 1 << ( PROB_BITS - 1 ); };
+	/*! probability of a 0 */
+	unsigned int prob;
+};
+
+/*!
+*	\brief CRangeEncoder, range encoder writing to a byte vector
+*
+*	The carry is propagated through a cached byte and a count of pending 0xFF bytes,
+*	so the output is produced byte by byte without ever being revisited.
+*/
+class CRangeEncoder
+{
+public:
+	/*!	Encoder appending to out. */
+	CRangeEncoder( std::vector<unsigned char> & out ) : m_out( out )
+	{
+		m_low        = 0;
+		m_range      = 0xFFFFFFFFu;
+		m_cache      = 0;
+		m_cache_size = 1;
+	};
+
+	/*! Encode a bit with an adaptive model. */
+	void encode( CBitModel & model, int bit )
+	{
+		unsigned int bound = ( m_range >> CBitModel::PROB_BITS ) * model.prob;
+		if( bit == 0 )
+		{
+			m_range = bound;
+			model.prob += ( ( 1u << CBitModel::PROB_BITS ) - model.prob ) >> CBitModel::MOVE_BITS;
+		}
+		else
+		{
+			m_low   += bound;
+			m_range -= bound;
+			model.prob -= model.prob >> CBitModel::MOVE_BITS;
+		}
+		while( m_range < TOP ) { m_range <<= 8; _shift_low(); }
+	};
+	/*! Encode the lowest nbits bits of value, at most 32, with probability 1/2 each. */
+	void encode_direct( unsigned int value, int nbits )
+	{
+		for( int i = nbits - 1; i >= 0; i -- )
+		{
+			m_range >>= 1;
+			if( ( value >> i ) & 1 ) m_low += m_range;
+			while( m_range < TOP ) { m_range <<= 8; _shift_low(); }
+		}
+	};
+	/*! Encode a double bit by bit. */
+	void encode_double( double value )
+	{
+		unsigned long long bits;
+		memcpy( &bits, &value, sizeof(bits) );
+		encode_direct( (unsigned int)( bits >> 32 ), 32 );
+		encode_direct( (unsigned int) bits, 32 );
+	};
+	/*! Write the pending bytes, the coder is not usable afterwards. */
+	void finish()
+	{
+		for( int i = 0; i < 5; i ++ ) _shift_low();
+	};
+
+protected:
+	enum { TOP = 1 << 24 };
+
+	/*! Move the top byte of low to the output, resolving the carry. */
+	void _shift_low()
+	{
+		if( (unsigned int) m_low < 0xFF000000u || ( m_low >> 32 ) != 0 )
+		{
+			unsigned char carry = (unsigned char)( m_low >> 32 );
+			unsigned char temp  = m_cache;
+			do{
+				m_out.push_back( (unsigned char)( temp + carry ) );
+				temp = 0xFF;
+			}while( -- m_cache_size != 0 );
+			m_cache = (unsigned char)( m_low >> 24 );
+		}
+		m_cache_size ++;
+		m_low = ( m_low & 0x00FFFFFFu ) << 8;
+	};
+
+	/*! the output */
+	std::vector<unsigned char> & m_out;
+	/*! lower end of the interval, with the carry in bit 32 */
+	unsigned long long           m_low;
+	/*! width of the interval */
+	unsigned int                 m_range;
+	/*! last byte not yet written, it may still receive the carry */
+	unsigned char                m_cache;
+	/*! number of pending bytes, the cached one and the 0xFF behind it */
+	unsigned long long           m_cache_size;
+};
+
+/*!
+*	\brief CRangeDecoder, range decoder reading from memory
+*/
+class CRangeDecoder
+{
+public:
+	/*!	Decoder of the bytes [data,data+size). */
+	CRangeDecoder( const unsigned char * data, size_t size )
+	{
+		m_p     = data;
+		m_end   = data + size;
+		m_range = 0xFFFFFFFFu;
+		m_code  = 0;
+		m_over  = false;
+		for( int i = 0; i < 5; i ++ ) m_code = ( m_code << 8 ) | _next();
+	};
+
+	/*! Decode a bit with an adaptive model. */
+	int decode( CBitModel & model )
+	{
+		unsigned int bound = ( m_range >> CBitModel::PROB_BITS ) * model.prob;
+		int bit;
+		if( m_code < bound )
+		{
+			m_range = bound;
+			model.prob += ( ( 1u << CBitModel::PROB_BITS ) - model.prob ) >> CBitModel::MOVE_BITS;
+			bit = 0;
+		}
+		else
+		{
+			m_code  -= bound;
+			m_range -= bound;
+			model.prob -= model.prob >> CBitModel::MOVE_BITS;
+			bit = 1;
+		}
+		while( m_range < TOP ) { m_range <<= 8; m_code = ( m_code << 8 ) | _next(); }
+		return bit;
+	};
+	/*! Decode nbits bits, at most 32, coded by encode_direct. */
+	unsigned int decode_direct( int nbits )
+	{
+		unsigned int value = 0;
+		for( int i = 0; i < nbits; i ++ )
+		{
+			m_range >>= 1;
+			unsigned int bit = ( m_code >= m_range ) ? 1 : 0;
+			if( bit ) m_code -= m_range;
+			value = ( value << 1 ) | bit;
+			while( m_range < TOP ) { m_range <<= 8; m_code = ( m_code << 8 ) | _next(); }
+		}
+		return value;
+	};
+	/*! Decode a double coded by encode_double. */
+	double decode_double()
+	{
+		unsigned long long bits = decode_direct( 32 );
+		bits = ( bits << 32 ) | decode_direct( 32 );
+		double value;
+		memcpy( &value, &bits, sizeof(value) );
+		return value;
+	};
+	/*! Whether the decoder read past the end of the data, i.e. the data was truncated. */
+	bool overrun() { return m_over; };
+
+protected:
+	enum { TOP = 1 << 24 };
+
+	/*! The next byte, 0 past the end. */
+	unsigned int _next()
+	{
+		if( m_p < m_end ) return *m_p ++;
+		m_over = true;
+		return 0;
+	};
+
+	/*! current byte */
+	const unsigned char * m_p;
+	/*! end of the data */
+	const unsigned char * m_end;
+	/*! width of the interval */
+	unsigned int          m_range;
+	/*! code value relative to the lower end */
+	unsigned int          m_code;
+	/*! whether bytes past the end were requested */
+	bool                  m_over;
+};
+
+/*!
+*	\brief CBitTreeModel, adaptive model of symbols of BITS bits
+*
+*	The bits are coded from the most significant one, each with its own model selected
+*	by the bits before it.
+*/
+template<int BITS>
+struct CBitTreeModel
+{
+	/*! Encode a symbol. */
+	void encode( CRangeEncoder & rc, unsigned int symbol )
+	{
+		unsigned int m = 1;
+		for( int b = BITS - 1; b >= 0; b -- )
+		{
+			int bit = ( symbol >> b ) & 1;
+			rc.encode( models[m], bit );
+			m = ( m << 1 ) | bit;
+		}
+	};
+	/*! Decode a symbol. */
+	unsigned int decode( CRangeDecoder & rc )
+	{
+		unsigned int m = 1;
+		for( int b = 0; b < BITS; b ++ ) m = ( m << 1 ) | rc.decode( models[m] );
+		return m - ( 1u << BITS );
+	};
+
+	/*! models of the inner nodes of the tree */
+	CBitModel models[ 1 << BITS ];
+};
+
+/*!
+*	\brief CIntegerModel, adaptive model of signed integers concentrated around 0
+*
+*	A value is mapped to 0,-1,1,-2,2,... -> 0,1,2,3,4,..., the number of bits of the
+*	result is coded adaptively, then the two bits below the leading one adaptively and
+*	the rest directly.
+*/
+struct CIntegerModel
+{
+	/*! Encode a value, |value| < 2^31. */
+	void encode( CRangeEncoder & rc, int value )
+	{
+		unsigned int u = ( value < 0 ) ? ( (unsigned int)( -( value + 1 ) ) << 1 ) | 1 : (unsigned int) value << 1;
+		int n = 0;
+		while( n < 32 && ( u >> n ) != 0 ) n ++;
+		length.encode( rc, n );
+		int b = n - 2, m = 1;
+		for( ; b >= 0 && b >= n - 3; b -- )
+		{
+			int bit = ( u >> b ) & 1;
+			rc.encode( high[n][m], bit );
+			m = ( m << 1 ) | bit;
+		}
+		if( b >= 0 ) rc.encode_direct( u & ( ( 2u << b ) - 1 ), b + 1 );
+	};
+	/*! Decode a value. */
+	int decode( CRangeDecoder & rc )
+	{
+		int n = (int) length.decode( rc );
+		if( n == 0 ) return 0;
+		if( n > 32 ) n = 32;
+		unsigned int u = 1;
+		int b = n - 2, m = 1;
+		for( ; b >= 0 && b >= n - 3; b -- )
+		{
+			int bit = rc.decode( high[n][m] );
+			u = ( u << 1 ) | bit;
+			m = ( m << 1 ) | bit;
+		}
+		if( b >= 0 ) u = ( u << ( b + 1 ) ) | rc.decode_direct( b + 1 );
+		return ( u & 1 ) ? -(int)( u >> 1 ) - 1 : (int)( u >> 1 );
+	};
+
+	/*! number of bits */
+	CBitTreeModel<6> length;
+	/*! the two bits below the leading one, by number of bits */
+	CBitModel        high[33][4];
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_RANGE_CODER_H_ defined
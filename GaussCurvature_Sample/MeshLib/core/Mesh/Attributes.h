@@ -0,0 +1,427 @@
+/*!
+*      \file Attributes.h
+*      \brief Typed per-element attributes declared at compile time
+*      \date 10/19/2026
+*
+*	An attribute is declared once by a tag, which gives its value type and its key in the
+*	trait string, e.g.
+*
+*		MESHLIB_ATTRIBUTE( CAttrK, double, "k" )
+*
+*	Element classes derive from CAttributes<Tag1, Tag2, ...>, which stores every attribute as
+*	a plain field and generates the text (key=(value)) and binary (de)serialization. Binary
+*	streams keep each attribute in its own column, all values of one attribute are contiguous.
+*/
+
+#ifndef _MESHLIB_ATTRIBUTES_H_
+#define _MESHLIB_ATTRIBUTES_H_
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <bitset>
+#include <iostream>
+
+#include "../Geometry/Point.h"
+#include "../Geometry/Point2.h"
+#include "../Parser/TraitParser.h"
+
+/*!
+ *	Declare an attribute tag
+ *	\param tag  name of the tag class
+ *	\param type value type of the attribute
+ *	\param key  key of the attribute in the trait string
+ */
+#define MESHLIB_ATTRIBUTE( tag, type, key ) \
+	struct tag { typedef type value_type; static const char * name() { return key; } };
+
+namespace MeshLib{
+
+/*!
+ *	\brief CAttributeType, describes how a value type is composed of scalar components
+ *
+ *	Specialized for double, float, int, CPoint and CPoint2.
+ */
+template<typename T>
+struct CAttributeType;
+
+template<>
+struct CAttributeType<double>
+{
+	typedef double scalar_type;
+	enum { components = 1, code = 'd' };
+	static scalar_type * data( double & v ) { return &v; };
+};
+
+template<>
+struct CAttributeType<float>
+{
+	typedef float scalar_type;
+	enum { components = 1, code = 'f' };
+	static scalar_type * data( float & v ) { return &v; };
+};
+
+template<>
+struct CAttributeType<int>
+{
+	typedef int scalar_type;
+	enum { components = 1, code = 'i' };
+	static scalar_type * data( int & v ) { return &v; };
+};
+
+template<>
+struct CAttributeType<CPoint>
+{
+	typedef double scalar_type;
+	enum { components = 3, code = 'd' };
+	static scalar_type * data( CPoint & v ) { return &v[0]; };
+};
+
+template<>
+struct CAttributeType<CPoint2>
+{
+	typedef double scalar_type;
+	enum { components = 2, code = 'd' };
+	static scalar_type * data( CPoint2 & v ) { return &v[0]; };
+};
+
+/*!
+ *	\brief TAttribute, storage slot of one attribute
+ *	\tparam Tag attribute tag, declared by MESHLIB_ATTRIBUTE
+ */
+template<typename Tag>
+class TAttribute
+{
+public:
+	/*! constructor, the value is zero initialized */
+	TAttribute() : m_value() {};
+	/*! reference to the attribute value */
+	typename Tag::value_type & value() { return m_value; };
+
+protected:
+	/*! attribute value */
+	typename Tag::value_type m_value;
+};
+
+/*!
+ *	\brief CAttributes, mixin holding a compile time list of attributes
+ *
+ *	\tparam Tags attribute tags, declared by MESHLIB_ATTRIBUTE
+ */
+template<typename... Tags>
+class CAttributes : public TAttribute<Tags>...
+{
+public:
+	/*! the attribute list, used to detect attribute carrying elements */
+	typedef CAttributes<Tags...> attribute_list;
+
+	/*!
+	 *	Access an attribute
+	 *	\tparam Tag the attribute tag
+	 */
+	template<typename Tag>
+	typename Tag::value_type & attr() { return static_cast<TAttribute<Tag>&>( *this ).value(); };
+
+	/*!
+	 *	Visit all the attribute tags, f.template visit<Tag>() is called for every tag
+	 */
+	template<typename F>
+	static void for_each_attribute( F & f )
+	{
+		int dummy[] = { 0, ( f.template visit<Tags>(), 0 )... };
+		(void) dummy;
+	};
+
+	/*!
+	 *	Write all attributes as key=(value) tokens into a trait string. Tokens with the
+	 *	same keys are replaced, the other traits in the string are kept.
+	 *	\param str the trait string
+	 */
+	void _attributes_to_string( std::string & str )
+	{
+		int dummy[] = { 0, ( _write_token<Tags>( str ), 0 )... };
+		(void) dummy;
+	};
+	/*!
+	 *	Read all attributes from the key=(value) tokens of a trait string,
+	 *	attributes missing in the string are left untouched.
+	 *	\param str the trait string
+	 */
+	void _attributes_from_string( const std::string & str )
+	{
+		_attributes_from_trait( CStringView( str.c_str(), str.c_str() + str.size() ) );
+	};
+	/*!
+	 *	Read all attributes from a trait in one pass over its tokens, the first token of a
+	 *	key wins, attributes missing in the trait are left untouched.
+	 *	\param trait the trait, e.g. the {...} block of a line in the mesh file
+	 *	\return whether the trait has tokens which are no attributes
+	 */
+	bool _attributes_from_trait( const CStringView & trait )
+	{
+		CTraitParser parser( trait );
+		CStringView  key, value;
+		std::bitset<sizeof...(Tags)> seen;
+		bool other = false;
+		while( parser.next( key, value ) )
+		{
+			bool matched = false;
+			int  i       = 0;
+			int dummy[] = { 0, ( matched = _read_token<Tags>( key, value, seen, i ++ ) || matched, 0 )... };
+			(void) dummy;
+			other = other || !matched;
+		}
+		return other;
+	};
+	/*!
+	 *	Write the raw attribute values to a binary stream, in the order of the tags
+	 */
+	void _attributes_write( std::ostream & os )
+	{
+		int dummy[] = { 0, ( _write_value<Tags>( os ), 0 )... };
+		(void) dummy;
+	};
+	/*!
+	 *	Read the raw attribute values from a binary stream, in the order of the tags
+	 */
+	void _attributes_read( std::istream & is )
+	{
+		int dummy[] = { 0, ( _read_value<Tags>( is ), 0 )... };
+		(void) dummy;
+	};
+
+protected:
+
+	template<typename Tag>
+	void _write_token( std::string & str )
+	{
+		typedef CAttributeType<typename Tag::value_type> T;
+		CTraitParser::remove( str, Tag::name() );
+
+		typename T::scalar_type * p = T::data( attr<Tag>() );
+		double v[T::components];
+		for( int i = 0; i < T::components; i ++ ) v[i] = (double) p[i];
+		CTraitParser::append( str, Tag::name(), v, T::components );
+	};
+
+	template<typename Tag>
+	bool _read_token( const CStringView & key, const CStringView & value, std::bitset<sizeof...(Tags)> & seen, int i )
+	{
+		typedef CAttributeType<typename Tag::value_type> T;
+		if( !( key == Tag::name() ) ) return false;
+		if( seen[i] ) return true;
+		seen.set( i );
+
+		typename T::scalar_type * p = T::data( attr<Tag>() );
+		const char * pt = value.begin();
+		for( int k = 0; k < T::components; k ++ )
+		{
+			double v;
+			while( pt < value.end() && *pt == ' ' ) pt ++;
+			if( !fast_parse_double( pt, value.end(), v ) ) break;
+			p[k] = (typename T::scalar_type) v;
+		}
+		return true;
+	};
+
+	template<typename Tag>
+	void _write_value( std::ostream & os )
+	{
+		typedef CAttributeType<typename Tag::value_type> T;
+		os.write( (const char*) T::data( attr<Tag>() ), sizeof( typename T::scalar_type ) * T::components );
+	};
+
+	template<typename Tag>
+	void _read_value( std::istream & is )
+	{
+		typedef CAttributeType<typename Tag::value_type> T;
+		is.read( (char*) T::data( attr<Tag>() ), sizeof( typename T::scalar_type ) * T::components );
+	};
+};
+
+/*!
+ *	\brief CHasAttributes, whether an element class derives from CAttributes
+ */
+template<typename T>
+class CHasAttributes
+{
+	template<typename U> static char _test( typename U::attribute_list * );
+	template<typename U> static long _test( ... );
+public:
+	enum { value = ( sizeof( _test<T>( 0 ) ) == sizeof(char) ) };
+};
+
+/*!
+ *	\brief CTraitAttributes, reads the attributes of an element straight from the trait of a
+ *	mesh file, so that traits made of attributes only need no trait string
+ */
+template<typename Element, bool has_attributes = CHasAttributes<Element>::value>
+struct CTraitAttributes
+{
+	/*!
+	 *	Read the attributes of an element from a trait
+	 *	\return whether the trait has to be kept as the string of the element
+	 */
+	static bool read( Element * e, const CStringView & trait ) { return e->_attributes_from_trait( trait ); };
+};
+
+template<typename Element>
+struct CTraitAttributes<Element,false>
+{
+	static bool read( Element *, const CStringView & ) { return true; };
+};
+
+/*!
+ *	\brief CAttributeColumnCounter, number of attributes of an element class
+ */
+template<typename Element>
+struct CAttributeColumnCounter
+{
+	struct CCount
+	{
+		int n;
+		template<typename Tag> void visit() { n ++; };
+	};
+	static void count( int & n )
+	{
+		CCount c; c.n = 0;
+		Element::attribute_list::for_each_attribute( c );
+		n = c.n;
+	};
+};
+
+/*!
+ *	\brief CAttributeColumnWriter, writes one column per attribute of a range of elements
+ *
+ *	Column layout: key length (int), key, type code (char), components (int), count (int),
+ *	followed by count * components scalars.
+ */
+template<typename Element, typename Iterator>
+class CAttributeColumnWriter
+{
+public:
+	CAttributeColumnWriter( std::ostream & os, Iterator begin, Iterator end, int count )
+		: m_os( os ), m_begin( begin ), m_end( end ), m_count( count ) {};
+
+	template<typename Tag>
+	void visit()
+	{
+		typedef CAttributeType<typename Tag::value_type> T;
+		int  len  = (int) strlen( Tag::name() );
+		char code = (char) T::code;
+		int  comp = T::components;
+
+		m_os.write( (const char*) &len, sizeof(int) );
+		m_os.write( Tag::name(), len );
+		m_os.write( &code, 1 );
+		m_os.write( (const char*) &comp, sizeof(int) );
+		m_os.write( (const char*) &m_count, sizeof(int) );
+
+		for( Iterator iter = m_begin; iter != m_end; ++ iter )
+		{
+			Element * pE = *iter;
+			m_os.write( (const char*) T::data( pE->template attr<Tag>() ), sizeof( typename T::scalar_type ) * T::components );
+		}
+	};
+
+protected:
+	std::ostream & m_os;
+	Iterator       m_begin;
+	Iterator       m_end;
+	int            m_count;
+};
+
+/*!
+ *	Write the attribute columns of a range of elements.
+ *	\param os    binary output stream
+ *	\param begin first element
+ *	\param end   past the last element
+ *	\param count number of elements in the range
+ */
+template<typename Element, typename Iterator>
+void write_attribute_columns( std::ostream & os, Iterator begin, Iterator end, int count )
+{
+	int n = 0;
+	CAttributeColumnCounter<Element>::count( n );
+	os.write( (const char*) &n, sizeof(int) );
+
+	CAttributeColumnWriter<Element,Iterator> writer( os, begin, end, count );
+	Element::attribute_list::for_each_attribute( writer );
+};
+
+/*!
+ *	\brief CAttributeColumnReader, fills the attribute of a range of elements from a column
+ */
+template<typename Element, typename Iterator>
+class CAttributeColumnReader
+{
+public:
+	CAttributeColumnReader( std::istream & is, Iterator begin, Iterator end, const std::string & key, char code, int comp, bool & found )
+		: m_is( is ), m_begin( begin ), m_end( end ), m_key( key ), m_code( code ), m_comp( comp ), m_found( found ) {};
+
+	template<typename Tag>
+	void visit()
+	{
+		typedef CAttributeType<typename Tag::value_type> T;
+		if( m_found || m_key != Tag::name() ) return;
+		if( m_code != (char) T::code || m_comp != T::components ) return;
+
+		for( Iterator iter = m_begin; iter != m_end; ++ iter )
+		{
+			Element * pE = *iter;
+			m_is.read( (char*) T::data( pE->template attr<Tag>() ), sizeof( typename T::scalar_type ) * T::components );
+		}
+		m_found = true;
+	};
+
+protected:
+	std::istream &      m_is;
+	Iterator            m_begin;
+	Iterator            m_end;
+	const std::string & m_key;
+	char                m_code;
+	int                 m_comp;
+	bool &              m_found;
+};
+
+/*!
+ *	Read the attribute columns of a range of elements, written by write_attribute_columns.
+ *	Columns matched by key and type are read, the others are skipped.
+ *	\param is    binary input stream
+ *	\param begin first element
+ *	\param end   past the last element
+ */
+template<typename Element, typename Iterator>
+void read_attribute_columns( std::istream & is, Iterator begin, Iterator end )
+{
+	int n = 0;
+	is.read( (char*) &n, sizeof(int) );
+
+	for( int k = 0; k < n && is.good(); k ++ )
+	{
+		int  len, comp, count;
+		char code;
+		is.read( (char*) &len, sizeof(int) );
+		std::string key( len, ' ' );
+		is.read( &key[0], len );
+		is.read( &code, 1 );
+		is.read( (char*) &comp, sizeof(int) );
+		is.read( (char*) &count, sizeof(int) );
+
+		bool found = false;
+		CAttributeColumnReader<Element,Iterator> reader( is, begin, end, key, code, comp, found );
+		Element::attribute_list::for_each_attribute( reader );
+
+		if( !found )
+		{
+			int size = ( code == 'd' )? sizeof(double) : 4;
+			is.seekg( (std::streamoff) size * comp * count, std::ios::cur );
+		}
+	}
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_ATTRIBUTES_H_ defined
@@ -1,2090 +1,3202 @@
-/*!
-*      \file BaseMesh.h
-*      \brief Base Mesh Class for all types of Mesh Classes
-*
-*		This is the fundamental class for meshes
-*	   \author David Gu
-*      \date 10/07/2010
-*
-*/
-
-#ifndef _MESHLIB_BASE_MESH_H_
-#define _MESHLIB_BASE_MESH_H_
-
-#define MAX_LINE 2048
-
-#include <math.h>
-#include <assert.h>
-#include <iostream>
-#include <fstream>
-#include <list>
-#include <vector>
-#include <map>
-
-#include "../Geometry/Point.h"
-#include "../Geometry/Point2.h"
-#include "../Parser/StrUtil.h"
-
-namespace MeshLib{
-
-/*!
-* \brief CBaseMesh, base class for all types of mesh classes
-*
-*  This is the fundamental class for meshes. It includes a list of vertices,
-*  a list of edges, a list of faces. All the geometric objects are connected by pointers,
-*  vertex, edge, face are connected by halfedges. The mesh class has file IO functionalities,
-*  supporting .obj, .m and .off file formats. It offers Euler operators, each geometric primative
-*  can access its neighbors freely. 
-*  
-* \tparam CVertex   vertex   class, derived from MeshLib::CVertex   class
-* \tparam CEdge     edge     class, derived from MeshLib::CEdge     class
-* \tparam CFace     face     class, derived from MeshLib::CFace     class
-* \tparam CHalfEdge halfedge class, derived from MeshLib::CHalfEdge class
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-class CBaseMesh
-{
-public:
-	// pointer to Vertices, Halfedges, Edges, Face and Solid
-	typedef CVertex   * tVertex;
-	typedef CHalfEdge * tHalfEdge;
-	typedef CEdge     * tEdge;
-	typedef CFace     * tFace;
-
-	//constructor and destructor
-	/*!
-	CBaseMesh constructor.
-	*/
-	CBaseMesh(){};
-	/*!
-	CBasemesh destructor
-	*/
-	~CBaseMesh();
-
-	//copy operator
-	/*!
-	Copy operator
-	*/
-	void copy( CBaseMesh & mesh );
-
-	//file io
-	/*!
-	Read an .obj file.
-	\param filename the input .obj file name
-	*/
-	void read_obj(  const char * filename );
-	/*!
-	Write an .obj file.
-	\param output the output .obj file name
-	*/
-	void write_obj( const char * output);
-
-	/*!
-	Read an .m file.
-	\param input the input obj file name
-	*/
-	void read_m(  const char * input );
-	/*!
-	Write an .m file.
-	\param output the output .m file name
-	*/
-	void write_m( const char * output);
-	
-	/*!
-	Read an .off file
-	\param input the input .off filename
-	*/
-	void read_off( const char * input );
-	/*!
-	Write an .off file.
-	\param output the output .off file name
-	*/
-	void write_off( const char * output);
-
-	//number of vertices, faces, edges
-	/*! number of vertices */
-	int  numVertices();
-	/*! number of edges */
-	int  numEdges();
-	/*! number of faces */
-	int  numFaces();
-
-	//is boundary
-	/*! whether a vertex is on the boundary
-	\param v the pointer to the vertex
-	*/
-	bool    isBoundary( tVertex  v );
-	/*! whether an edge is on the boundary
-	\param e the pointer to the edge
-	*/
-	bool    isBoundary( tEdge    e );
-	/*! whether a halfedge is on the boundary
-	\param he the pointer to the halfedge
-	*/
-	bool    isBoundary( tHalfEdge  he );
-
-	//acess vertex - id
-	/*!
-	Access a vertex by its id
-	\param id the vertex id
-	\return the vertex, whose ID equals to id. NULL, if there is no such a vertex.
-	*/
-	tVertex idVertex( int id );
-	/*!
-	The vertex id
-	\param v the input vertex
-	\return the vertex id.
-	*/
-	int     vertexId( tVertex  v );
-
-	//access face - id
-	/*!
-	Access a face by its id
-	\param id the face id
-	\return the face, whose ID equals to id. NULL, if there is no such a face.
-	*/
-	tFace   idFace( int id );
-	/*!
-	The face id
-	\param f the input face
-	\return the face id.
-	*/
-	int     faceId( tFace  f );
-
-	//access edge - edge key, vertex
-	/*!
-	Access an edge by its two end vertices
-	\param v0 one vertex of the edge
-	\param v1 the other vertex of the edge
-	\return the edge connecting both v0 and v1, NULL if no such edge exists.
-	*/
-	tEdge   vertexEdge( tVertex v0, tVertex v1 );
-
-	//access halfedge - halfedge key, vertex
-	/*!
-	Access a halfedge by its two end vertices
-	\param v0 one vertex of the halfedge
-	\param v1 the other vertex of the halfedge
-	\return the halfedge connecting both v0 and v1, NULL if no such edge exists.
-	*/
-	
-	tHalfEdge   vertexHalfedge( tVertex v0, tVertex v1 );
-	/*!
-	Access a halfedge by its target vertex, and attaching face.
-	\param v target vertex 
-	\param f attaching face
-	\return halfedge, whose target is v, attaching face is f. NULL if no such an halfedge exists.
-	*/
-	tHalfEdge   corner( tVertex v, tFace f);
-
-	//halfedge->face
-	/*!
-	The face a halfedge attaching to. 
-	\param he the input halfedge
-	\return the face he attaches
-	*/
-	tFace   halfedgeFace( tHalfEdge he );
-	//halfedge->vertex
-	/*!
-	The target vertex of a halfedge. 
-	\param he the input halfedge.
-	\return the target vertex of he.
-	*/
-	tVertex halfedgeVertex( tHalfEdge he );
-	//halfedge->vertex
-	/*!
-	The target vertex of a halfedge. 
-	\param he the input halfedge.
-	\return the target vertex of he.
-	*/
-	tVertex halfedgeTarget( tHalfEdge he );
-	//halfedge->vertex
-	/*!
-	The source vertex of a halfedge. 
-	\param he the input halfedge.
-	\return the source vertex of he.
-	*/
-	tVertex halfedgeSource( tHalfEdge he );
-
-	//halfedge->next
-	/*!
-	The next halfedge of a halfedge. 
-	\param he the input halfedge.
-	\return the next halfedge of he.
-	*/
-
-	tHalfEdge   halfedgeNext( tHalfEdge he );
-	//halfedge->prev
-	/*!
-	The previous halfedge of a halfedge. 
-	\param he the input halfedge.
-	\return the next halfedge of he.
-	*/
-	tHalfEdge   halfedgePrev( tHalfEdge he );
-	//halfedge->sym
-	/*!
-	The dual halfedge of a halfedge. 
-	\param he the input halfedge.
-	\return the dual halfedge of he.
-	*/
-	tHalfEdge   halfedgeSym( tHalfEdge he );
-	//halfedge->edge
-	/*!
-	The edge of a halfedge. 
-	\param he the input halfedge.
-	\return the edge of he.
-	*/
-
-	tEdge       halfedgeEdge( tHalfEdge he );
-	//v->halfedge
-	/*!
-	The halfedge targeting at a vertex. 
-	\param v the input vertex.
-	\return the halfedge targeting at v, which is the most ccw in halfedge of v.
-	*/
-	tHalfEdge   vertexHalfedge( tVertex v );
-	//v->edges
-	/*!
-	The edge list attaching to the vertex v, such that v is the first vertex of the edge
-	\param v the input vertex.
-	\return the reference to the edge list
-	*/
-	std::list<tEdge> &  vertexEdges( tVertex v );
-
-	//edge->vertex
-	/*!
-	The first vertex of an edge.
-	\param e the input edge.
-	\return the first vertex of e.
-	*/
-	tVertex edgeVertex1( tEdge  e );
-	/*!
-	The second vertex of an edge.
-	\param e the input edge.
-	\return the second vertex of e.
-	*/
-	tVertex edgeVertex2( tEdge  e );
-
-	//edge->face
-	/*!
-	The first face attaching to an edge.
-	\param e the input edge.
-	\return the first face attaching to e.
-	*/
-	tFace edgeFace1( tEdge  e );
-	/*!
-	The second face attaching to an edge.
-	\param e the input edge.
-	\return the second face attaching to e.
-	*/
-	tFace edgeFace2( tEdge  e );
-
-	//edge->halfedge
-	/*!
-	The halfedge attaching to an edge.
-	\param e the input edge.
-	\param id the index of the halfedge, either 0 or 1
-	\return the halfedge[i] attaching to edge e.
-	*/
-
-	tHalfEdge edgeHalfedge( tEdge  e, int id);
-
-	//face->halfedge
-	/*!
-	The first halfedge attaching to a face f.
-	\param f the input face.
-	\return the first halfedge attaching to f.
-	*/
-
-	tHalfEdge faceHalfedge( tFace f );
-
-	//Euler operations
-	/*!
-	The most Clw Out HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Clw Out HalfEdge of v.
-	*/
-	tHalfEdge vertexMostClwOutHalfEdge( tVertex  v );
-	/*!
-	The next Ccw Out HalfEdge 
-	\param he the input halfedge .
-	\return the next Ccw Out HalfEdge, sharing the same source of he.
-	*/
-
-	tHalfEdge vertexNextCcwOutHalfEdge( tHalfEdge  he );
-
-	/*!
-	The most Ccw Out HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Ccw Out HalfEdge of v.
-	*/
-	tHalfEdge vertexMostCcwOutHalfEdge( tVertex  v );
-	/*!
-	The next Clw Out HalfEdge 
-	\param he the input halfedge .
-	\return the next Clw Out HalfEdge, sharing the same source of he.
-	*/
-	tHalfEdge vertexNextClwOutHalfEdge( tHalfEdge  he );
-
-	/*!
-	The most Clw In HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Clw In HalfEdge of v.
-	*/
-	tHalfEdge vertexMostClwInHalfEdge( tVertex  v );
-	/*!
-	The next Ccw In HalfEdge 
-	\param he the input halfedge .
-	\return the next Ccw In HalfEdge, sharing the same target of he.
-	*/
-	tHalfEdge vertexNextCcwInHalfEdge( tHalfEdge  he );
-
-	/*!
-	The most Ccw In HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Ccw In HalfEdge of v.
-	*/
-	tHalfEdge vertexMostCcwInHalfEdge( tVertex  v );
-	/*!
-	The next Clw In HalfEdge 
-	\param he the input halfedge .
-	\return the next Clw In HalfEdge, sharing the same target of he.
-	*/
-	tHalfEdge vertexNextClwInHalfEdge( tHalfEdge  he );
-
-	/*!
-	The most Clw HalfEdge of a face
-	\param face the input face.
-	\return the most Clw HalfEdge of f.
-	*/
-	
-	tHalfEdge faceMostClwHalfEdge( tFace  face );
-	/*!
-	The most Ccw HalfEdge of a face
-	\param face the input face.
-	\return the most Ccw HalfEdge of f.
-	*/
-	tHalfEdge faceMostCcwHalfEdge( tFace  face );
-	/*!
-	The next Ccw HalfEdge of a halfedge in a face
-	\param he the input halfedge.
-	\return the next Ccw HalfEdge of he in a face.
-	*/
-	tHalfEdge faceNextCcwHalfEdge( tHalfEdge  he );
-	/*!
-	The next Clw HalfEdge of a halfedge in a face
-	\param he the input halfedge.
-	\return the next Clw HalfEdge of he in a face.
-	*/
-	tHalfEdge faceNextClwHalfEdge( tHalfEdge  he );
-
-
-	/*!
-	Edge length
-	\param e the input edge
-	\return the length of the edge e
-	*/
-	double edgeLength( tEdge e );
-
-	/*!
-	List of the edges of the mesh.
-	*/
-	std::list<tEdge>   & edges()		{ return m_edges; };
-	/*!
-	List of the faces of the mesh.
-	*/
-	std::list<tFace>   & faces()		{ return m_faces; };
-	/*!
-	List of the vertices of the mesh.
-	*/
-	std::list<tVertex> & vertices()	{ return m_verts; };
-/*
-	bool with_uv() { return m_with_texture; };
-	bool with_normal() { return m_with_normal; };
-*/
-protected:
-
-  /*! list of edges */
-  std::list<tEdge>                          m_edges;
-  /*! list of vertices */
-  std::list<tVertex>                        m_verts;
-  /*! list of faces */
-  std::list<tFace>							m_faces;
-
-  //maps
-
-  /*! map between vetex and its id*/
-  std::map<int, tVertex>                    m_map_vert;
-  /*! map between face and its id*/
-  std::map<int, tFace>						m_map_face;
-
-
-public:
-	/*! Create a vertex 
-	\param id Vertex id
-	\return pointer to the new vertex
-	*/
-	tVertex   createVertex(   int id = 0 );
-	/*! Create an edge
-	\param v1 end vertex of the edge
-	\param v2 end vertex of the edge
-	\return pointer to the new edge
-	*/
-	tEdge     createEdge(	tVertex v1, tVertex v2 );
-	/*! Create a face
-	\param v an array of vertices
-	\param id face id
-	\return pointer to the new face
-	*/
-	tFace     createFace(   tVertex  v[], int id ); //create a triangle
-	/*! Create a face
-	\param v an array of vertices
-	\param id face id
-	\return pointer to the new face
-	*/
-	tFace     createFace(   std::vector<tVertex> &  v, int id ); //create a triangle
-
-	/*! delete one face
-	\param pFace the face to be deleted
-	*/
-	void      deleteFace( tFace  pFace );
-	
-	/*! whether the vertex is with texture coordinates */
-	bool      m_with_texture;
-	/*! whether the mesh is with normal */
-	bool      m_with_normal;
-
-	/*! label boundary vertices, edges, faces */
-	void labelBoundary( void );
-
-};
-
-
-
-/*!
-The first vertex of an edge.
-\param e the input edge.
-\return the first vertex of e.
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeVertex1( tEdge   e )
-{
-	assert( e->halfedge(0 ) != NULL );
-	return (CVertex*)e->halfedge(0)->source();
-};
-
-/*!
-The second vertex of an edge.
-\param e the input edge.
-\return the first vertex of e.
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CVertex *  CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeVertex2( tEdge   e )
-{
-	assert( e->halfedge(0 ) != NULL );
-	return (CVertex*)e->halfedge(0)->target();
-};
-
-/*!
-The first face attaching to an edge.
-\param e the input edge.
-\return the first face attaching to e.
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeFace1( tEdge   e )
-{
-	assert( e->halfedge(0) != NULL );
-	return (CFace*) e->halfedge(0)->face();
-};
-
-//access he->f
-/*!
-The halfedge attaching to an edge.
-\param e the input edge.
-\param id the index of the halfedge, either 0 or 1
-\return the halfedge[i] attaching to edge e.
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeHalfedge( tEdge   e, int id )
-{
-	return (CHalfEdge*)e->halfedge(id);
-};
-
-//access e->f
-/*!
-The second face attaching to an edge.
-\param e the input edge.
-\return the first face attaching to e.
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeFace2( tEdge   e )
-{
-	assert( e->halfedge(1) != NULL );
-	return (CFace*) e->halfedge(1)->face();
-};
-
-//access he->f
-/*!
-	The face a halfedge attaching to. 
-	\param he the input halfedge
-	\return the face he attaches
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeFace( tHalfEdge   he )
-{
-	return (CFace*)he->face();
-};
-
-//access f->he
-	/*!
-	The first halfedge attaching to a face f.
-	\param f the input face.
-	\return the first halfedge attaching to f.
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceHalfedge( tFace   f )
-{
-	return (CHalfEdge*)f->halfedge();
-};
-
-
-//access he->next
-/*!
-	The next halfedge of a halfedge. 
-	\param he the input halfedge.
-	\return the next halfedge of he.
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeNext( tHalfEdge   he )
-{
-	return (CHalfEdge*)he->he_next();
-};
-
-//access he->prev
-/*!
-	The previous halfedge of a halfedge. 
-	\param he the input halfedge.
-	\return the next halfedge of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgePrev( tHalfEdge  he )
-{
-	return (CHalfEdge*)he->he_prev();
-};
-
-//access he->sym
-/*!
-	The dual halfedge of a halfedge. 
-	\param he the input halfedge.
-	\return the dual halfedge of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeSym( tHalfEdge   he )
-{
-	return (CHalfEdge*)he->he_sym();
-};
-
-//access he->edge
-/*!
-	The edge of a halfedge. 
-	\param he the input halfedge.
-	\return the edge of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeEdge( tHalfEdge  he )
-{
-	return (CEdge*)he->edge();
-};
-
-//access he->v
-/*!
-	The target vertex of a halfedge. 
-	\param he the input halfedge.
-	\return the target vertex of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeVertex( tHalfEdge  he )
-{
-	return (CVertex*)he->vertex();
-};
-
-//access he->v
-/*!
-	The target vertex of a halfedge. 
-	\param he the input halfedge.
-	\return the target vertex of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeTarget( tHalfEdge   he )
-{
-	return (CVertex*)he->vertex();
-};
-
-//access he->v
-/*!
-	The source vertex of a halfedge. 
-	\param he the input halfedge.
-	\return the source vertex of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeSource( tHalfEdge   he )
-{
-	return (CVertex*)he->he_prev()->vertex();
-};
-/*! whether a vertex is on the boundary
-	\param v the pointer to the vertex
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::isBoundary( tVertex   v )
-{
-	return v->boundary();
-};
-/*! whether an edge is on the boundary
-	\param e the pointer to the edge
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::isBoundary( tEdge   e )
-{
-	if( e->halfedge(0) == NULL || e->halfedge(1) == NULL ) return true;
-	return false;
-};
-/*! whether a halfedge is on the boundary
-	\param he the pointer to the halfedge
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::isBoundary( tHalfEdge   he )
-{
-	if( he->he_sym() == NULL ) return true;
-	return false;
-};
-
-/*! Number of vertices of the mesh
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::numVertices() 
-{
-	return (int) m_verts.size();
-};
-
-/*! Number of edges of the mesh
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::numEdges() 
-{
-	return (int) m_edges.size();
-};
-
-/*! Number of faces of the mesh
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::numFaces() 
-{
-	return (int) m_faces.size();
-};
-
-
-//Euler operation
-/*!
-	The most Clw Out HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Clw Out HalfEdge of v.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge *  CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostClwOutHalfEdge( tVertex   v )
-{
-	return (CHalfEdge*)v->most_clw_out_halfedge();
-};
-/*!
-	The next Ccw Out HalfEdge 
-	\param v the input vertex.
-	\return the next Ccw Out HalfEdge, sharing the same source of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostCcwOutHalfEdge( tVertex   v )
-{
-	return (CHalfEdge*)v->most_ccw_out_halfedge();
-};
-
-/*!
-	Access a halfedge by its target vertex, and attaching face.
-	\param v target vertex 
-	\param f attaching face
-	\return halfedge, whose target is v, attaching face is f. NULL if no such an halfedge exists.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::corner( tVertex  v, tFace  f)
-{
-	CHalfEdge * he = faceMostCcwHalfEdge( f );
-	do{
-		if( he->vertex() == v )
-			return (CHalfEdge*) he;
-		he = faceNextCcwHalfEdge( he );
-	}while( he != faceMostCcwHalfEdge(f) );
-	return NULL;
-};
-/*!
-	The next Ccw Out HalfEdge 
-	\param he the input halfedge .
-	\return the next Ccw Out HalfEdge, sharing the same source of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextCcwOutHalfEdge( tHalfEdge  he )
-{
-	return (CHalfEdge*) he->ccw_rotate_about_source();
-};
-/*!
-	The next Clw Out HalfEdge 
-	\param he the input halfedge .
-	\return the next Clw Out HalfEdge, sharing the same source of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextClwOutHalfEdge( tHalfEdge   he )
-{
-	assert( he->he_sym() != NULL );
-	return (CHalfEdge*)he->clw_rotate_about_source();
-};
-	/*!
-	The most Clw In HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Clw In HalfEdge of v.
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostClwInHalfEdge( tVertex   v )
-{
-	return (CHalfEdge*)v->most_clw_in_halfedge();
-};
-	/*!
-	The most Ccw In HalfEdge of a vertex
-	\param v the input vertex.
-	\return the most Clw In HalfEdge of v.
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostCcwInHalfEdge( tVertex   v )
-{
-	return (CHalfEdge*)v->most_ccw_in_halfedge();
-};
-
-	/*!
-	The next Ccw In HalfEdge 
-	\param he the input halfedge .
-	\return the next Ccw In HalfEdge, sharing the same target of he.
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextCcwInHalfEdge( tHalfEdge   he )
-{
-	assert( he->he_sym() != NULL );
-	return (CHalfEdge*)he->ccw_rotate_about_target();
-};
-/*!
-	The next Clw In HalfEdge 
-	\param he the input halfedge .
-	\return the next Clw In HalfEdge, sharing the same target of he.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextClwInHalfEdge( tHalfEdge   he )
-{
-	return (CHalfEdge*)he->clw_rotate_about_target();
-};
-/*!
-	The next Clw HalfEdge of a halfedge in a face
-	\param he the input halfedge.
-	\return the next Clw HalfEdge of he in a face.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceNextClwHalfEdge( tHalfEdge   he )
-{
-	return (CHalfEdge*)he->he_prev();
-};
-/*!
-	The next Ccw HalfEdge of a halfedge in a face
-	\param he the input halfedge.
-	\return the next Ccw HalfEdge of he in a face.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceNextCcwHalfEdge( tHalfEdge   he )
-{
-	return (CHalfEdge*)he->he_next();
-};
-
-/*!
-	The most Ccw HalfEdge of a face
-	\param face the input face.
-	\return the most Ccw HalfEdge of f.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge *  CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceMostCcwHalfEdge( tFace   face )
-{
-	return (CHalfEdge*)face->halfedge();
-};
-/*!
-	The most Clw HalfEdge in a face
-	\param face the input face.
-	\return the most Clw HalfEdge in a face.
-	*/template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceMostClwHalfEdge( tFace   face )
-{
-	return (CHalfEdge*)face->halfedge()->he_next();
-};
-/*!
- CBaseMesh destructor
- */
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::~CBaseMesh()
-{
-	//remove vertices
-
-  for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++ )
-  {
-      CVertex * pV = *viter;
-      delete pV;
-  }
-  m_verts.clear();
-
-	//remove faces
-
-  for( std::list<CFace*>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-  {
-      CFace * pF = *fiter;
-
-      tHalfEdge he = faceHalfedge( pF );
- 
-      std::list<CHalfEdge*> hes;
-      do{
-        he = halfedgeNext( he );
-        hes.push_back( he );
-      }while( he != pF->halfedge() );
-
-      for( std::list<CHalfEdge*>::iterator hiter = hes.begin(); hiter != hes.end(); hiter ++)
-      {
-          CHalfEdge * pH = *hiter;
-          delete pH;
-      }
-      hes.clear();
-
-      delete pF;
-  }
-  m_faces.clear();
-	
-  //remove edges
-  for( std::list<CEdge*>::iterator eiter = m_edges.begin(); eiter != m_edges.end(); eiter ++ )
-  {
-      CEdge * pE = *eiter;
-      delete pE;
-  }
-
-  m_edges.clear();
-	
-  //clear all the maps
-  m_map_vert.clear();
-  m_map_face.clear();
-  //m_map_edge.clear();
-};
-
-/*!
-	Edge length
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-double CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeLength( tEdge  e )
-{
-	CVertex * v1 = edgeVertex1(e);
-	CVertex * v2 = edgeVertex2(e);
-
-	return ( v1->point() - v2->point() ).norm();
-}
-
-
-//create new gemetric simplexes
-/*! Create a vertex 
-\param id Vertex id
-\return pointer to the new vertex
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createVertex( int id )
-{
-	CVertex * v = new CVertex();
-	assert( v != NULL );
-	v->id() = id;
-	m_verts.push_back( v );
-	m_map_vert.insert( std::pair<int,CVertex*>(id,v));
-	return v;
-};
-
-
-/*!
-Read an .obj file.
-\param filename the filename .obj file name
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_obj( const char * filename )
-{
-a
-	std::fstream f(filename, std::fstream::in);
-	if( f.fail() ) return;
-
-	char cmd[1024];
-
-	int  vid = 1;
-	int  fid = 1;
-	
-	bool with_uv = false;
-	bool with_normal = false;
-
-	std::vector<CPoint2> uvs;
-	std::vector<CPoint> normals;
-
-
-	while ( f.getline( cmd, 1024) )
-    {
-		std::string line( cmd );
-		line = strutil::trim( line );
-
-		strutil::Tokenizer stokenizer( line, " \t\r\n" );
-
-		stokenizer.nextToken();
-		std::string token = stokenizer.getToken();
-		
-		if( token == "v" )
-		{
-			CPoint p;
-			for( int i = 0; i < 3; i ++ )
-			{
-				stokenizer.nextToken();
-				token = stokenizer.getToken();
-				p[i] = strutil::parseString<float>(token);
-			}
-			
-			CVertex * v = createVertex( vid);
-			v->point() = p;
-			vid ++;
-			continue;
-		}
-
-
-		if( token == "vt" )
-		{
-			with_uv = true;
-			CPoint2 uv;
-			for( int i = 0; i < 2; i ++ )
-			{
-				stokenizer.nextToken();
-				token = stokenizer.getToken();
-				uv[i] = strutil::parseString<float>(token);
-			}
-			uvs.push_back( uv );
-			continue;
-		}
-
-
-		if ( token ==  "vn" )
-		{
-			with_normal = true;
-
-			CPoint n;
-			for( int i = 0; i < 3; i ++ )
-			{
-				stokenizer.nextToken();
-				token = stokenizer.getToken();
-				n[i] = strutil::parseString<float>(token);
-			}
-			normals.push_back( n );
-			continue;
-		}
-
-
-
-
-		if ( token == "f" )
-		{
-			CVertex* v[3];
-			for( int i = 0 ; i < 3; i ++ )
-			{
-				stokenizer.nextToken();
-				token = stokenizer.getToken();
-				
-				
-				strutil::Tokenizer tokenizer( token, " /\t\r\n" );
-				
-				int ids[3];
-				int k = 0;
-				while( tokenizer.nextToken() )
-				{
-					std::string token = tokenizer.getToken();
-					ids[k] = strutil::parseString<int>(token);
-					k ++;
-				}
-
-				
-				v[i] = m_map_vert[ ids[0] ];
-				if( with_uv )
-					v[i]->uv() = uvs[ ids[1]-1 ];
-				if( with_normal )
-					v[i]->normal() = normals[ ids[2]-1 ];
-			}
-			createFace( v, fid++ );
-		}
-	}
-
-	f.close();
-
-	labelBoundary();
-}
-
-/*! Create a face
-	\param v an array of vertices
-	\param id face id
-	\return pointer to the new face
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createFace( tVertex  v[] , int id )
-{
-	  CFace * f = new CFace();
-	  assert( f != NULL );
-	  f->id() = id;
-	  m_faces.push_back( f );
-	  m_map_face.insert( std::pair<int,tFace>(id,f) );
-
-		//create halfedges
-		tHalfEdge hes[3];
-
-		for(int i = 0; i < 3; i ++ )
-		{
-			hes[i] = new CHalfEdge;
-			assert( hes[i] );
-			CVertex * vert =  v[i];
-			hes[i]->vertex() = vert;
-			vert->halfedge() = hes[i];
-		}
-
-		//linking to each other
-		for(int i = 0; i < 3; i ++ )
-		{
-			hes[i]->he_next() = hes[(i+1)%3];
-			hes[i]->he_prev() = hes[(i+2)%3];
-		}
-
-		//linking to face
-		for(int i = 0; i < 3; i ++ )
-		{
-			hes[i]->face()   = f;
-			f->halfedge()    = hes[i];
-		}
-
-		//connecting with edge
-		for(int i = 0; i < 3; i ++ )
-		{
-			tEdge e = createEdge( v[i], v[(i+2)%3] );
-			if( e->halfedge(0)  == NULL )
-			{
-				e->halfedge(0) = hes[i];
-			}
-			else
-			{
-				assert( e->halfedge(1) == NULL );
-				e->halfedge(1) = hes[i];
-			}
-			hes[i]->edge() = e;
-		}
-
-		return f;
-};
-
-
-//access id->v
-/*!
-Access a vertex by its id
-\param id the vertex id
-\return the vertex, whose ID equals to id. NULL, if there is no such a vertex.
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::idVertex( int id ) 
-{
-	return m_map_vert[id];
-};
-
-//access v->id
-/*!
-	The vertex id
-	\param v the input vertex
-	\return the vertex id.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexId( tVertex   v )
-{
-	return v->id();
-};
-
-//access id->f
-/*!
-	Access a face by its id
-	\param id the face id
-	\return the face, whose ID equals to id. NULL, if there is no such a face.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::idFace( int id )
-{
-	return m_map_face[id];
-};
-
-//acess f->id
-/*!
-	The face id
-	\param f the input face
-	\return the face id.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceId( tFace   f )
-{
-	return f->id();
-};
-
-/*! Create an edge
-\param v1 end vertex of the edge
-\param v2 end vertex of the edge
-\return pointer to the new edge
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createEdge( tVertex  v1, tVertex  v2 )
-{
-	tVertex pV = ( v1->id()<v2->id())?v1:v2;
-	std::list<CEdge*> & ledges = (std::list<CEdge*> &) pV->edges();
-	//std::cout<< pV->uv()[0]<<" "<< pV->uv()[1]<<" "<<ledges.size()<<std::endl;
-	
-	for( std::list<CEdge*>::iterator te = ledges.begin(); te != ledges.end(); te ++ )
-	{
-		CEdge	  * pE = *te;
-		CHalfEdge * pH = (CHalfEdge*) pE->halfedge(0);
-		if( pH->source() == v1 && pH->target() == v2 ) 
-		{
-			return pE;		
-		}
-		if( pH->source() == v2 && pH->target() == v1 )
-		{
-			return pE;
-		}	
-		
-	}
-
-	//new edge
-	CEdge * e = new CEdge;
-	assert( e != NULL );
-	m_edges.push_back( e );
-	ledges.push_back( e );
-
-
-	return e;
-
-};
-
-
-
-//access vertex->edge
-/*!
-Access an edge by its two end vertices
-\param v0 one vertex of the edge
-\param v1 the other vertex of the edge
-\return the edge connecting both v0 and v1, NULL if no such edge exists.
-*/
-//use the edge list associated with each vertex to locate the edge
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexEdge( tVertex  v0, tVertex  v1 )
-{
-	CVertex * pV = (v0->id() < v1->id() )? v0: v1;
-	std::list<CEdge*> & ledges = vertexEdges( pV );
-
-	for( std::list<CEdge*>::iterator eiter = ledges.begin(); eiter != ledges.end(); eiter ++ )
-	{
-		CEdge * pE = *eiter;
-		CHalfEdge * pH =  edgeHalfedge(pE,0);
-		if( pH->source() == v0 && pH->target() == v1 ) return pE;
-		if( pH->source() == v1 && pH->target() == v0 ) return pE;
-	}
-	return NULL;
-};
-
-/*!
-Access a halfedge by its two end vertices
-\param v0 one vertex of the halfedge
-\param v1 the other vertex of the halfedge
-\return the halfedge connecting both v0 and v1, NULL if no such edge exists.
-*/
-
-//access vertex->halfedge
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexHalfedge( tVertex  v0, tVertex  v1 )
-{
-	CEdge * e = vertexEdge( v0, v1 );
-	assert( e != NULL );
-	CHalfEdge * he = (CHalfEdge*) e->halfedge(0);
-	if( he->vertex() == v1 && he->he_prev()->vertex() == v0 ) return he;
-	he = (CHalfEdge*) e->halfedge(1);
-	assert( he->vertex() == v1 && he->he_prev()->vertex() == v0 );
-	return he;
-};
-
-
-/*!
-Access the edge list of a vertex, {e} such that e->vertex1() == v
-\param v vertex
-\return the list of adjacent edges
-*/
-
-//access vertex->edges
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline std::list<CEdge*> & CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexEdges( tVertex  v0 )
-{
-	return (std::list<CEdge*> &)v0->edges();
-};
-
-//access vertex->halfedge
-/*!
-	The halfedge targeting at a vertex. 
-	\param v the input vertex.
-	\return the halfedge targeting at v, which is the most ccw in halfedge of v.
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexHalfedge( tVertex  v  )
-{
-	return (CHalfEdge*) v->halfedge();
-};
-
-/*!
-	Read an .m file.
-	\param input the input obj file name
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_m( const char * input )
-{
-	std::fstream is( input, std::fstream::in );
-
-	if( is.fail() )
-	{
-		fprintf(stderr,"Error in opening file %s\n", input );
-		return;
-	}
-
-	char buffer[MAX_LINE];
-	int id;
-
-	while( is.getline(buffer, MAX_LINE )  )
-	{		
-	
-		std::string line( buffer );
-		line = strutil::trim( line );
-
-		strutil::Tokenizer stokenizer( line, " \r\n" );
-
-		stokenizer.nextToken();
-		std::string token = stokenizer.getToken();
-	
-		if( token == "Vertex"  ) 
-		{
-			stokenizer.nextToken();
-			token = stokenizer.getToken();
-			id = strutil::parseString<int>(token);
-
-			CPoint p;
-			for( int i = 0 ; i < 3; i ++ )
-			{
-				stokenizer.nextToken();
-				token = stokenizer.getToken();
-				p[i] = strutil::parseString<float>(token);
-			}
-		
-			tVertex v  = createVertex( id );
-			v->point() = p;
-			v->id()    = id;
-
-			if( ! stokenizer.nextToken("\t\r\n") ) continue;
-			token = stokenizer.getToken();
-
-			int sp = (int) token.find("{");
-			int ep = (int) token.find("}");
-
-			if( sp >= 0 && ep >= 0 )
-			{
-				v->string() = token.substr( sp+1, ep-sp-1 );
-			}
-			continue;
-		}
-		
-
-		if( token == "Face" ) 
-		{
-
-			stokenizer.nextToken();
-			token = stokenizer.getToken();
-			id = strutil::parseString<int>(token);
-	
-			std::vector<CVertex*> v;
-			while( stokenizer.nextToken() )
-			{
-				token = stokenizer.getToken();
-				if( strutil::startsWith( token, "{" ) ) break;
-				int vid = strutil::parseString<int>(token);
-				v.push_back( idVertex( vid ) );
-			}
-
-			tFace f = createFace( v, id );
-
-			if( strutil::startsWith( token, "{" ) )
-			{
-				f->string() = strutil::trim( token, "{}" );
-			}
-			continue;
-		}
-
-		//read in edge attributes
-		if( token == "Edge" )
-		{
-			stokenizer.nextToken();
-			token = stokenizer.getToken();
-			int id0 = strutil::parseString<int>( token );
-
-			stokenizer.nextToken();
-			token = stokenizer.getToken();
-			int id1 = strutil::parseString<int>( token );
-
-
-			CVertex * v0 = idVertex( id0 );
-			CVertex * v1 = idVertex( id1 );
-
-			tEdge edge = vertexEdge( v0, v1 );
-
-			if( !stokenizer.nextToken("\t\r\n") ) continue;
-			token = stokenizer.getToken();	
-			
-			int sp = (int) token.find("{");
-			int ep = (int) token.find("}");
-
-			if( sp >= 0 && ep >= 0 )
-			{
-				  edge->string() = token.substr( sp+1, ep-sp-1 );
-			}
-			continue;
-		}
-
-		//read in edge attributes
-		if( token == "Corner" ) 
-		{
-			stokenizer.nextToken();
-			token = stokenizer.getToken();
-			int vid = strutil::parseString<int>( token );
-
-			stokenizer.nextToken();
-			token = stokenizer.getToken();
-			int fid = strutil::parseString<int>( token );
-
-
-			CVertex * v = idVertex( vid );
-			CFace   * f = idFace( fid );
-			tHalfEdge he = corner( v, f );
-
-
-			if( !stokenizer.nextToken("\t\r\n") ) continue;
-			token = stokenizer.getToken();	
-
-			int sp = (int) token.find("{");
-			int ep = (int) token.find("}");
-
-			if( sp >= 0 && ep >= 0 )
-			{
-				he->string() = token.substr( sp+1, ep-sp-1 );
-			}
-			continue;
-		}
-	}
-	
-	//labelBoundary();
-
-	//Label boundary edges
-	for(std::list<CEdge*>::iterator eiter= m_edges.begin() ; eiter != m_edges.end() ; ++ eiter )
-	{
-		CEdge *     edge = *eiter;
-		CHalfEdge * he[2];
-
-		he[0] = edgeHalfedge( edge, 0 );
-		he[1] = edgeHalfedge( edge, 1 );
-		
-		assert( he[0] != NULL );
-		
-
-		if( he[1] != NULL )
-		{
-			assert( he[0]->target() == he[1]->source() && he[0]->source() == he[1]->target() );
-
-			if( he[0]->target()->id() < he[0]->source()->id() )
-			{
-				edge->halfedge(0 ) = he[1];
-				edge->halfedge(1 ) = he[0];
-			}
-
-			assert( edgeVertex1(edge)->id() < edgeVertex2(edge)->id() );
-		}
-		else
-		{
-			he[0]->vertex()->boundary() = true;
-			he[0]->he_prev()->vertex()->boundary()  = true;
-		}
-
-	}
-
-	std::list<CVertex*> dangling_verts;
-	//Label boundary edges
-	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
-	{
-		CVertex *     v = *viter;
-		if( v->halfedge() != NULL ) continue;
-		dangling_verts.push_back( v );
-	}
-
-	for( std::list<CVertex*>::iterator  viter = dangling_verts.begin() ; viter != dangling_verts.end(); ++ viter )
-	{
-		CVertex * v = *viter;
-		m_verts.remove( v );
-		delete v;
-		v = NULL;
-	}
-
-	//Arrange the boundary half_edge of boundary vertices, to make its halfedge
-	//to be the most ccw in half_edge
-
-	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
-	{
-		CVertex *     v = *viter;
-		if( !v->boundary() ) continue;
-
-		CHalfEdge * he = vertexMostCcwInHalfEdge( v );
-		while( he->he_sym() != NULL )
-		{
-			he =  vertexNextCcwInHalfEdge ( he );
-		}
-		v->halfedge() = he;
-	}
-
-	//read in the traits
-
-	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
-	{
-		CVertex *     v = *viter;
-		v->_from_string();
-	}
-
-	for(std::list<CEdge*>::iterator eiter = m_edges.begin();  eiter != m_edges.end() ; ++ eiter )
-	{
-		CEdge *     e = *eiter;
-		e->_from_string();
-	}
-
-	for(std::list<CFace*>::iterator fiter = m_faces.begin();  fiter != m_faces.end() ; ++ fiter )
-	{
-		CFace *     f = *fiter;
-		f->_from_string();
-	}
-
-	for( std::list<CFace*>::iterator fiter=m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-	{
-		CFace * pF = *fiter;
-
-		CHalfEdge * pH  = faceMostCcwHalfEdge( pF );
-		do{
-			pH->_from_string();
-			pH = faceNextCcwHalfEdge( pH );
-		}while( pH != faceMostCcwHalfEdge(pF ) );
-	}
-
-};
-
-/*!
-	Write an .m file.
-	\param output the output .m file name
-	*/template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_m( const char * output )
-{
-	//write traits to string
-	for( std::list<CVertex*>::iterator viter=m_verts.begin(); viter != m_verts.end(); viter ++ )
-	{
-		CVertex * pV = *viter;
-		pV->_to_string();
-	}
-
-	for( std::list<CEdge*>::iterator eiter=m_edges.begin(); eiter != m_edges.end(); eiter ++ )
-	{
-		CEdge * pE = *eiter;
-		pE->_to_string();
-	}
-
-	for( std::list<CFace*>::iterator fiter=m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-	{
-		CFace * pF = *fiter;
-		pF->_to_string();
-	}
-
-	for( std::list<CFace*>::iterator fiter=m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-	{
-		CFace * pF = *fiter;
-		CHalfEdge * pH  = faceMostCcwHalfEdge( pF );
-		do{
-			pH->_to_string();
-			pH = faceNextCcwHalfEdge( pH );
-		}while( pH != faceMostCcwHalfEdge(pF ) );
-	}
-
-
-	std::fstream _os( output, std::fstream::out );
-	if( _os.fail() )
-	{
-		fprintf(stderr,"Error is opening file %s\n", output );
-		return;
-	}
-
-
-	//remove vertices
-  for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-  {
-		tVertex v = *viter;
-
-		_os << "Vertex " << v->id();
-		//_os << v->id();
-
-		for( int i = 0; i < 2; i ++ )
-		{
-			_os << " " << v->uv()[i];
-		}
-		if( v->string().size() > 0 )
-		{
-			_os << " " <<"{"<< v->string() << "}";
-		}
-		_os << std::endl;
-	}
-
-  for( std::list<CFace*>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-	{
-		tFace f = *fiter;
-
-		_os << "Face " << f->id();
-
-		tHalfEdge he = faceHalfedge( f );
-		do{
-			_os << " " <<  he->target()->id();
-			he = halfedgeNext( he );
-		}while( he != f->halfedge() );
-
-		if( f->string().size() > 0 )
-		{
-			_os << " " << "{"<< f->string() << "}";
-		}
-		_os << std::endl;
-	}
-
-  for( std::list<CEdge*>::iterator eiter = m_edges.begin(); eiter != m_edges.end(); eiter ++ )
-	{
-		tEdge e = *eiter;
-		
-		//if( e->string().size() > 0 )
-		//{
-			//std::cout<<"i am here!"<<std::endl;
-			_os << "Edge "<<  edgeVertex1(e)->id() <<" " << edgeVertex2(e)->id() << " ";
-			//_os << edgeVertex1(e)->id() <<" " << edgeVertex2(e)->id() << " ";
-			_os << "{" << e->string() << "}" << std::endl;
-		//}
-	}
-
-  for( std::list<CFace*>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); fiter ++  )
-	{
-		tFace f = *fiter;
-
-		tHalfEdge he = faceHalfedge( f );
-
-    do{
-  			if( he->string().size() > 0 )
-			  {
-				  _os << "Corner "<< he->vertex()->id() << " " << f->id() << " ";
-				  _os << "{" << he->string() << "}" << std::endl;
-			  }
-			  he = halfedgeNext( he );
-		}while( he != f->halfedge() );
-
-  }
-
-	_os.close();
-};
-
-
-//assume the mesh is with uv coordinates and normal vector for each vertex
-/*!
-	Write an .obj file.
-	\param output the output .obj file name
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_obj( const char * output )
-{
-	std::fstream _os( output, std::fstream::out );
-	if( _os.fail() )
-	{
-		fprintf(stderr,"Error is opening file %s\n", output );
-		return;
-	}
-
-	int vid = 1;
-	for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-	{
-		tVertex v = *viter;
-		v->id() = vid ++;
-	}
-
-	for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-	{
-		tVertex v = *viter;
-
-		_os << "v";
-		
-		for( int i = 0; i < 3; i ++ )
-		{
-			_os << " " << v->point()[i];
-		}
-		_os << std::endl;
-	}
-
-	for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-	{
-		tVertex v = *viter;
-
-		_os << "vt";
-		
-		for( int i = 0; i < 2; i ++ )
-		{
-			_os << " " << v->uv()[i];
-		}
-		_os << std::endl;
-	}
-
-	for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-	{
-		tVertex v = *viter;
-
-		_os << "vn";
-		
-		for( int i = 0; i < 3; i ++ )
-		{
-			_os << " " << v->normal()[i];
-		}
-		_os << std::endl;
-	}
-
-
-  for( std::list<CFace*>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-	{
-		tFace f = *fiter;
-
-		_os << "f";
-
-		tHalfEdge he = faceHalfedge( f );
-		
-		do{
-			int vid = he->target()->id();
-			_os << " " <<  vid << "/" << vid << "/" << vid;
-			he = halfedgeNext( he );
-		}while( he != f->halfedge() );
-		_os << std::endl;
-	}
-
-	_os.close();
-};
-
-/*!
-	Write an .off file.
-	\param output the output .off file name
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_off( const char * output )
-{
-	std::fstream _os( output, std::fstream::out );
-	if( _os.fail() )
-	{
-		fprintf(stderr,"Error is opening file %s\n", output );
-		return;
-	}
-
-	_os << "OFF" << std::endl;
-	_os << m_verts.size() << " " << m_faces.size() << " " << m_edges.size() << std::endl;
-
-
-	int vid = 0;
-	for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-	{
-		tVertex v = *viter;
-		v->id() = vid ++;
-	}
-
-	for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++)
-	{
-		tVertex v = *viter;
-		_os << v->point()[0]  << " " << v->point()[1] << " " << v->point()[2]<< std::endl;
-		//_os << v->normal()[0] << " " << v->normal()[1]<< " " << v->normal()[2]<< std::endl;
-	}
-
-
-	for( std::list<CFace*>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); fiter ++ )
-	{
-		tFace f = *fiter;
-
-		_os << "3";
-
-		tHalfEdge he = faceHalfedge( f );
-		
-		do{
-			int vid = he->target()->id();
-			_os << " " <<  vid;
-			he = halfedgeNext( he );
-		}while( he != f->halfedge() );
-		_os << std::endl;
-	}
-
-	_os.close();
-};
-
-
-//template pointer converting to base class pointer is OK (BasePointer) = (TemplatePointer)ed
-//(TemplatePointer)=(BasePointer) is incorrect
-/*! delete one face
-\param pFace the face to be deleted
-*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::deleteFace( tFace  pFace )
-{  	  
-	  std::map<int,tFace>::iterator fiter = m_map_face.find( pFace->id() );
-	  if( fiter != m_map_face.end() )
-	  {
-		  m_map_face.erase( fiter );
-	  }	
-	  m_faces.remove( pFace );
-
-		
-	 //create halfedges
-	 tHalfEdge hes[3];
-
-	 hes[0] = faceHalfedge( pFace );
-	 hes[1] = faceNextCcwHalfEdge( hes[0] );
-	 hes[2] = faceNextCcwHalfEdge( hes[1] );
-
-	 for(int i = 0; i < 3; i ++ )
-	 {
-		//connection with edge
-		CHalfEdge * pH = hes[i];
-
-		//connection to target
-		CVertex * pV = halfedgeTarget( pH );
-		if( pV->halfedge() == pH )
-		{
-			if( pH->he_next()->he_sym() != NULL )
-				pV->halfedge() = pH->he_next()->he_sym();
-			else
-			{
-
-				assert( pH->he_sym() != NULL ); //otherwise the mesh is not a manifold
-
-				pV->halfedge() = pH->he_sym()->he_prev();
-			}
-		}
-	 }
-
-		for(int i = 0; i < 3; i ++ )
-		{
-			//connection with edge
-			CHalfEdge * pH = hes[i];
-			CHalfEdge * pS = halfedgeSym( pH );
-			CEdge * pE = halfedgeEdge( pH );
-
-			pE->halfedge(0) = pS;
-			pE->halfedge(1) = NULL;
-
-			if( pS == NULL )
-			{
-				//assert(0);
-				m_edges.remove( pE );
-				CVertex * v0 = halfedgeSource( pH );
-				CVertex * v1 = halfedgeTarget( pH );
-
-				v0->edges().remove(pE);
-				v1->edges().remove(pE);
-
-				delete pE;
-			}
-
-			
-		}
-		
-		//remove half edges
-		for(int i = 0; i < 3; i ++ )
-		{
-			delete hes[i];
-		}
-		
-		delete pFace;
-};
-
-/*!
-	Read an .off file
-	\param input the input .off filename
-	*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_off( const char * input )
-{
-	std::fstream is( input, std::fstream::in );
-
-	if( is.fail() )
-	{
-		fprintf(stderr,"Error is opening file %s\n", input );
-		return;
-	}
-
-	char buffer[MAX_LINE];
-
-	//read in the first line "OFF"
-
-	while( is.getline(buffer, MAX_LINE )  )
-	{		
-		std::string line( buffer );
-	
-		strutil::Tokenizer stokenizer( line, " \r\n" );
-
-		stokenizer.nextToken();
-		std::string token = stokenizer.getToken();
-		if( token == "OFF"  || token == "NOFF" ) break;
-	}
-
-	int nVertices, nFaces, nEdges;
-
-	//read in Vertex Number, Face Number, Edge Number
-
-		is.getline(buffer, MAX_LINE );
-		std::string line( buffer );
-	
-		strutil::Tokenizer stokenizer( line, " \r\n" );
-
-		stokenizer.nextToken();
-		std::string token = stokenizer.getToken();
-		nVertices = strutil::parseString<int>( token );
-
-		stokenizer.nextToken();
-		token = stokenizer.getToken();
-		nFaces = strutil::parseString<int>( token );
-
-		stokenizer.nextToken();
-		token = stokenizer.getToken();
-		nEdges = strutil::parseString<int>( token );
-
-		//printf("V %d F %d E %d\n" , nVertices, nFaces, nEdges);
-	
-
-	for( int id = 0; id < nVertices; id ++ )
-	{
-		is.getline(buffer, MAX_LINE );
-		std::string line( buffer );
-		
-		strutil::Tokenizer stokenizer( line, " \r\n" );
-		CPoint p;
-		for( int j = 0; j < 3; j ++ )
-		{
-			stokenizer.nextToken();
-			std::string token = stokenizer.getToken();
-			p[j] = strutil::parseString<float>( token );
-		}
-
-			CVertex * v = createVertex( id + 1 );
-			v->point() = p;
-	}
-
-
-	for( int id = 0; id < nFaces; id ++ )
-	{
-
-		is.getline(buffer, MAX_LINE );
-		std::string line( buffer );
-		
-		strutil::Tokenizer stokenizer( line, " \r\n" );
-		stokenizer.nextToken();
-		std::string token = stokenizer.getToken();
-		
-		int n = strutil::parseString<int>(token);
-		assert( n == 3 );
-
-		CVertex * v[3];
-		for( int j = 0; j < 3; j ++ )
-		{
-			stokenizer.nextToken();
-			std::string token = stokenizer.getToken();
-			int vid = strutil::parseString<int>( token );
-			v[j] = idVertex( vid + 1);
-		}
-		
-		createFace( v, id + 1 );
-	}
-
-	is.close();
-
-	labelBoundary();
-
-};
-
-
-/*!
-	Label boundary edges, vertices
-*/
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::labelBoundary( void )
-{
-	
-	//Label boundary edges
-	for(std::list<CEdge*>::iterator eiter= m_edges.begin() ; eiter != m_edges.end() ; ++ eiter )
-	{
-		CEdge *     edge = *eiter;
-		CHalfEdge * he[2];
-
-		he[0] = (CHalfEdge*)edge->halfedge(0);
-		he[1] = (CHalfEdge*)edge->halfedge(1);
-		
-		assert( he[0] != NULL );
-		
-
-		if( he[1] != NULL )
-		{
-			assert( he[0]->target() == he[1]->source() && he[0]->source() == he[1]->target() );
-
-			if( he[0]->target()->id() < he[0]->source()->id() )
-			{
-				edge->halfedge(0 ) = he[1];
-				edge->halfedge(1 ) = he[0];
-			}
-
-			assert( edgeVertex1(edge)->id() < edgeVertex2(edge)->id() );
-		}
-		else
-		{
-			he[0]->vertex()->boundary() = true;
-			he[0]->he_prev()->vertex()->boundary()  = true;
-		}
-
-	}
-
-	std::list<CVertex*> dangling_verts;
-	//Label boundary edges
-	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
-	{
-		tVertex     v = *viter;
-		if( v->halfedge() != NULL ) continue;
-		dangling_verts.push_back( v );
-	}
-
-	for( std::list<CVertex*>::iterator  viter = dangling_verts.begin() ; viter != dangling_verts.end(); ++ viter )
-	{
-		tVertex v = *viter;
-		m_verts.remove( v );
-		delete v;
-		v = NULL;
-	}
-
-	//Arrange the boundary half_edge of boundary vertices, to make its halfedge
-	//to be the most ccw in half_edge
-
-	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
-	{
-		tVertex     v = *viter;
-		if( !v->boundary() ) continue;
-
-		CHalfEdge * he = (CHalfEdge*)v->halfedge();
-		while( he->he_sym() != NULL )
-		{
-			he = (CHalfEdge*)he->ccw_rotate_about_target();
-		}
-		v->halfedge() = he;
-	}
-
-
-};
-
-/*! Create a face
-	\param v an array of vertices
-	\param id face id
-	\return pointer to the new face
-	*/
-
-template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
-CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createFace( std::vector<tVertex> &  v, int id )
-{
-	  CFace * f = new CFace();
-	  assert( f != NULL );
-	  f->id() = id;
-	  m_faces.push_back( f );
-	  m_map_face.insert( std::pair<int,tFace>(id,f) );
-
-		//create halfedges
-	  std::vector<tHalfEdge> hes;
-
-		for(size_t i = 0; i < v.size(); i ++ )
-		{
-			tHalfEdge pH = new CHalfEdge;
-			assert( pH );
-			CVertex * vert =  v[i];
-			pH->vertex() = vert;
-			vert->halfedge() = pH;
-			hes.push_back( pH );
-		}
-
-		//linking to each other
-		for( size_t i = 0; i < hes.size(); i ++ )
-		{
-			hes[i]->he_next() = hes[(i+1)%hes.size()];
-			hes[i]->he_prev() = hes[(i+hes.size()-1)%hes.size()];
-		}
-
-		//linking to face
-		for(size_t i = 0; i < hes.size(); i ++ )
-		{
-			hes[i]->face()   = f;
-			f->halfedge()    = hes[i];
-		}
-
-		//connecting with edge
-		for( size_t i = 0; i < hes.size(); i ++ )
-		{
-			tEdge e = createEdge( v[i], v[(i+hes.size()-1)%hes.size()] );
-			if( e->halfedge(0)  == NULL )
-			{
-				e->halfedge(0) = hes[i];
-			}
-			else
-			{
-				assert( e->halfedge(1) == NULL );
-				if( e->halfedge(1) != NULL )
-				{
-					std::cout << "Illegal Face Construction " << id << std::endl;
-				}
-				e->halfedge(1) = hes[i];
-			}
-			hes[i]->edge() = e;
-		}
-
-		return f;
-};
-
-
-}//name space MeshLib
-
-#endif //_MESHLIB_BASE_MESH_H_ defined
+/*!
+*      \file BaseMesh.h
+*      \brief Base Mesh Class for all types of Mesh Classes
+*
+*		This is the fundamental class for meshes
+*	   \author David Gu
+*      \date 10/07/2010
+*
+*/
+
+#ifndef _MESHLIB_BASE_MESH_H_
+#define _MESHLIB_BASE_MESH_H_
+
+#define MAX_LINE 2048
+
+#include <math.h>
+#include <assert.h>
+#include <iostream>
+#include <fstream>
+#include <list>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <unordered_map>
+
+#include "../Geometry/Point.h"
+#include "../Geometry/Point2.h"
+#include "../Parser/StrUtil.h"
+#include "../Parser/MappedFile.h"
+#include "../Parser/TextScanner.h"
+#include "../Parser/MChunk.h"
+#include "../Parser/TextWriter.h"
+#include "Vertex.h"
+#include "Edge.h"
+#include "Face.h"
+#include "HalfEdge.h"
+#include "TraitTable.h"
+#include "BinaryMesh.h"
+#include "PlyFormat.h"
+#include "CompressedMesh.h"
+#include "../Parallel/RadixSort.h"
+
+namespace MeshLib{
+
+/*!
+* \brief CBaseMesh, base class for all types of mesh classes
+*
+*  This is the fundamental class for meshes. It includes a list of vertices,
+*  a list of edges, a list of faces. All the geometric objects are connected by pointers,
+*  vertex, edge, face are connected by halfedges. The mesh class has file IO functionalities,
+*  supporting .obj, .m and .off file formats. It offers Euler operators, each geometric primative
+*  can access its neighbors freely. 
+*  
+* \tparam CVertex   vertex   class, derived from MeshLib::CVertex   class
+* \tparam CEdge     edge     class, derived from MeshLib::CEdge     class
+* \tparam CFace     face     class, derived from MeshLib::CFace     class
+* \tparam CHalfEdge halfedge class, derived from MeshLib::CHalfEdge class
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+class CBaseMesh
+{
+public:
+	// pointer to Vertices, Halfedges, Edges, Face and Solid
+	typedef CVertex   * tVertex;
+	typedef CHalfEdge * tHalfEdge;
+	typedef CEdge     * tEdge;
+	typedef CFace     * tFace;
+
+	//constructor and destructor
+	/*!
+	CBaseMesh constructor.
+	*/
+	CBaseMesh() : m_topology_version( 0 ) {};
+	/*!
+	CBasemesh destructor
+	*/
+	~CBaseMesh();
+
+	//copy operator
+	/*!
+	Copy operator
+	*/
+	void copy( CBaseMesh & mesh );
+
+	/*!
+	Renumber and relocate the mesh elements for memory locality. The vertices are ordered
+	along a Morton curve of their positions ( uv coordinates for planar meshes ), the faces
+	by their first vertex, the edges and halfedges follow the faces. All elements are
+	reallocated in the new order and the ids become 1,2,..., consistently for write_m.
+	*/
+	void compact_and_reorder();
+
+	//file io
+	/*!
+	Read an .obj file.
+	\param filename the input .obj file name
+	*/
+	void read_obj(  const char * filename );
+	/*!
+	Write an .obj file.
+	\param output the output .obj file name
+	\param nthreads number of chunks formatted in parallel, 0 for one per thread of CThreadPool, 1 for none
+	*/
+	void write_obj( const char * output, int nthreads = 0 );
+
+	/*!
+	Read an .m file.
+	\param input the input obj file name
+	*/
+	void read_m(  const char * input );
+	/*!
+	Write an .m file.
+	\param output the output .m file name
+	\param nthreads number of chunks formatted in parallel, 0 for one per thread of CThreadPool, 1 for none
+	*/
+	void write_m( const char * output, int nthreads = 0 );
+	
+	/*!
+	Read an .off file
+	\param input the input .off filename
+	*/
+	void read_off( const char * input );
+	/*!
+	Write an .off file.
+	\param output the output .off file name
+	\param nthreads number of chunks formatted in parallel, 0 for one per thread of CThreadPool, 1 for none
+	*/
+	void write_off( const char * output, int nthreads = 0 );
+
+	/*!
+	Read an .mb file, see CBinaryMesh. The file is mapped, the vertices and faces are
+	created directly from its blocks, and the precomputed opposites replace the pairing
+	sort of build(). Attribute columns are read into elements with matching attributes.
+	A corner naming a vertex outside the file fails the read, before any element is created.
+	\param input the input .mb file name
+	\return whether the file could be read
+	*/
+	bool read_mb( const char * input );
+	/*!
+	Write an .mb file, all faces must be triangles. Point and uv blocks are written when
+	they are used by any vertex, attribute columns are written for the vertices, faces and
+	halfedges ( in corner order ).
+	\param output the output .mb file name
+	\return whether the file was written and flushed
+	*/
+	bool write_mb( const char * output );
+
+	/*!
+	Read a binary little endian .ply file. The records are mapped and their properties are
+	stored directly into the elements: x,y,z into the point, u,v ( or s,t ) into the uv,
+	nx,ny,nz into the normal, other vertex and face properties into the attributes of the
+	same name ( key, or key_x,key_y,key_z for vectors ). Other elements are skipped.
+	\param input the input .ply file name
+	*/
+	void read_ply( const char * input );
+	/*!
+	Write a binary little endian .ply file, with x,y,z, the uv and normal when they are used
+	by any vertex, the vertex and face attributes, and the faces as vertex_indices lists.
+	The list lengths are uchar, or uint if a face has more than 255 vertices.
+	\param output the output .ply file name
+	*/
+	void write_ply( const char * output );
+
+	/*!
+	Read an .mc file, see CCompressedMesh. The vertices get the ids 1,2,... in the order of
+	the file, and the decoded opposites replace the pairing sort of build(). A truncated or
+	damaged file fails the read, before any element is created.
+	\param input the input .mc file name
+	\return whether the file could be read
+	*/
+	bool read_mc( const char * input );
+	/*!
+	Write an .mc file, all faces must be triangles. The connectivity is compressed by
+	CEdgebreaker, the points and the uv ( when they are used by any vertex ) are quantized
+	to the given number of bits in their bounding box. Ids, normals and attributes are not
+	kept, vertices without faces are dropped.
+	\param output the output .mc file name
+	\param bits bits per quantized coordinate, 1..30
+	*/
+	void write_mc( const char * output, int bits = 16 );
+
+	//number of vertices, faces, edges
+	/*! number of vertices */
+	int  numVertices();
+	/*! number of edges */
+	int  numEdges();
+	/*! number of faces */
+	int  numFaces();
+
+	//is boundary
+	/*! whether a vertex is on the boundary
+	\param v the pointer to the vertex
+	*/
+	bool    isBoundary( tVertex  v );
+	/*! whether an edge is on the boundary
+	\param e the pointer to the edge
+	*/
+	bool    isBoundary( tEdge    e );
+	/*! whether a halfedge is on the boundary
+	\param he the pointer to the halfedge
+	*/
+	bool    isBoundary( tHalfEdge  he );
+
+	//acess vertex - id
+	/*!
+	Access a vertex by its id
+	\param id the vertex id
+	\return the vertex, whose ID equals to id. NULL, if there is no such a vertex.
+	*/
+	tVertex idVertex( int id );
+	/*!
+	The vertex id
+	\param v the input vertex
+	\return the vertex id.
+	*/
+	int     vertexId( tVertex  v );
+
+	//access face - id
+	/*!
+	Access a face by its id
+	\param id the face id
+	\return the face, whose ID equals to id. NULL, if there is no such a face.
+	*/
+	tFace   idFace( int id );
+	/*!
+	The face id
+	\param f the input face
+	\return the face id.
+	*/
+	int     faceId( tFace  f );
+
+	//access edge - edge key, vertex
+	/*!
+	Access an edge by its two end vertices
+	\param v0 one vertex of the edge
+	\param v1 the other vertex of the edge
+	\return the edge connecting both v0 and v1, NULL if no such edge exists.
+	*/
+	tEdge   vertexEdge( tVertex v0, tVertex v1 );
+
+	//access halfedge - halfedge key, vertex
+	/*!
+	Access a halfedge by its two end vertices
+	\param v0 one vertex of the halfedge
+	\param v1 the other vertex of the halfedge
+	\return the halfedge connecting both v0 and v1, NULL if no such edge exists.
+	*/
+	
+	tHalfEdge   vertexHalfedge( tVertex v0, tVertex v1 );
+	/*!
+	Access a halfedge by its target vertex, and attaching face.
+	\param v target vertex 
+	\param f attaching face
+	\return halfedge, whose target is v, attaching face is f. NULL if no such an halfedge exists.
+	*/
+	tHalfEdge   corner( tVertex v, tFace f);
+
+	//halfedge->face
+	/*!
+	The face a halfedge attaching to. 
+	\param he the input halfedge
+	\return the face he attaches
+	*/
+	tFace   halfedgeFace( tHalfEdge he );
+	//halfedge->vertex
+	/*!
+	The target vertex of a halfedge. 
+	\param he the input halfedge.
+	\return the target vertex of he.
+	*/
+	tVertex halfedgeVertex( tHalfEdge he );
+	//halfedge->vertex
+	/*!
+	The target vertex of a halfedge. 
+	\param he the input halfedge.
+	\return the target vertex of he.
+	*/
+	tVertex halfedgeTarget( tHalfEdge he );
+	//halfedge->vertex
+	/*!
+	The source vertex of a halfedge. 
+	\param he the input halfedge.
+	\return the source vertex of he.
+	*/
+	tVertex halfedgeSource( tHalfEdge he );
+
+	//halfedge->next
+	/*!
+	The next halfedge of a halfedge. 
+	\param he the input halfedge.
+	\return the next halfedge of he.
+	*/
+
+	tHalfEdge   halfedgeNext( tHalfEdge he );
+	//halfedge->prev
+	/*!
+	The previous halfedge of a halfedge. 
+	\param he the input halfedge.
+	\return the next halfedge of he.
+	*/
+	tHalfEdge   halfedgePrev( tHalfEdge he );
+	//halfedge->sym
+	/*!
+	The dual halfedge of a halfedge. 
+	\param he the input halfedge.
+	\return the dual halfedge of he.
+	*/
+	tHalfEdge   halfedgeSym( tHalfEdge he );
+	//halfedge->edge
+	/*!
+	The edge of a halfedge. 
+	\param he the input halfedge.
+	\return the edge of he.
+	*/
+
+	tEdge       halfedgeEdge( tHalfEdge he );
+	//v->halfedge
+	/*!
+	The halfedge targeting at a vertex. 
+	\param v the input vertex.
+	\return the halfedge targeting at v, which is the most ccw in halfedge of v.
+	*/
+	tHalfEdge   vertexHalfedge( tVertex v );
+	//v->edges
+	/*!
+	The edge list attaching to the vertex v, such that v is the first vertex of the edge
+	\param v the input vertex.
+	\return the reference to the edge list
+	*/
+	std::list<tEdge> &  vertexEdges( tVertex v );
+
+	//edge->vertex
+	/*!
+	The first vertex of an edge.
+	\param e the input edge.
+	\return the first vertex of e.
+	*/
+	tVertex edgeVertex1( tEdge  e );
+	/*!
+	The second vertex of an edge.
+	\param e the input edge.
+	\return the second vertex of e.
+	*/
+	tVertex edgeVertex2( tEdge  e );
+
+	//edge->face
+	/*!
+	The first face attaching to an edge.
+	\param e the input edge.
+	\return the first face attaching to e.
+	*/
+	tFace edgeFace1( tEdge  e );
+	/*!
+	The second face attaching to an edge.
+	\param e the input edge.
+	\return the second face attaching to e.
+	*/
+	tFace edgeFace2( tEdge  e );
+
+	//edge->halfedge
+	/*!
+	The halfedge attaching to an edge.
+	\param e the input edge.
+	\param id the index of the halfedge, either 0 or 1
+	\return the halfedge[i] attaching to edge e.
+	*/
+
+	tHalfEdge edgeHalfedge( tEdge  e, int id);
+
+	//face->halfedge
+	/*!
+	The first halfedge attaching to a face f.
+	\param f the input face.
+	\return the first halfedge attaching to f.
+	*/
+
+	tHalfEdge faceHalfedge( tFace f );
+	/*!
+	The three halfedges of a triangle f, starting from faceHalfedge( f ), ccwly.
+	\param f the input face.
+	\return the halfedges, no heap allocation.
+	*/
+	std::array<tHalfEdge,3> faceHalfedges( tFace f );
+	/*!
+	The three vertices of a triangle f, the targets of faceHalfedges( f ), in the order of FaceVertexIterator.
+	\param f the input face.
+	\return the vertices, no heap allocation.
+	*/
+	std::array<tVertex,3>   faceVertices( tFace f );
+
+	//Euler operations
+	/*!
+	The most Clw Out HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Clw Out HalfEdge of v.
+	*/
+	tHalfEdge vertexMostClwOutHalfEdge( tVertex  v );
+	/*!
+	The next Ccw Out HalfEdge 
+	\param he the input halfedge .
+	\return the next Ccw Out HalfEdge, sharing the same source of he.
+	*/
+
+	tHalfEdge vertexNextCcwOutHalfEdge( tHalfEdge  he );
+
+	/*!
+	The most Ccw Out HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Ccw Out HalfEdge of v.
+	*/
+	tHalfEdge vertexMostCcwOutHalfEdge( tVertex  v );
+	/*!
+	The next Clw Out HalfEdge 
+	\param he the input halfedge .
+	\return the next Clw Out HalfEdge, sharing the same source of he.
+	*/
+	tHalfEdge vertexNextClwOutHalfEdge( tHalfEdge  he );
+
+	/*!
+	The most Clw In HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Clw In HalfEdge of v.
+	*/
+	tHalfEdge vertexMostClwInHalfEdge( tVertex  v );
+	/*!
+	The next Ccw In HalfEdge 
+	\param he the input halfedge .
+	\return the next Ccw In HalfEdge, sharing the same target of he.
+	*/
+	tHalfEdge vertexNextCcwInHalfEdge( tHalfEdge  he );
+
+	/*!
+	The most Ccw In HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Ccw In HalfEdge of v.
+	*/
+	tHalfEdge vertexMostCcwInHalfEdge( tVertex  v );
+	/*!
+	The next Clw In HalfEdge 
+	\param he the input halfedge .
+	\return the next Clw In HalfEdge, sharing the same target of he.
+	*/
+	tHalfEdge vertexNextClwInHalfEdge( tHalfEdge  he );
+
+	/*!
+	The most Clw HalfEdge of a face
+	\param face the input face.
+	\return the most Clw HalfEdge of f.
+	*/
+	
+	tHalfEdge faceMostClwHalfEdge( tFace  face );
+	/*!
+	The most Ccw HalfEdge of a face
+	\param face the input face.
+	\return the most Ccw HalfEdge of f.
+	*/
+	tHalfEdge faceMostCcwHalfEdge( tFace  face );
+	/*!
+	The next Ccw HalfEdge of a halfedge in a face
+	\param he the input halfedge.
+	\return the next Ccw HalfEdge of he in a face.
+	*/
+	tHalfEdge faceNextCcwHalfEdge( tHalfEdge  he );
+	/*!
+	The next Clw HalfEdge of a halfedge in a face
+	\param he the input halfedge.
+	\return the next Clw HalfEdge of he in a face.
+	*/
+	tHalfEdge faceNextClwHalfEdge( tHalfEdge  he );
+
+
+	/*!
+	Edge length
+	\param e the input edge
+	\return the length of the edge e
+	*/
+	double edgeLength( tEdge e );
+
+	/*!
+	List of the edges of the mesh.
+	*/
+	std::list<tEdge>   & edges()		{ return m_edges; };
+	/*!
+	List of the faces of the mesh.
+	*/
+	std::list<tFace>   & faces()		{ return m_faces; };
+	/*!
+	List of the vertices of the mesh.
+	*/
+	std::list<tVertex> & vertices()	{ return m_verts; };
+	/*!
+	Counter of the topology changes, incremented whenever elements are created or deleted,
+	the boundary is relabeled or the elements are reallocated. Caches of the connectivity,
+	see COneRing, compare it to find out whether they are stale.
+	*/
+	unsigned int topologyVersion() { return m_topology_version; };
+/*
+	bool with_uv() { return m_with_texture; };
+	bool with_normal() { return m_with_normal; };
+*/
+protected:
+
+  /*! list of edges */
+  std::list<tEdge>                          m_edges;
+  /*! list of vertices */
+  std::list<tVertex>                        m_verts;
+  /*! list of faces */
+  std::list<tFace>							m_faces;
+
+  //maps
+
+  /*! map between vetex and its id*/
+  std::map<int, tVertex>                    m_map_vert;
+  /*! map between face and its id*/
+  std::map<int, tFace>						m_map_face;
+  /*! number of topology changes, see topologyVersion() */
+  unsigned int                              m_topology_version;
+
+
+public:
+	/*! Create a vertex 
+	\param id Vertex id
+	\return pointer to the new vertex
+	*/
+	tVertex   createVertex(   int id = 0 );
+	/*! Create an edge
+	\param v1 end vertex of the edge
+	\param v2 end vertex of the edge
+	\return pointer to the new edge
+	*/
+	tEdge     createEdge(	tVertex v1, tVertex v2 );
+	/*! Create a face
+	\param v an array of vertices
+	\param id face id
+	\return pointer to the new face
+	*/
+	tFace     createFace(   tVertex  v[], int id ); //create a triangle
+	/*! Create a face
+	\param v an array of vertices
+	\param id face id
+	\return pointer to the new face
+	*/
+	tFace     createFace(   std::vector<tVertex> &  v, int id ); //create a triangle
+	/*! Create a triangle, without building a vertex array
+	\param v0,v1,v2 vertices of the triangle, ccw oriented
+	\param id face id
+	\return pointer to the new face
+	*/
+	tFace     createTriangle( tVertex v0, tVertex v1, tVertex v2, int id );
+	/*! Build all the triangles at once, the vertices must exist already.
+	The halfedges are paired by a radix sort of their vertex pairs instead of the per vertex
+	edge lists of createEdge, boundaries are labeled in the same sweep and dangling vertices
+	are removed, as labelBoundary does.
+	\param faces    vertex ids of every triangle, ccw oriented
+	\param face_ids ids of the faces, 1,2,... if empty
+	\param opposites optional, the opposite corner of every corner ( corner 3f+i is faces[f][i] ),
+	-1 on the boundary, as stored in .mb files; replaces the sort when it is consistent
+	*/
+	void      build( const std::vector< std::array<int,3> > & faces, const std::vector<int> & face_ids, const int * opposites = NULL );
+
+	/*! delete one face
+	\param pFace the face to be deleted
+	*/
+	void      deleteFace( tFace  pFace );
+	/*! Delete all the faces, edges and halfedges. The vertices are kept, without halfedge,
+	edges and boundary flag, such that build can create other faces on them.
+	*/
+	void      deleteFaces();
+	
+	/*! whether the vertex is with texture coordinates */
+	bool      m_with_texture;
+	/*! whether the mesh is with normal */
+	bool      m_with_normal;
+
+	/*! label boundary vertices, edges, faces */
+	void labelBoundary( void );
+
+	/*! Create the edge of halfedge he and its twin, NULL on the boundary, used by build. */
+	void      _link_edge( tHalfEdge he, tHalfEdge twin );
+	/*! The corner table of the triangles, in the layout of build, used by write_mb and write_mc.
+	\param vertex_index index of every vertex
+	\param faces the faces
+	\param hes the halfedge of every corner, corner next(c) faces halfedge c
+	\param corners the vertex index of every corner
+	\param opposites the opposite corner of every corner, -1 on the boundary
+	\param output name of the file written, for the error message
+	\return false if a face is not a triangle
+	*/
+	bool      _corner_table( std::unordered_map<tVertex,int> & vertex_index, const std::vector<tFace> & faces,
+		std::vector<tHalfEdge> & hes, std::vector<int> & corners, std::vector<int> & opposites, const char * output );
+};
+
+
+
+/*!
+The first vertex of an edge.
+\param e the input edge.
+\return the first vertex of e.
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeVertex1( tEdge   e )
+{
+	assert( e->halfedge(0 ) != NULL );
+	return (CVertex*)e->halfedge(0)->source();
+};
+
+/*!
+The second vertex of an edge.
+\param e the input edge.
+\return the first vertex of e.
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CVertex *  CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeVertex2( tEdge   e )
+{
+	assert( e->halfedge(0 ) != NULL );
+	return (CVertex*)e->halfedge(0)->target();
+};
+
+/*!
+The first face attaching to an edge.
+\param e the input edge.
+\return the first face attaching to e.
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeFace1( tEdge   e )
+{
+	assert( e->halfedge(0) != NULL );
+	return (CFace*) e->halfedge(0)->face();
+};
+
+//access he->f
+/*!
+The halfedge attaching to an edge.
+\param e the input edge.
+\param id the index of the halfedge, either 0 or 1
+\return the halfedge[i] attaching to edge e.
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeHalfedge( tEdge   e, int id )
+{
+	return (CHalfEdge*)e->halfedge(id);
+};
+
+//access e->f
+/*!
+The second face attaching to an edge.
+\param e the input edge.
+\return the first face attaching to e.
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeFace2( tEdge   e )
+{
+	assert( e->halfedge(1) != NULL );
+	return (CFace*) e->halfedge(1)->face();
+};
+
+//access he->f
+/*!
+	The face a halfedge attaching to. 
+	\param he the input halfedge
+	\return the face he attaches
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeFace( tHalfEdge   he )
+{
+	return (CFace*)he->face();
+};
+
+//access f->he
+	/*!
+	The first halfedge attaching to a face f.
+	\param f the input face.
+	\return the first halfedge attaching to f.
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceHalfedge( tFace   f )
+{
+	return (CHalfEdge*)f->halfedge();
+};
+
+//access f->{he}
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline std::array<CHalfEdge*,3> CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceHalfedges( tFace   f )
+{
+	tHalfEdge he = (CHalfEdge*)f->halfedge();
+	std::array<tHalfEdge,3> hes = {{ he, (CHalfEdge*)he->he_next(), (CHalfEdge*)he->he_prev() }};
+	return hes;
+};
+
+//access f->{v}
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline std::array<CVertex*,3> CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceVertices( tFace   f )
+{
+	tHalfEdge he = (CHalfEdge*)f->halfedge();
+	std::array<tVertex,3> vs = {{ (CVertex*)he->target(), (CVertex*)he->he_next()->target(), (CVertex*)he->he_prev()->target() }};
+	return vs;
+};
+
+
+//access he->next
+/*!
+	The next halfedge of a halfedge. 
+	\param he the input halfedge.
+	\return the next halfedge of he.
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeNext( tHalfEdge   he )
+{
+	return (CHalfEdge*)he->he_next();
+};
+
+//access he->prev
+/*!
+	The previous halfedge of a halfedge. 
+	\param he the input halfedge.
+	\return the next halfedge of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgePrev( tHalfEdge  he )
+{
+	return (CHalfEdge*)he->he_prev();
+};
+
+//access he->sym
+/*!
+	The dual halfedge of a halfedge. 
+	\param he the input halfedge.
+	\return the dual halfedge of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeSym( tHalfEdge   he )
+{
+	return (CHalfEdge*)he->he_sym();
+};
+
+//access he->edge
+/*!
+	The edge of a halfedge. 
+	\param he the input halfedge.
+	\return the edge of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeEdge( tHalfEdge  he )
+{
+	return (CEdge*)he->edge();
+};
+
+//access he->v
+/*!
+	The target vertex of a halfedge. 
+	\param he the input halfedge.
+	\return the target vertex of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeVertex( tHalfEdge  he )
+{
+	return (CVertex*)he->vertex();
+};
+
+//access he->v
+/*!
+	The target vertex of a halfedge. 
+	\param he the input halfedge.
+	\return the target vertex of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeTarget( tHalfEdge   he )
+{
+	return (CVertex*)he->vertex();
+};
+
+//access he->v
+/*!
+	The source vertex of a halfedge. 
+	\param he the input halfedge.
+	\return the source vertex of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::halfedgeSource( tHalfEdge   he )
+{
+	return (CVertex*)he->he_prev()->vertex();
+};
+/*! whether a vertex is on the boundary
+	\param v the pointer to the vertex
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::isBoundary( tVertex   v )
+{
+	return v->boundary();
+};
+/*! whether an edge is on the boundary
+	\param e the pointer to the edge
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::isBoundary( tEdge   e )
+{
+	if( e->halfedge(0) == NULL || e->halfedge(1) == NULL ) return true;
+	return false;
+};
+/*! whether a halfedge is on the boundary
+	\param he the pointer to the halfedge
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::isBoundary( tHalfEdge   he )
+{
+	if( he->he_sym() == NULL ) return true;
+	return false;
+};
+
+/*! Number of vertices of the mesh
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::numVertices() 
+{
+	return (int) m_verts.size();
+};
+
+/*! Number of edges of the mesh
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::numEdges() 
+{
+	return (int) m_edges.size();
+};
+
+/*! Number of faces of the mesh
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::numFaces() 
+{
+	return (int) m_faces.size();
+};
+
+
+//Euler operation
+/*!
+	The most Clw Out HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Clw Out HalfEdge of v.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge *  CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostClwOutHalfEdge( tVertex   v )
+{
+	return (CHalfEdge*)v->most_clw_out_halfedge();
+};
+/*!
+	The next Ccw Out HalfEdge 
+	\param v the input vertex.
+	\return the next Ccw Out HalfEdge, sharing the same source of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostCcwOutHalfEdge( tVertex   v )
+{
+	return (CHalfEdge*)v->most_ccw_out_halfedge();
+};
+
+/*!
+	Access a halfedge by its target vertex, and attaching face.
+	\param v target vertex 
+	\param f attaching face
+	\return halfedge, whose target is v, attaching face is f. NULL if no such an halfedge exists.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::corner( tVertex  v, tFace  f)
+{
+	CHalfEdge * he = faceMostCcwHalfEdge( f );
+	do{
+		if( he->vertex() == v )
+			return (CHalfEdge*) he;
+		he = faceNextCcwHalfEdge( he );
+	}while( he != faceMostCcwHalfEdge(f) );
+	return NULL;
+};
+/*!
+	The next Ccw Out HalfEdge 
+	\param he the input halfedge .
+	\return the next Ccw Out HalfEdge, sharing the same source of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextCcwOutHalfEdge( tHalfEdge  he )
+{
+	return (CHalfEdge*) he->ccw_rotate_about_source();
+};
+/*!
+	The next Clw Out HalfEdge 
+	\param he the input halfedge .
+	\return the next Clw Out HalfEdge, sharing the same source of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextClwOutHalfEdge( tHalfEdge   he )
+{
+	assert( he->he_sym() != NULL );
+	return (CHalfEdge*)he->clw_rotate_about_source();
+};
+	/*!
+	The most Clw In HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Clw In HalfEdge of v.
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostClwInHalfEdge( tVertex   v )
+{
+	return (CHalfEdge*)v->most_clw_in_halfedge();
+};
+	/*!
+	The most Ccw In HalfEdge of a vertex
+	\param v the input vertex.
+	\return the most Clw In HalfEdge of v.
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexMostCcwInHalfEdge( tVertex   v )
+{
+	return (CHalfEdge*)v->most_ccw_in_halfedge();
+};
+
+	/*!
+	The next Ccw In HalfEdge 
+	\param he the input halfedge .
+	\return the next Ccw In HalfEdge, sharing the same target of he.
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextCcwInHalfEdge( tHalfEdge   he )
+{
+	assert( he->he_sym() != NULL );
+	return (CHalfEdge*)he->ccw_rotate_about_target();
+};
+/*!
+	The next Clw In HalfEdge 
+	\param he the input halfedge .
+	\return the next Clw In HalfEdge, sharing the same target of he.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexNextClwInHalfEdge( tHalfEdge   he )
+{
+	return (CHalfEdge*)he->clw_rotate_about_target();
+};
+/*!
+	The next Clw HalfEdge of a halfedge in a face
+	\param he the input halfedge.
+	\return the next Clw HalfEdge of he in a face.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceNextClwHalfEdge( tHalfEdge   he )
+{
+	return (CHalfEdge*)he->he_prev();
+};
+/*!
+	The next Ccw HalfEdge of a halfedge in a face
+	\param he the input halfedge.
+	\return the next Ccw HalfEdge of he in a face.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceNextCcwHalfEdge( tHalfEdge   he )
+{
+	return (CHalfEdge*)he->he_next();
+};
+
+/*!
+	The most Ccw HalfEdge of a face
+	\param face the input face.
+	\return the most Ccw HalfEdge of f.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge *  CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceMostCcwHalfEdge( tFace   face )
+{
+	return (CHalfEdge*)face->halfedge();
+};
+/*!
+	The most Clw HalfEdge in a face
+	\param face the input face.
+	\return the most Clw HalfEdge in a face.
+	*/template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceMostClwHalfEdge( tFace   face )
+{
+	return (CHalfEdge*)face->halfedge()->he_next();
+};
+/*!
+ CBaseMesh destructor
+ */
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::~CBaseMesh()
+{
+	//remove vertices
+
+  for( std::list<CVertex*>::iterator viter = m_verts.begin(); viter != m_verts.end(); viter ++ )
+  {
+      CVertex * pV = *viter;
+      delete pV;
+  }
+  m_verts.clear();
+
+	//remove faces
+
+  for( std::list<CFace*>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); fiter ++ )
+  {
+      CFace * pF = *fiter;
+
+      tHalfEdge he = faceHalfedge( pF );
+ 
+      std::list<CHalfEdge*> hes;
+      do{
+        he = halfedgeNext( he );
+        hes.push_back( he );
+      }while( he != pF->halfedge() );
+
+      for( std::list<CHalfEdge*>::iterator hiter = hes.begin(); hiter != hes.end(); hiter ++)
+      {
+          CHalfEdge * pH = *hiter;
+          delete pH;
+      }
+      hes.clear();
+
+      delete pF;
+  }
+  m_faces.clear();
+	
+  //remove edges
+  for( std::list<CEdge*>::iterator eiter = m_edges.begin(); eiter != m_edges.end(); eiter ++ )
+  {
+      CEdge * pE = *eiter;
+      delete pE;
+  }
+
+  m_edges.clear();
+	
+  //clear all the maps
+  m_map_vert.clear();
+  m_map_face.clear();
+  //m_map_edge.clear();
+};
+
+/*!
+	Edge length
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+double CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::edgeLength( tEdge  e )
+{
+	CVertex * v1 = edgeVertex1(e);
+	CVertex * v2 = edgeVertex2(e);
+
+	return ( v1->point() - v2->point() ).norm();
+}
+
+
+//create new gemetric simplexes
+/*! Create a vertex 
+\param id Vertex id
+\return pointer to the new vertex
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createVertex( int id )
+{
+	m_topology_version ++;
+	CVertex * v = new CVertex();
+	assert( v != NULL );
+	v->id() = id;
+	m_verts.push_back( v );
+	m_map_vert.insert( std::pair<int,CVertex*>(id,v));
+	return v;
+};
+
+
+/*!
+Read an .obj file.
+\param filename the filename .obj file name
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_obj( const char * filename )
+{
+	std::fstream f(filename, std::fstream::in);
+	if( f.fail() ) return;
+
+	char cmd[1024];
+
+	int  vid = 1;
+	
+	bool with_uv = false;
+	bool with_normal = false;
+
+	std::vector<CPoint2> uvs;
+	std::vector<CPoint> normals;
+	std::vector< std::array<int,3> > faces;
+
+
+	while ( f.getline( cmd, 1024) )
+    {
+		std::string line( cmd );
+		line = strutil::trim( line );
+
+		strutil::Tokenizer stokenizer( line, " \t\r\n" );
+
+		stokenizer.nextToken();
+		std::string token = stokenizer.getToken();
+		
+		if( token == "v" )
+		{
+			CPoint p;
+			for( int i = 0; i < 3; i ++ )
+			{
+				stokenizer.nextToken();
+				token = stokenizer.getToken();
+				p[i] = strutil::parseString<float>(token);
+			}
+			
+			CVertex * v = createVertex( vid);
+			v->point() = p;
+			vid ++;
+			continue;
+		}
+
+
+		if( token == "vt" )
+		{
+			with_uv = true;
+			CPoint2 uv;
+			for( int i = 0; i < 2; i ++ )
+			{
+				stokenizer.nextToken();
+				token = stokenizer.getToken();
+				uv[i] = strutil::parseString<float>(token);
+			}
+			uvs.push_back( uv );
+			continue;
+		}
+
+
+		if ( token ==  "vn" )
+		{
+			with_normal = true;
+
+			CPoint n;
+			for( int i = 0; i < 3; i ++ )
+			{
+				stokenizer.nextToken();
+				token = stokenizer.getToken();
+				n[i] = strutil::parseString<float>(token);
+			}
+			normals.push_back( n );
+			continue;
+		}
+
+
+
+
+		if ( token == "f" )
+		{
+			std::array<int,3> v;
+			for( int i = 0 ; i < 3; i ++ )
+			{
+				stokenizer.nextToken();
+				token = stokenizer.getToken();
+				
+				
+				strutil::Tokenizer tokenizer( token, " /\t\r\n" );
+				
+				int ids[3];
+				int k = 0;
+				while( tokenizer.nextToken() )
+				{
+					std::string token = tokenizer.getToken();
+					ids[k] = strutil::parseString<int>(token);
+					k ++;
+				}
+
+				
+				v[i] = ids[0];
+				CVertex * pV = m_map_vert[ ids[0] ];
+				if( with_uv )
+					pV->uv() = uvs[ ids[1]-1 ];
+				if( with_normal )
+					pV->normal() = normals[ ids[2]-1 ];
+			}
+			faces.push_back( v );
+		}
+	}
+
+	f.close();
+
+	build( faces, std::vector<int>() );
+}
+
+/*! Create a face
+	\param v an array of vertices
+	\param id face id
+	\return pointer to the new face
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createFace( tVertex  v[] , int id )
+{
+	  m_topology_version ++;
+	  CFace * f = new CFace();
+	  assert( f != NULL );
+	  f->id() = id;
+	  m_faces.push_back( f );
+	  m_map_face.insert( std::pair<int,tFace>(id,f) );
+
+		//create halfedges
+		tHalfEdge hes[3];
+
+		for(int i = 0; i < 3; i ++ )
+		{
+			hes[i] = new CHalfEdge;
+			assert( hes[i] );
+			CVertex * vert =  v[i];
+			hes[i]->vertex() = vert;
+			vert->halfedge() = hes[i];
+		}
+
+		//linking to each other
+		for(int i = 0; i < 3; i ++ )
+		{
+			hes[i]->he_next() = hes[(i+1)%3];
+			hes[i]->he_prev() = hes[(i+2)%3];
+		}
+
+		//linking to face
+		for(int i = 0; i < 3; i ++ )
+		{
+			hes[i]->face()   = f;
+			f->halfedge()    = hes[i];
+		}
+
+		//connecting with edge
+		for(int i = 0; i < 3; i ++ )
+		{
+			tEdge e = createEdge( v[i], v[(i+2)%3] );
+			if( e->halfedge(0)  == NULL )
+			{
+				e->halfedge(0) = hes[i];
+			}
+			else
+			{
+				assert( e->halfedge(1) == NULL );
+				e->halfedge(1) = hes[i];
+			}
+			hes[i]->edge() = e;
+		}
+
+		return f;
+};
+
+/*! Create a triangle
+	\param v0,v1,v2 vertices of the triangle
+	\param id face id
+	\return pointer to the new face
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createTriangle( tVertex v0, tVertex v1, tVertex v2, int id )
+{
+	tVertex v[3] = { v0, v1, v2 };
+	return createFace( v, id );
+};
+
+
+//access id->v
+/*!
+Access a vertex by its id
+\param id the vertex id
+\return the vertex, whose ID equals to id. NULL, if there is no such a vertex.
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CVertex * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::idVertex( int id ) 
+{
+	return m_map_vert[id];
+};
+
+//access v->id
+/*!
+	The vertex id
+	\param v the input vertex
+	\return the vertex id.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexId( tVertex   v )
+{
+	return v->id();
+};
+
+//access id->f
+/*!
+	Access a face by its id
+	\param id the face id
+	\return the face, whose ID equals to id. NULL, if there is no such a face.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::idFace( int id )
+{
+	return m_map_face[id];
+};
+
+//acess f->id
+/*!
+	The face id
+	\param f the input face
+	\return the face id.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline int CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::faceId( tFace   f )
+{
+	return f->id();
+};
+
+/*! Create an edge
+\param v1 end vertex of the edge
+\param v2 end vertex of the edge
+\return pointer to the new edge
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createEdge( tVertex  v1, tVertex  v2 )
+{
+	m_topology_version ++;
+	tVertex pV = ( v1->id()<v2->id())?v1:v2;
+	std::list<CEdge*> & ledges = (std::list<CEdge*> &) pV->edges();
+	//std::cout<< pV->uv()[0]<<" "<< pV->uv()[1]<<" "<<ledges.size()<<std::endl;
+	
+	for( std::list<CEdge*>::iterator te = ledges.begin(); te != ledges.end(); te ++ )
+	{
+		CEdge	  * pE = *te;
+		CHalfEdge * pH = (CHalfEdge*) pE->halfedge(0);
+		if( pH->source() == v1 && pH->target() == v2 ) 
+		{
+			return pE;		
+		}
+		if( pH->source() == v2 && pH->target() == v1 )
+		{
+			return pE;
+		}	
+		
+	}
+
+	//new edge
+	CEdge * e = new CEdge;
+	assert( e != NULL );
+	m_edges.push_back( e );
+	ledges.push_back( e );
+
+
+	return e;
+
+};
+
+
+
+//access vertex->edge
+/*!
+Access an edge by its two end vertices
+\param v0 one vertex of the edge
+\param v1 the other vertex of the edge
+\return the edge connecting both v0 and v1, NULL if no such edge exists.
+*/
+//use the edge list associated with each vertex to locate the edge
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexEdge( tVertex  v0, tVertex  v1 )
+{
+	CVertex * pV = (v0->id() < v1->id() )? v0: v1;
+	std::list<CEdge*> & ledges = vertexEdges( pV );
+
+	for( std::list<CEdge*>::iterator eiter = ledges.begin(); eiter != ledges.end(); eiter ++ )
+	{
+		CEdge * pE = *eiter;
+		CHalfEdge * pH =  edgeHalfedge(pE,0);
+		if( pH->source() == v0 && pH->target() == v1 ) return pE;
+		if( pH->source() == v1 && pH->target() == v0 ) return pE;
+	}
+	return NULL;
+};
+
+/*!
+Access a halfedge by its two end vertices
+\param v0 one vertex of the halfedge
+\param v1 the other vertex of the halfedge
+\return the halfedge connecting both v0 and v1, NULL if no such edge exists.
+*/
+
+//access vertex->halfedge
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexHalfedge( tVertex  v0, tVertex  v1 )
+{
+	CEdge * e = vertexEdge( v0, v1 );
+	assert( e != NULL );
+	CHalfEdge * he = (CHalfEdge*) e->halfedge(0);
+	if( he->vertex() == v1 && he->he_prev()->vertex() == v0 ) return he;
+	he = (CHalfEdge*) e->halfedge(1);
+	assert( he->vertex() == v1 && he->he_prev()->vertex() == v0 );
+	return he;
+};
+
+
+/*!
+Access the edge list of a vertex, {e} such that e->vertex1() == v
+\param v vertex
+\return the list of adjacent edges
+*/
+
+//access vertex->edges
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline std::list<CEdge*> & CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexEdges( tVertex  v0 )
+{
+	return (std::list<CEdge*> &)v0->edges();
+};
+
+//access vertex->halfedge
+/*!
+	The halfedge targeting at a vertex. 
+	\param v the input vertex.
+	\return the halfedge targeting at v, which is the most ccw in halfedge of v.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+inline CHalfEdge * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::vertexHalfedge( tVertex  v  )
+{
+	return (CHalfEdge*) v->halfedge();
+};
+
+/*!
+	Read an .m file.
+	\param input the input obj file name
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_m( const char * input )
+{
+	CMappedFile file;
+
+	if( !file.open( input ) )
+	{
+		fprintf(stderr,"Error in opening file %s\n", input );
+		return;
+	}
+
+	//parse the records into arrays, one chunk of lines per thread
+	std::vector<CMChunk> chunks;
+	CMChunk::parse_file( file.data(), file.end(), chunks );
+
+	//create the vertices in file order, before any face refers to them
+	//attributes are read straight from the traits, a trait string is kept only for other keys
+	bool   polygon = false;
+	size_t nfaces  = 0;
+	for( size_t c = 0; c < chunks.size(); c ++ )
+	{
+		CMChunk & chunk = chunks[c];
+		size_t k = 0;
+		for( size_t i = 0; i < chunk.m_vertex_id.size(); i ++ )
+		{
+			tVertex v  = createVertex( chunk.m_vertex_id[i] );
+			v->point() = chunk.m_vertex_point[i];
+			if( k < chunk.m_vertex_trait.size() && chunk.m_vertex_trait[k].first == (int) i )
+			{
+				const CStringView & trait = chunk.m_vertex_trait[k++].second;
+				if( CTraitAttributes<CVertex>::read( v, trait ) ) v->string() = trait.str();
+			}
+		}
+		polygon = polygon || chunk.m_polygon;
+		nfaces += chunk.m_face_id.size();
+	}
+
+	//triangles are built at once, see build(), polygons one by one
+	bool incremental = false;
+	if( !polygon )
+	{
+		std::vector< std::array<int,3> > faces( nfaces );
+		std::vector<int>                 face_ids( nfaces );
+		size_t n = 0;
+		for( size_t c = 0; c < chunks.size(); c ++ )
+		{
+			CMChunk & chunk = chunks[c];
+			for( size_t i = 0; i < chunk.m_face_id.size(); i ++, n ++ )
+			{
+				const int * fv = &chunk.m_face_vertex[ 3*i ];
+				faces[n][0] = fv[0];
+				faces[n][1] = fv[1];
+				faces[n][2] = fv[2];
+				face_ids[n] = chunk.m_face_id[i];
+			}
+		}
+		if( nfaces > 0 ) build( faces, face_ids );
+	}
+	else
+	{
+		std::vector<CVertex*> v;
+		for( size_t c = 0; c < chunks.size(); c ++ )
+		{
+			CMChunk & chunk = chunks[c];
+			for( size_t i = 0; i < chunk.m_face_id.size(); i ++ )
+			{
+				v.clear();
+				for( int j = chunk.m_face_offset[i]; j < chunk.m_face_offset[i+1]; j ++ )
+				{
+					v.push_back( idVertex( chunk.m_face_vertex[j] ) );
+				}
+				createFace( v, chunk.m_face_id[i] );
+			}
+		}
+		incremental = true;
+	}
+
+	for( size_t c = 0; c < chunks.size(); c ++ )
+	{
+		CMChunk & chunk = chunks[c];
+		for( size_t k = 0; k < chunk.m_face_trait.size(); k ++ )
+		{
+			tFace f = idFace( chunk.m_face_id[ chunk.m_face_trait[k].first ] );
+			const CStringView & trait = chunk.m_face_trait[k].second;
+			if( CTraitAttributes<CFace>::read( f, trait ) ) f->string() = trait.str();
+		}
+	}
+
+	//faces created one by one still need their boundary labeled
+	if( incremental )
+	{
+		labelBoundary();
+	}
+
+	//edge and corner attributes, they need the connectivity
+	for( size_t c = 0; c < chunks.size(); c ++ )
+	{
+		std::vector<CStringView> & records = chunks[c].m_records;
+		for( size_t r = 0; r < records.size(); r ++ )
+		{
+			CLineScanner stokenizer( records[r] );
+			CStringView  token;
+			CStringView  trait;
+			stokenizer.token( token );
+
+			//read in edge attributes
+			if( token == "Edge" )
+			{
+				int id0, id1;
+				if( !stokenizer.parse_int( id0 ) || !stokenizer.parse_int( id1 ) ) continue;
+
+				CVertex * v0 = idVertex( id0 );
+				CVertex * v1 = idVertex( id1 );
+				if( v0 == NULL || v1 == NULL ) continue;
+
+				tEdge edge = vertexEdge( v0, v1 );
+
+				if( edge != NULL && stokenizer.trait( trait ) )
+				{
+					if( CTraitAttributes<CEdge>::read( edge, trait ) ) edge->string() = trait.str();
+				}
+				continue;
+			}
+
+			//read in corner attributes
+			if( token == "Corner" ) 
+			{
+				int vid, fid;
+				if( !stokenizer.parse_int( vid ) || !stokenizer.parse_int( fid ) ) continue;
+
+				CVertex * v = idVertex( vid );
+				CFace   * f = idFace( fid );
+				if( v == NULL || f == NULL ) continue;
+
+				tHalfEdge he = corner( v, f );
+
+				if( he != NULL && stokenizer.trait( trait ) )
+				{
+					if( CTraitAttributes<CHalfEdge>::read( he, trait ) ) he->string() = trait.str();
+				}
+				continue;
+			}
+		}
+	}
+
+	//read in the traits
+
+	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
+	{
+		CVertex *     v = *viter;
+		v->_from_string();
+	}
+
+	for(std::list<CEdge*>::iterator eiter = m_edges.begin();  eiter != m_edges.end() ; ++ eiter )
+	{
+		CEdge *     e = *eiter;
+		e->_from_string();
+	}
+
+	for(std::list<CFace*>::iterator fiter = m_faces.begin();  fiter != m_faces.end() ; ++ fiter )
+	{
+		CFace *     f = *fiter;
+		f->_from_string();
+	}
+
+	for( std::list<CFace*>::iterator fiter=m_faces.begin(); fiter != m_faces.end(); fiter ++ )
+	{
+		CFace * pF = *fiter;
+
+		CHalfEdge * pH  = faceMostCcwHalfEdge( pF );
+		do{
+			pH->_from_string();
+			pH = faceNextCcwHalfEdge( pH );
+		}while( pH != faceMostCcwHalfEdge(pF ) );
+	}
+
+};
+
+/*!
+	Write an .m file.
+	\param output   the output .m file name
+	\param nthreads number of chunks formatted in parallel, 0 for one per thread of CThreadPool
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_m( const char * output, int nthreads )
+{
+	CTextWriter _os;
+	if( !_os.open( output ) )
+	{
+		fprintf(stderr,"Error is opening file %s\n", output );
+		return;
+	}
+
+	//write traits to string, in the calling thread since this fills the trait tables
+	std::vector<tVertex> verts;
+	verts.reserve( m_verts.size() );
+	for( typename std::list<CVertex*>::iterator viter=m_verts.begin(); viter != m_verts.end(); viter ++ )
+	{
+		CVertex * pV = *viter;
+		pV->_to_string();
+		verts.push_back( pV );
+	}
+
+	std::vector<tEdge> edges;
+	edges.reserve( m_edges.size() );
+	for( typename std::list<CEdge*>::iterator eiter=m_edges.begin(); eiter != m_edges.end(); eiter ++ )
+	{
+		CEdge * pE = *eiter;
+		pE->_to_string();
+		edges.push_back( pE );
+	}
+
+	std::vector<tFace> faces;
+	faces.reserve( m_faces.size() );
+	for( typename std::list<CFace*>::iterator fiter=m_faces.begin(); fiter != m_faces.end(); fiter ++ )
+	{
+		CFace * pF = *fiter;
+		pF->_to_string();
+		faces.push_back( pF );
+
+		CHalfEdge * pH = faceHalfedge( pF );
+		do{
+			pH->_to_string();
+			pH = halfedgeNext( pH );
+		}while( pH != faceHalfedge( pF ) );
+	}
+
+	format_parallel( _os, verts.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		tVertex v = verts[i];
+		out.put( "Vertex " );
+		out.put_int( v->id() );
+		for( int k = 0; k < 2; k ++ )
+		{
+			out.put( ' ' );
+			out.put_double( v->uv()[k] );
+		}
+		const std::string * trait = CTraitTable<MeshLib::CVertex>::find( v );
+		if( trait != NULL )
+		{
+			out.put( " {" );
+			out.put( *trait );
+			out.put( '}' );
+		}
+		out.put( '\n' );
+	}, nthreads );
+
+	format_parallel( _os, faces.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		tFace f = faces[i];
+		out.put( "Face " );
+		out.put_int( f->id() );
+
+		tHalfEdge he = faceHalfedge( f );
+		do{
+			out.put( ' ' );
+			out.put_int( he->target()->id() );
+			he = halfedgeNext( he );
+		}while( he != f->halfedge() );
+
+		const std::string * trait = CTraitTable<MeshLib::CFace>::find( f );
+		if( trait != NULL )
+		{
+			out.put( " {" );
+			out.put( *trait );
+			out.put( '}' );
+		}
+		out.put( '\n' );
+	}, nthreads );
+
+	format_parallel( _os, edges.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		tEdge e = edges[i];
+		out.put( "Edge " );
+		out.put_int( edgeVertex1( e )->id() );
+		out.put( ' ' );
+		out.put_int( edgeVertex2( e )->id() );
+		out.put( " {" );
+		const std::string * trait = CTraitTable<MeshLib::CEdge>::find( e );
+		if( trait != NULL ) out.put( *trait );
+		out.put( "}\n" );
+	}, nthreads );
+
+	format_parallel( _os, faces.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		tFace f = faces[i];
+		tHalfEdge he = faceHalfedge( f );
+		do{
+			const std::string * trait = CTraitTable<MeshLib::CHalfEdge>::find( he );
+			if( trait != NULL )
+			{
+				out.put( "Corner " );
+				out.put_int( he->vertex()->id() );
+				out.put( ' ' );
+				out.put_int( f->id() );
+				out.put( " {" );
+				out.put( *trait );
+				out.put( "}\n" );
+			}
+			he = halfedgeNext( he );
+		}while( he != f->halfedge() );
+	}, nthreads );
+
+	if( !_os.close() )
+	{
+		fprintf(stderr,"Error in writing file %s\n", output );
+	}
+};
+
+
+//assume the mesh is with uv coordinates and normal vector for each vertex
+/*!
+	Write an .obj file.
+	\param output   the output .obj file name
+	\param nthreads number of chunks formatted in parallel, 0 for one per thread of CThreadPool
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_obj( const char * output, int nthreads )
+{
+	CTextWriter _os;
+	if( !_os.open( output ) )
+	{
+		fprintf(stderr,"Error is opening file %s\n", output );
+		return;
+	}
+
+	std::vector<tVertex> verts( m_verts.begin(), m_verts.end() );
+	std::vector<tFace>   faces( m_faces.begin(), m_faces.end() );
+
+	int vid = 1;
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		verts[i]->id() = vid ++;
+	}
+
+	format_parallel( _os, verts.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		out.put( 'v' );
+		for( int k = 0; k < 3; k ++ )
+		{
+			out.put( ' ' );
+			out.put_double( verts[i]->point()[k] );
+		}
+		out.put( '\n' );
+	}, nthreads );
+
+	format_parallel( _os, verts.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		out.put( "vt" );
+		for( int k = 0; k < 2; k ++ )
+		{
+			out.put( ' ' );
+			out.put_double( verts[i]->uv()[k] );
+		}
+		out.put( '\n' );
+	}, nthreads );
+
+	format_parallel( _os, verts.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		out.put( "vn" );
+		for( int k = 0; k < 3; k ++ )
+		{
+			out.put( ' ' );
+			out.put_double( verts[i]->normal()[k] );
+		}
+		out.put( '\n' );
+	}, nthreads );
+
+	format_parallel( _os, faces.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		tFace f = faces[i];
+		out.put( 'f' );
+
+		tHalfEdge he = faceHalfedge( f );
+		do{
+			int vid = he->target()->id();
+			out.put( ' ' );
+			out.put_int( vid );
+			out.put( '/' );
+			out.put_int( vid );
+			out.put( '/' );
+			out.put_int( vid );
+			he = halfedgeNext( he );
+		}while( he != f->halfedge() );
+		out.put( '\n' );
+	}, nthreads );
+
+	if( !_os.close() )
+	{
+		fprintf(stderr,"Error in writing file %s\n", output );
+	}
+};
+
+/*!
+	Write an .off file.
+	\param output   the output .off file name
+	\param nthreads number of chunks formatted in parallel, 0 for one per thread of CThreadPool
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_off( const char * output, int nthreads )
+{
+	CTextWriter _os;
+	if( !_os.open( output ) )
+	{
+		fprintf(stderr,"Error is opening file %s\n", output );
+		return;
+	}
+
+	_os.put( "OFF" );
+	_os.end_line();
+	_os.put_int( (long long) m_verts.size() );
+	_os.put( ' ' );
+	_os.put_int( (long long) m_faces.size() );
+	_os.put( ' ' );
+	_os.put_int( (long long) m_edges.size() );
+	_os.end_line();
+
+	std::vector<tVertex> verts( m_verts.begin(), m_verts.end() );
+	std::vector<tFace>   faces( m_faces.begin(), m_faces.end() );
+
+	int vid = 0;
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		verts[i]->id() = vid ++;
+	}
+
+	format_parallel( _os, verts.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		for( int k = 0; k < 3; k ++ )
+		{
+			if( k > 0 ) out.put( ' ' );
+			out.put_double( verts[i]->point()[k] );
+		}
+		out.put( '\n' );
+	}, nthreads );
+
+	format_parallel( _os, faces.size(), [&]( CTextBuffer & out, size_t i )
+	{
+		tFace f = faces[i];
+		out.put( '3' );
+
+		tHalfEdge he = faceHalfedge( f );
+		do{
+			out.put( ' ' );
+			out.put_int( he->target()->id() );
+			he = halfedgeNext( he );
+		}while( he != f->halfedge() );
+		out.put( '\n' );
+	}, nthreads );
+
+	if( !_os.close() )
+	{
+		fprintf(stderr,"Error in writing file %s\n", output );
+	}
+};
+
+
+//template pointer converting to base class pointer is OK (BasePointer) = (TemplatePointer)ed
+//(TemplatePointer)=(BasePointer) is incorrect
+/*! delete one face
+\param pFace the face to be deleted
+*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::deleteFace( tFace  pFace )
+{  	  
+	  m_topology_version ++;
+	  std::map<int,tFace>::iterator fiter = m_map_face.find( pFace->id() );
+	  if( fiter != m_map_face.end() )
+	  {
+		  m_map_face.erase( fiter );
+	  }	
+	  //local edits delete recent faces, search from the back and stop at the face
+	  typename std::list<tFace>::reverse_iterator riter = std::find( m_faces.rbegin(), m_faces.rend(), pFace );
+	  if( riter != m_faces.rend() ) m_faces.erase( -- riter.base() );
+
+		
+	 //create halfedges
+	 tHalfEdge hes[3];
+
+	 hes[0] = faceHalfedge( pFace );
+	 hes[1] = faceNextCcwHalfEdge( hes[0] );
+	 hes[2] = faceNextCcwHalfEdge( hes[1] );
+
+	 for(int i = 0; i < 3; i ++ )
+	 {
+		//connection with edge
+		CHalfEdge * pH = hes[i];
+
+		//connection to target
+		CVertex * pV = halfedgeTarget( pH );
+		if( pV->halfedge() == pH )
+		{
+			if( pH->he_next()->he_sym() != NULL )
+				pV->halfedge() = pH->he_next()->he_sym();
+			else
+			{
+
+				assert( pH->he_sym() != NULL ); //otherwise the mesh is not a manifold
+
+				pV->halfedge() = pH->he_sym()->he_prev();
+			}
+		}
+	 }
+
+		for(int i = 0; i < 3; i ++ )
+		{
+			//connection with edge
+			CHalfEdge * pH = hes[i];
+			CHalfEdge * pS = halfedgeSym( pH );
+			CEdge * pE = halfedgeEdge( pH );
+
+			pE->halfedge(0) = pS;
+			pE->halfedge(1) = NULL;
+
+			if( pS == NULL )
+			{
+				//assert(0);
+				typename std::list<tEdge>::reverse_iterator eiter = std::find( m_edges.rbegin(), m_edges.rend(), pE );
+				if( eiter != m_edges.rend() ) m_edges.erase( -- eiter.base() );
+				CVertex * v0 = halfedgeSource( pH );
+				CVertex * v1 = halfedgeTarget( pH );
+
+				v0->edges().remove(pE);
+				v1->edges().remove(pE);
+
+				delete pE;
+			}
+
+			
+		}
+		
+		//remove half edges
+		for(int i = 0; i < 3; i ++ )
+		{
+			delete hes[i];
+		}
+		
+		delete pFace;
+};
+
+/*!	Delete all the faces, edges and halfedges, keep the vertices.
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::deleteFaces()
+{
+	m_topology_version ++;
+	for( typename std::list<tFace>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); ++ fiter )
+	{
+		tFace     pF    = *fiter;
+		tHalfEdge first = faceHalfedge( pF );
+		tHalfEdge he    = first;
+		do{
+			tHalfEdge next = halfedgeNext( he );
+			delete he;
+			he = next;
+		}while( he != first );
+		delete pF;
+	}
+	for( typename std::list<tEdge>::iterator eiter = m_edges.begin(); eiter != m_edges.end(); ++ eiter )
+	{
+		delete *eiter;
+	}
+	m_faces.clear();
+	m_edges.clear();
+	m_map_face.clear();
+
+	for( typename std::list<tVertex>::iterator viter = m_verts.begin(); viter != m_verts.end(); ++ viter )
+	{
+		tVertex v = *viter;
+		v->halfedge() = NULL;
+		v->edges().clear();
+		v->boundary() = false;
+	}
+};
+
+/*!
+	Read an .off file
+	\param input the input .off filename
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_off( const char * input )
+{
+	std::fstream is( input, std::fstream::in );
+
+	if( is.fail() )
+	{
+		fprintf(stderr,"Error is opening file %s\n", input );
+		return;
+	}
+
+	char buffer[MAX_LINE];
+
+	//read in the first line "OFF"
+
+	while( is.getline(buffer, MAX_LINE )  )
+	{		
+		std::string line( buffer );
+	
+		strutil::Tokenizer stokenizer( line, " \r\n" );
+
+		stokenizer.nextToken();
+		std::string token = stokenizer.getToken();
+		if( token == "OFF"  || token == "NOFF" ) break;
+	}
+
+	int nVertices, nFaces, nEdges;
+
+	//read in Vertex Number, Face Number, Edge Number
+
+		is.getline(buffer, MAX_LINE );
+		std::string line( buffer );
+	
+		strutil::Tokenizer stokenizer( line, " \r\n" );
+
+		stokenizer.nextToken();
+		std::string token = stokenizer.getToken();
+		nVertices = strutil::parseString<int>( token );
+
+		stokenizer.nextToken();
+		token = stokenizer.getToken();
+		nFaces = strutil::parseString<int>( token );
+
+		stokenizer.nextToken();
+		token = stokenizer.getToken();
+		nEdges = strutil::parseString<int>( token );
+
+		//printf("V %d F %d E %d\n" , nVertices, nFaces, nEdges);
+	
+
+	for( int id = 0; id < nVertices; id ++ )
+	{
+		is.getline(buffer, MAX_LINE );
+		std::string line( buffer );
+		
+		strutil::Tokenizer stokenizer( line, " \r\n" );
+		CPoint p;
+		for( int j = 0; j < 3; j ++ )
+		{
+			stokenizer.nextToken();
+			std::string token = stokenizer.getToken();
+			p[j] = strutil::parseString<float>( token );
+		}
+
+			CVertex * v = createVertex( id + 1 );
+			v->point() = p;
+	}
+
+
+	std::vector< std::array<int,3> > faces;
+	faces.reserve( nFaces );
+
+	for( int id = 0; id < nFaces; id ++ )
+	{
+
+		is.getline(buffer, MAX_LINE );
+		std::string line( buffer );
+		
+		strutil::Tokenizer stokenizer( line, " \r\n" );
+		stokenizer.nextToken();
+		std::string token = stokenizer.getToken();
+		
+		int n = strutil::parseString<int>(token);
+		assert( n == 3 );
+
+		std::array<int,3> v;
+		for( int j = 0; j < 3; j ++ )
+		{
+			stokenizer.nextToken();
+			std::string token = stokenizer.getToken();
+			int vid = strutil::parseString<int>( token );
+			v[j] = vid + 1;
+		}
+		
+		faces.push_back( v );
+	}
+
+	is.close();
+
+	build( faces, std::vector<int>() );
+
+};
+
+/*!
+	Write an .mb file.
+	\param output the output .mb file name
+	\return whether the file was written and flushed
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_mb( const char * output )
+{
+	int nv = numVertices();
+	int nf = numFaces();
+
+	//vertex blocks, in list order
+	std::vector<tVertex>             verts( m_verts.begin(), m_verts.end() );
+	std::unordered_map<tVertex,int>  vertex_index( nv * 2 );
+	std::vector<int>                 vertex_ids( nv );
+	std::vector<double>              points( 3 * nv );
+	std::vector<double>              uvs( 2 * nv );
+	bool with_point = false, with_uv = false;
+
+	for( int i = 0; i < nv; i ++ )
+	{
+		tVertex v = verts[i];
+		vertex_index[v] = i;
+		vertex_ids[i]   = v->id();
+		for( int k = 0; k < 3; k ++ )
+		{
+			points[3*i+k] = v->point()[k];
+			with_point = with_point || v->point()[k] != 0;
+		}
+		for( int k = 0; k < 2; k ++ )
+		{
+			uvs[2*i+k] = v->uv()[k];
+			with_uv = with_uv || v->uv()[k] != 0;
+		}
+	}
+
+	std::vector<tFace>     faces( m_faces.begin(), m_faces.end() );
+	std::vector<int>       face_ids( nf );
+	std::vector<tHalfEdge> hes;
+	std::vector<int>       corners, opposites;
+	for( int f = 0; f < nf; f ++ ) face_ids[f] = faces[f]->id();
+	if( !_corner_table( vertex_index, faces, hes, corners, opposites, output ) ) return false;
+
+	std::ostringstream columns( std::ios::out | std::ios::binary );
+	CBinaryColumns<CVertex>::write(   columns, verts.begin(), verts.end(), nv );
+	CBinaryColumns<CFace>::write(     columns, faces.begin(), faces.end(), nf );
+	CBinaryColumns<CHalfEdge>::write( columns, hes.begin(),   hes.end(),   3 * nf );
+	std::string column_block = columns.str();
+
+	CBinaryMesh mb;
+	mb.num_vertices = nv;
+	mb.num_faces    = nf;
+	mb.vertex_ids   = nv > 0 ? &vertex_ids[0] : NULL;
+	mb.points       = ( nv > 0 && ( with_point || !with_uv ) ) ? &points[0] : NULL;
+	mb.uvs          = ( nv > 0 && with_uv ) ? &uvs[0] : NULL;
+	mb.face_ids     = nf > 0 ? &face_ids[0] : NULL;
+	mb.corners      = nf > 0 ? &corners[0] : NULL;
+	mb.opposites    = nf > 0 ? &opposites[0] : NULL;
+	mb.columns      = column_block.data();
+	mb.column_size  = column_block.size();
+	return mb.write( output );
+};
+
+/*!
+	Read an .mb file.
+	\param input the input .mb file name
+	\return whether the file could be read
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_mb( const char * input )
+{
+	CBinaryMesh mb;
+	if( !mb.open( input ) )
+	{
+		fprintf(stderr,"Error in opening file %s\n", input );
+		return false;
+	}
+
+	int nv = mb.num_vertices;
+	int nf = mb.num_faces;
+
+	//the corners are checked before any element is created
+	for( int c = 0; c < 3 * nf; c ++ )
+	{
+		if( mb.corners[c] < 0 || mb.corners[c] >= nv )
+		{
+			fprintf(stderr,"Error in file %s: corner %d names vertex %d of %d\n", input, c, mb.corners[c], nv );
+			return false;
+		}
+	}
+
+	std::vector<tVertex> verts( nv );
+	for( int i = 0; i < nv; i ++ )
+	{
+		tVertex v = createVertex( mb.vertex_ids ? mb.vertex_ids[i] : i + 1 );
+		if( mb.points ) v->point() = CPoint( mb.points[3*i], mb.points[3*i+1], mb.points[3*i+2] );
+		if( mb.uvs )    v->uv()    = CPoint2( mb.uvs[2*i], mb.uvs[2*i+1] );
+		verts[i] = v;
+	}
+
+	//the vertex columns are read before build removes dangling vertices
+	CMemoryStreamBuf buffer( mb.columns, mb.columns ? mb.column_size : 0 );
+	std::istream     columns( &buffer );
+	if( mb.columns ) CBinaryColumns<CVertex>::read( columns, verts.begin(), verts.end() );
+
+	std::vector< std::array<int,3> > faces( nf );
+	std::vector<int>                 face_ids( nf );
+	for( int f = 0; f < nf; f ++ )
+	{
+		for( int i = 0; i < 3; i ++ )
+		{
+			faces[f][i] = verts[ mb.corners[3*f+i] ]->id();
+		}
+		face_ids[f] = mb.face_ids ? mb.face_ids[f] : f + 1;
+	}
+	if( nf > 0 ) build( faces, face_ids, mb.opposites );
+
+	if( mb.columns && nf > 0 )
+	{
+		std::vector<tFace>     fs( m_faces.begin(), m_faces.end() );
+		std::vector<tHalfEdge> hes( 3 * nf );
+		for( int f = 0; f < nf; f ++ )
+		{
+			tHalfEdge he = halfedgeNext( faceHalfedge( fs[f] ) );
+			for( int i = 0; i < 3; i ++ )
+			{
+				hes[3*f+i] = he;
+				he = halfedgeNext( he );
+			}
+		}
+		CBinaryColumns<CFace>::read(     columns, fs.begin(),  fs.end() );
+		CBinaryColumns<CHalfEdge>::read( columns, hes.begin(), hes.end() );
+	}
+	return true;
+};
+
+/*!
+	The corner table of the triangles.
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::_corner_table( std::unordered_map<tVertex,int> & vertex_index,
+	const std::vector<tFace> & faces, std::vector<tHalfEdge> & hes, std::vector<int> & corners,
+	std::vector<int> & opposites, const char * output )
+{
+	int nf = (int) faces.size();
+
+	//corners, corner 3f+i is the target of the i-th halfedge after faceHalfedge(f), the layout of build
+	std::unordered_map<tHalfEdge,int> halfedge_index( nf * 6 );
+	hes.resize( 3 * nf );
+	corners.resize( 3 * nf );
+	for( int f = 0; f < nf; f ++ )
+	{
+		tHalfEdge he = halfedgeNext( faceHalfedge( faces[f] ) );
+		for( int i = 0; i < 3; i ++ )
+		{
+			hes[3*f+i]         = he;
+			corners[3*f+i]     = vertex_index[ halfedgeTarget( he ) ];
+			halfedge_index[he] = 3*f+i;
+			he = halfedgeNext( he );
+		}
+		if( he != halfedgeNext( faceHalfedge( faces[f] ) ) )
+		{
+			fprintf( stderr, "Error in writing file %s, face %d is not a triangle\n", output, faces[f]->id() );
+			return false;
+		}
+	}
+
+	//corner next(c) faces halfedge c, its opposite faces the twin
+	opposites.assign( 3 * nf, -1 );
+	for( int c = 0; c < 3 * nf; c ++ )
+	{
+		tHalfEdge sym = halfedgeSym( hes[c] );
+		if( sym == NULL ) continue;
+		int t = halfedge_index[sym];
+		opposites[ c - c%3 + (c+1)%3 ] = t - t%3 + (t+1)%3;
+	}
+	return true;
+};
+
+/*!
+	Write an .mc file.
+	\param output the output .mc file name
+	\param bits bits per quantized coordinate
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_mc( const char * output, int bits )
+{
+	int nv = numVertices();
+
+	CCompressedMesh                 mc;
+	std::vector<tVertex>            verts( m_verts.begin(), m_verts.end() );
+	std::unordered_map<tVertex,int> vertex_index( nv * 2 );
+	bool with_point = false, with_uv = false;
+
+	mc.points.resize( 3 * nv );
+	mc.uvs.resize( 2 * nv );
+	for( int i = 0; i < nv; i ++ )
+	{
+		tVertex v = verts[i];
+		vertex_index[v] = i;
+		for( int k = 0; k < 3; k ++ )
+		{
+			mc.points[3*i+k] = v->point()[k];
+			with_point = with_point || v->point()[k] != 0;
+		}
+		for( int k = 0; k < 2; k ++ )
+		{
+			mc.uvs[2*i+k] = v->uv()[k];
+			with_uv = with_uv || v->uv()[k] != 0;
+		}
+	}
+	if( !with_point && with_uv ) mc.points.clear();
+	if( !with_uv ) mc.uvs.clear();
+
+	std::vector<tFace>     faces( m_faces.begin(), m_faces.end() );
+	std::vector<tHalfEdge> hes;
+	if( !_corner_table( vertex_index, faces, hes, mc.corners, mc.opposites, output ) ) return;
+
+	mc.num_vertices = nv;
+	mc.num_faces    = (int) faces.size();
+	mc.write( output, bits );
+};
+
+/*!
+	Read an .mc file.
+	\param input the input .mc file name
+	\return whether the file could be read
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+bool CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_mc( const char * input )
+{
+	CCompressedMesh mc;
+	if( !mc.open( input ) )
+	{
+		fprintf(stderr,"Error in opening file %s\n", input );
+		return false;
+	}
+
+	int nv = mc.num_vertices;
+	int nf = mc.num_faces;
+	for( int i = 0; i < nv; i ++ )
+	{
+		tVertex v = createVertex( i + 1 );
+		if( !mc.points.empty() ) v->point() = CPoint( mc.points[3*i], mc.points[3*i+1], mc.points[3*i+2] );
+		if( !mc.uvs.empty() )    v->uv()    = CPoint2( mc.uvs[2*i], mc.uvs[2*i+1] );
+	}
+
+	std::vector< std::array<int,3> > faces( nf );
+	for( int f = 0; f < nf; f ++ )
+	{
+		for( int i = 0; i < 3; i ++ ) faces[f][i] = mc.corners[3*f+i] + 1;
+	}
+	if( nf > 0 ) build( faces, std::vector<int>(), mc.opposites.empty() ? NULL : &mc.opposites[0] );
+	return true;
+};
+
+/*!
+	Read a binary little endian .ply file.
+	\param input the input .ply file name
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::read_ply( const char * input )
+{
+	CMappedFile file;
+	if( !file.open( input ) )
+	{
+		fprintf(stderr,"Error in opening file %s\n", input );
+		return;
+	}
+	const char * end = file.data() + file.size();
+
+	CPlyHeader header;
+	if( !header.parse( file.data(), end ) )
+	{
+		fprintf( stderr, "%s is not a .ply file\n", input );
+		return;
+	}
+	if( header.format != CPlyHeader::BINARY_LITTLE_ENDIAN )
+	{
+		fprintf( stderr, "%s: only binary little endian .ply files are supported\n", input );
+		return;
+	}
+
+	//where a property is stored, the offsets of attributes are the same for all elements of a class
+	enum { SKIP, POINT, UV, NORMAL, ATTRIBUTE };
+	struct CTarget { int kind; int k; long offset; EPlyType type; };
+
+	static const char * names[] = { "x", "y", "z", "u", "v", "s", "t", "texture_u", "texture_v", "nx", "ny", "nz" };
+	static const int    kinds[] = { POINT, POINT, POINT, UV, UV, UV, UV, UV, UV, NORMAL, NORMAL, NORMAL };
+	static const int    ks[]    = { 0, 1, 2, 0, 1, 0, 1, 0, 1, 0, 1, 2 };
+
+	CVertex probe_vertex;
+	CFace   probe_face;
+
+	std::vector<const char*> fields;
+	std::vector<tVertex>     verts;
+	const char *             p = header.body;
+
+	for( size_t e = 0; e < header.elements.size(); e ++ )
+	{
+		const CPlyElement & element = header.elements[e];
+		bool is_vertex = ( element.name == "vertex" );
+		bool is_face   = ( element.name == "face" );
+
+		std::vector<CTarget> targets( element.properties.size() );
+		for( size_t k = 0; k < targets.size(); k ++ )
+		{
+			const CPlyProperty & prop = element.properties[k];
+			CTarget & t = targets[k];
+			t.kind = SKIP; t.k = 0; t.offset = 0; t.type = PLY_NONE;
+			if( prop.count_type != PLY_NONE ) continue;
+			if( is_vertex )
+			{
+				for( int j = 0; j < 12; j ++ )
+				{
+					if( prop.name == names[j] ) { t.kind = kinds[j]; t.k = ks[j]; }
+				}
+				if( t.kind == SKIP ) t.type = CPlyAttributes<CVertex>::locate( &probe_vertex, prop.name, t.offset );
+			}
+			if( is_face ) t.type = CPlyAttributes<CFace>::locate( &probe_face, prop.name, t.offset );
+			if( t.type != PLY_NONE ) t.kind = ATTRIBUTE;
+		}
+
+		//vertices are filled record by record
+		if( is_vertex )
+		{
+			verts.resize( element.count );
+			for( size_t i = 0; i < element.count; i ++ )
+			{
+				const char * next = element.record( p, end, fields );
+				p = NULL;
+				if( next == NULL ) break;
+				tVertex v = createVertex( (int) i + 1 );
+				verts[i] = v;
+				for( size_t k = 0; k < targets.size(); k ++ )
+				{
+					const CTarget & t = targets[k];
+					if( t.kind == SKIP ) continue;
+					double value = _ply_load( fields[k], element.properties[k].type );
+					switch( t.kind )
+					{
+					case POINT:  v->point()[t.k]  = value; break;
+					case UV:     v->uv()[t.k]     = value; break;
+					case NORMAL: v->normal()[t.k] = value; break;
+					default:     _ply_assign( v, t.offset, t.type, value ); break;
+					}
+				}
+				p = next;
+			}
+			//a truncated record ends the file, the elements after it are not read
+			if( p == NULL ) break;
+			continue;
+		}
+
+		//faces need the connectivity first, their records are kept for the attributes
+		std::vector<const char*> records;
+		records.reserve( element.count );
+		for( size_t i = 0; i < element.count && p != NULL; i ++ )
+		{
+			records.push_back( p );
+			p = element.record( p, end, fields );
+		}
+		if( p == NULL ) break;
+		if( !is_face ) continue;
+
+		int list = element.find( "vertex_indices" );
+		if( list < 0 ) list = element.find( "vertex_index" );
+		if( list < 0 ) continue;
+		const CPlyProperty & indices = element.properties[list];
+		size_t count_size = _ply_size( indices.count_type );
+		size_t index_size = _ply_size( indices.type );
+
+		//triangles are built at once, other polygons created one by one
+		std::vector< std::array<int,3> > triangles;
+		std::vector<size_t>              face_records;
+		bool                             triangulated = true;
+		for( size_t i = 0; i < records.size(); i ++ )
+		{
+			element.record( records[i], end, fields );
+			int n = (int) _ply_load( fields[list], indices.count_type );
+			bool valid = ( n >= 3 );
+			for( int j = 0; j < n && valid; j ++ )
+			{
+				int index = (int) _ply_load( fields[list] + count_size + j * index_size, indices.type );
+				valid = ( index >= 0 && index < (int) verts.size() && verts[index] != NULL );
+			}
+			if( !valid )
+			{
+				fprintf( stderr, "%s: face %d is skipped, it has invalid vertex indices\n", input, (int) i );
+				continue;
+			}
+			face_records.push_back( i );
+			triangulated = triangulated && ( n == 3 );
+		}
+
+		std::vector<tFace> fs;
+		if( triangulated )
+		{
+			triangles.resize( face_records.size() );
+			for( size_t f = 0; f < face_records.size(); f ++ )
+			{
+				element.record( records[ face_records[f] ], end, fields );
+				for( int j = 0; j < 3; j ++ )
+				{
+					int index = (int) _ply_load( fields[list] + count_size + j * index_size, indices.type );
+					triangles[f][j] = verts[index]->id();
+				}
+			}
+			if( !triangles.empty() ) build( triangles, std::vector<int>() );
+			fs.assign( m_faces.begin(), m_faces.end() );
+		}
+		else
+		{
+			std::vector<tVertex> v;
+			for( size_t f = 0; f < face_records.size(); f ++ )
+			{
+				element.record( records[ face_records[f] ], end, fields );
+				int n = (int) _ply_load( fields[list], indices.count_type );
+				v.clear();
+				for( int j = 0; j < n; j ++ )
+				{
+					v.push_back( verts[ (int) _ply_load( fields[list] + count_size + j * index_size, indices.type ) ] );
+				}
+				fs.push_back( createFace( v, (int) f + 1 ) );
+			}
+			labelBoundary();
+		}
+
+		for( size_t f = 0; f < fs.size(); f ++ )
+		{
+			element.record( records[ face_records[f] ], end, fields );
+			for( size_t k = 0; k < targets.size(); k ++ )
+			{
+				const CTarget & t = targets[k];
+				if( t.kind != ATTRIBUTE ) continue;
+				_ply_assign( fs[f], t.offset, t.type, _ply_load( fields[k], element.properties[k].type ) );
+			}
+		}
+	}
+
+	if( p == NULL ) fprintf( stderr, "%s is truncated\n", input );
+};
+
+/*!
+	Write a binary little endian .ply file.
+	\param output the output .ply file name
+	*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::write_ply( const char * output )
+{
+	std::vector<tVertex>            verts( m_verts.begin(), m_verts.end() );
+	std::vector<tFace>              faces( m_faces.begin(), m_faces.end() );
+	std::unordered_map<tVertex,int> vertex_index( verts.size() * 2 );
+	bool with_uv = false, with_normal = false;
+
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		tVertex v = verts[i];
+		vertex_index[v] = (int) i;
+		with_uv     = with_uv     || v->uv()[0] != 0 || v->uv()[1] != 0;
+		with_normal = with_normal || v->normal()[0] != 0 || v->normal()[1] != 0 || v->normal()[2] != 0;
+	}
+
+	std::string header = "ply\nformat binary_little_endian 1.0\n";
+	header += "element vertex " + std::to_string( (unsigned long long) verts.size() ) + "\n";
+	header += "property double x\nproperty double y\nproperty double z\n";
+	if( with_uv )     header += "property double u\nproperty double v\n";
+	if( with_normal ) header += "property double nx\nproperty double ny\nproperty double nz\n";
+	size_t vertex_bytes = 3 * sizeof(double) + ( with_uv ? 2 : 0 ) * sizeof(double) + ( with_normal ? 3 : 0 ) * sizeof(double);
+	vertex_bytes += CPlyAttributes<CVertex>::declare( header );
+	//the length type of the lists is chosen before anything is written
+	size_t max_size = 0;
+	for( size_t f = 0; f < faces.size(); f ++ )
+	{
+		size_t n = 0;
+		tHalfEdge he = faceHalfedge( faces[f] );
+		do{
+			n ++;
+			he = halfedgeNext( he );
+		}while( he != faceHalfedge( faces[f] ) );
+		max_size = std::max( max_size, n );
+	}
+	bool wide = max_size > 255;
+
+	header += "element face " + std::to_string( (unsigned long long) faces.size() ) + "\n";
+	header += wide ? "property list uint int vertex_indices\n" : "property list uchar int vertex_indices\n";
+	size_t face_bytes = CPlyAttributes<CFace>::declare( header );
+	header += "end_header\n";
+
+	CTextWriter writer;
+	if( !writer.open( output ) )
+	{
+		fprintf( stderr, "Error is opening file %s\n", output );
+		return;
+	}
+	writer.put( header );
+
+	//records are assembled in place and appended to the block buffer
+	std::vector<char> record( std::max( vertex_bytes, face_bytes ) + 1 );
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		tVertex v = verts[i];
+		double  values[8];
+		int     n = 0;
+		for( int k = 0; k < 3; k ++ ) values[n++] = v->point()[k];
+		if( with_uv )     for( int k = 0; k < 2; k ++ ) values[n++] = v->uv()[k];
+		if( with_normal ) for( int k = 0; k < 3; k ++ ) values[n++] = v->normal()[k];
+		memcpy( &record[0], values, n * sizeof(double) );
+		CPlyAttributes<CVertex>::store( v, &record[0] + n * sizeof(double) );
+		writer.put( &record[0], vertex_bytes );
+		if( writer.size() >= CTextWriter::BLOCK_SIZE ) writer.flush();
+	}
+
+	std::vector<int> indices;
+	for( size_t f = 0; f < faces.size(); f ++ )
+	{
+		indices.clear();
+		tHalfEdge he = faceHalfedge( faces[f] );
+		do{
+			indices.push_back( vertex_index[ halfedgeTarget( he ) ] );
+			he = halfedgeNext( he );
+		}while( he != faceHalfedge( faces[f] ) );
+		if( wide )
+		{
+			unsigned int n = (unsigned int) indices.size();
+			writer.put( (const char*) &n, sizeof( n ) );
+		}
+		else writer.put( (char)(unsigned char) indices.size() );
+		writer.put( (const char*) &indices[0], indices.size() * sizeof(int) );
+		CPlyAttributes<CFace>::store( faces[f], &record[0] );
+		writer.put( &record[0], face_bytes );
+		if( writer.size() >= CTextWriter::BLOCK_SIZE ) writer.flush();
+	}
+
+	if( !writer.close() ) fprintf( stderr, "Error in writing file %s\n", output );
+};
+
+
+/*!
+	Label boundary edges, vertices
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::labelBoundary( void )
+{
+	m_topology_version ++;
+	
+	//Label boundary edges
+	for(std::list<CEdge*>::iterator eiter= m_edges.begin() ; eiter != m_edges.end() ; ++ eiter )
+	{
+		CEdge *     edge = *eiter;
+		CHalfEdge * he[2];
+
+		he[0] = (CHalfEdge*)edge->halfedge(0);
+		he[1] = (CHalfEdge*)edge->halfedge(1);
+		
+		assert( he[0] != NULL );
+		
+
+		if( he[1] != NULL )
+		{
+			assert( he[0]->target() == he[1]->source() && he[0]->source() == he[1]->target() );
+
+			if( he[0]->target()->id() < he[0]->source()->id() )
+			{
+				edge->halfedge(0 ) = he[1];
+				edge->halfedge(1 ) = he[0];
+			}
+
+			assert( edgeVertex1(edge)->id() < edgeVertex2(edge)->id() );
+		}
+		else
+		{
+			he[0]->vertex()->boundary() = true;
+			he[0]->he_prev()->vertex()->boundary()  = true;
+		}
+
+	}
+
+	//remove dangling vertices, in one pass over the list
+	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; )
+	{
+		tVertex     v = *viter;
+		if( v->halfedge() != NULL )
+		{
+			++ viter;
+			continue;
+		}
+		viter = m_verts.erase( viter );
+		m_map_vert.erase( v->id() );
+		delete v;
+	}
+
+	//Arrange the boundary half_edge of boundary vertices, to make its halfedge
+	//to be the most ccw in half_edge
+
+	for(std::list<CVertex*>::iterator viter = m_verts.begin();  viter != m_verts.end() ; ++ viter )
+	{
+		tVertex     v = *viter;
+		if( !v->boundary() ) continue;
+
+		CHalfEdge * he = (CHalfEdge*)v->halfedge();
+		while( he->he_sym() != NULL )
+		{
+			he = (CHalfEdge*)he->ccw_rotate_about_target();
+		}
+		v->halfedge() = he;
+	}
+
+
+};
+
+/*! Create a face
+	\param v an array of vertices
+	\param id face id
+	\return pointer to the new face
+	*/
+
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+CFace * CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::createFace( std::vector<tVertex> &  v, int id )
+{
+	  m_topology_version ++;
+	  CFace * f = new CFace();
+	  assert( f != NULL );
+	  f->id() = id;
+	  m_faces.push_back( f );
+	  m_map_face.insert( std::pair<int,tFace>(id,f) );
+
+		//create halfedges
+	  std::vector<tHalfEdge> hes;
+
+		for(size_t i = 0; i < v.size(); i ++ )
+		{
+			tHalfEdge pH = new CHalfEdge;
+			assert( pH );
+			CVertex * vert =  v[i];
+			pH->vertex() = vert;
+			vert->halfedge() = pH;
+			hes.push_back( pH );
+		}
+
+		//linking to each other
+		for( size_t i = 0; i < hes.size(); i ++ )
+		{
+			hes[i]->he_next() = hes[(i+1)%hes.size()];
+			hes[i]->he_prev() = hes[(i+hes.size()-1)%hes.size()];
+		}
+
+		//linking to face
+		for(size_t i = 0; i < hes.size(); i ++ )
+		{
+			hes[i]->face()   = f;
+			f->halfedge()    = hes[i];
+		}
+
+		//connecting with edge
+		for( size_t i = 0; i < hes.size(); i ++ )
+		{
+			tEdge e = createEdge( v[i], v[(i+hes.size()-1)%hes.size()] );
+			if( e->halfedge(0)  == NULL )
+			{
+				e->halfedge(0) = hes[i];
+			}
+			else
+			{
+				assert( e->halfedge(1) == NULL );
+				if( e->halfedge(1) != NULL )
+				{
+					std::cout << "Illegal Face Construction " << id << std::endl;
+				}
+				e->halfedge(1) = hes[i];
+			}
+			hes[i]->edge() = e;
+		}
+
+		return f;
+};
+
+/*!	Spread the lower 21 bits of x, such that there are two zero bits between every two bits.
+*/
+inline unsigned long long _morton_spread( unsigned long long x )
+{
+	x &= 0x1fffff;
+	x = ( x | ( x << 32 ) ) & 0x1f00000000ffffULL;
+	x = ( x | ( x << 16 ) ) & 0x1f0000ff0000ffULL;
+	x = ( x | ( x << 8  ) ) & 0x100f00f00f00f00fULL;
+	x = ( x | ( x << 4  ) ) & 0x10c30c30c30c30c3ULL;
+	x = ( x | ( x << 2  ) ) & 0x1249249249249249ULL;
+	return x;
+};
+
+/*!	Renumber and relocate the vertices, faces, edges and halfedges.
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::compact_and_reorder()
+{
+	if( m_verts.empty() ) return;
+	m_topology_version ++;
+
+	//positions, planar meshes ( e.g. Delaunay triangulations ) only carry uv
+	std::vector<tVertex> verts( m_verts.begin(), m_verts.end() );
+	std::vector<CPoint>  pos( verts.size() );
+	CPoint lo, hi;
+	for( int k = 0; k < 2; k ++ )
+	{
+		for( size_t i = 0; i < verts.size(); i ++ )
+		{
+			pos[i] = ( k == 0 ) ? verts[i]->point() : CPoint( verts[i]->uv()[0], verts[i]->uv()[1], 0 );
+		}
+		lo = hi = pos[0];
+		for( size_t i = 1; i < pos.size(); i ++ )
+		{
+			for( int j = 0; j < 3; j ++ )
+			{
+				lo[j] = std::min( lo[j], pos[i][j] );
+				hi[j] = std::max( hi[j], pos[i][j] );
+			}
+		}
+		if( ( hi - lo ).norm() > 0 ) break;
+	}
+
+	//Morton order of the vertices
+	std::vector< std::pair<unsigned long long,int> > keys( verts.size() );
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		unsigned long long key = 0;
+		for( int j = 0; j < 3; j ++ )
+		{
+			double t = ( hi[j] > lo[j] ) ? ( pos[i][j] - lo[j] ) / ( hi[j] - lo[j] ) : 0;
+			key |= _morton_spread( (unsigned long long)( t * 0x1fffff ) ) << j;
+		}
+		keys[i] = std::make_pair( key, (int) i );
+	}
+	std::sort( keys.begin(), keys.end() );
+
+	std::map<tVertex,tVertex> vmap;
+	std::map<tVertex,int>     vorder;
+	std::list<tVertex> verts_new;
+	m_map_vert.clear();
+	for( size_t i = 0; i < keys.size(); i ++ )
+	{
+		tVertex v  = verts[ keys[i].second ];
+		tVertex nv = new CVertex( *v );
+		nv->id() = (int) i + 1;
+		vmap[v]   = nv;
+		vorder[v] = (int) i;
+		verts_new.push_back( nv );
+		m_map_vert.insert( std::pair<int,tVertex>( nv->id(), nv ) );
+	}
+
+	//faces ordered by their first vertex, namely the one with the smallest new index
+	std::vector< std::pair<std::pair<int,int>,tFace> > fkeys;
+	int fi = 0;
+	for( typename std::list<tFace>::iterator fiter = m_faces.begin(); fiter != m_faces.end(); ++ fiter, ++ fi )
+	{
+		tFace f = *fiter;
+		int first = (int) verts.size();
+		tHalfEdge he = faceHalfedge( f );
+		do{
+			first = std::min( first, vorder[ halfedgeTarget( he ) ] );
+			he = halfedgeNext( he );
+		}while( he != faceHalfedge( f ) );
+		fkeys.push_back( std::make_pair( std::make_pair( first, fi ), f ) );
+	}
+	std::sort( fkeys.begin(), fkeys.end() );
+
+	//relocate faces, their halfedges and the edges in the order they are met
+	std::map<tFace,tFace>         fmap;
+	std::map<tHalfEdge,tHalfEdge> hmap;
+	std::map<tEdge,tEdge>         emap;
+	std::list<tFace> faces_new;
+	std::list<tEdge> edges_new;
+	std::vector<tHalfEdge> hes_old;
+	m_map_face.clear();
+
+	for( size_t i = 0; i < fkeys.size(); i ++ )
+	{
+		tFace f  = fkeys[i].second;
+		tFace nf = new CFace( *f );
+		nf->id() = (int) i + 1;
+		fmap[f]  = nf;
+		faces_new.push_back( nf );
+		m_map_face.insert( std::pair<int,tFace>( nf->id(), nf ) );
+
+		tHalfEdge he = faceHalfedge( f );
+		do{
+			hmap[he] = new CHalfEdge( *he );
+			hes_old.push_back( he );
+
+			tEdge e = halfedgeEdge( he );
+			if( emap.find( e ) == emap.end() )
+			{
+				tEdge ne = new CEdge( *e );
+				emap[e] = ne;
+				edges_new.push_back( ne );
+			}
+			he = halfedgeNext( he );
+		}while( he != faceHalfedge( f ) );
+	}
+
+	//redirect the pointers of the new elements
+	for( typename std::list<tVertex>::iterator viter = m_verts.begin(); viter != m_verts.end(); ++ viter )
+	{
+		tVertex v  = *viter;
+		tVertex nv = vmap[v];
+		if( v->halfedge() != NULL ) nv->halfedge() = hmap[ (tHalfEdge) v->halfedge() ];
+		nv->edges().clear();
+	}
+
+	for( typename std::map<tFace,tFace>::iterator fiter = fmap.begin(); fiter != fmap.end(); ++ fiter )
+	{
+		fiter->second->halfedge() = hmap[ (tHalfEdge) fiter->first->halfedge() ];
+	}
+
+	for( size_t i = 0; i < hes_old.size(); i ++ )
+	{
+		tHalfEdge he = hes_old[i];
+		tHalfEdge nh = hmap[he];
+		nh->vertex()  = vmap[ (tVertex) he->vertex() ];
+		nh->face()    = fmap[ (tFace) he->face() ];
+		nh->edge()    = emap[ (tEdge) he->edge() ];
+		nh->he_next() = hmap[ (tHalfEdge) he->he_next() ];
+		nh->he_prev() = hmap[ (tHalfEdge) he->he_prev() ];
+	}
+
+	for( typename std::map<tEdge,tEdge>::iterator eiter = emap.begin(); eiter != emap.end(); ++ eiter )
+	{
+		tEdge e  = eiter->first;
+		tEdge ne = eiter->second;
+		for( int k = 0; k < 2; k ++ )
+		{
+			ne->halfedge(k) = ( e->halfedge(k) == NULL ) ? NULL : hmap[ (tHalfEdge) e->halfedge(k) ];
+		}
+		//keep the labelBoundary convention, the first vertex has the smaller id
+		if( ne->halfedge(1) != NULL && edgeVertex1( ne )->id() > edgeVertex2( ne )->id() )
+		{
+			std::swap( ne->halfedge(0), ne->halfedge(1) );
+		}
+	}
+
+	//the ids changed, every edge goes to the list of its end with the smaller new id, see vertexEdge
+	for( typename std::list<tEdge>::iterator eiter = edges_new.begin(); eiter != edges_new.end(); ++ eiter )
+	{
+		tEdge   ne = *eiter;
+		tVertex v1 = edgeVertex1( ne );
+		tVertex v2 = edgeVertex2( ne );
+		tVertex pV = ( v1->id() < v2->id() ) ? v1 : v2;
+		( (std::list<CEdge*> &) pV->edges() ).push_back( ne );
+	}
+
+	//hand over the trait strings, then release the old elements
+	for( typename std::map<tVertex,tVertex>::iterator iter = vmap.begin(); iter != vmap.end(); ++ iter )
+	{
+		CTraitTable<MeshLib::CVertex>::move( iter->first, iter->second );
+		delete iter->first;
+	}
+	for( typename std::map<tFace,tFace>::iterator iter = fmap.begin(); iter != fmap.end(); ++ iter )
+	{
+		CTraitTable<MeshLib::CFace>::move( iter->first, iter->second );
+		delete iter->first;
+	}
+	for( typename std::map<tEdge,tEdge>::iterator iter = emap.begin(); iter != emap.end(); ++ iter )
+	{
+		CTraitTable<MeshLib::CEdge>::move( iter->first, iter->second );
+		delete iter->first;
+	}
+	for( typename std::map<tHalfEdge,tHalfEdge>::iterator iter = hmap.begin(); iter != hmap.end(); ++ iter )
+	{
+		CTraitTable<MeshLib::CHalfEdge>::move( iter->first, iter->second );
+		delete iter->first;
+	}
+
+	m_verts.swap( verts_new );
+	m_faces.swap( faces_new );
+	m_edges.swap( edges_new );
+};
+
+/*!	Build all the triangles at once.
+	\param faces     vertex ids of every triangle
+	\param face_ids  ids of the faces, 1,2,... if empty
+	\param opposites opposite corners, NULL to pair the halfedges by sorting
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::build( const std::vector< std::array<int,3> > & faces, const std::vector<int> & face_ids, const int * opposites )
+{
+	assert( m_faces.empty() );
+	assert( face_ids.empty() || face_ids.size() == faces.size() );
+	m_topology_version ++;
+
+	size_t nf = faces.size();
+	size_t nc = nf * 3;
+
+	//index of the vertex of every corner, a table for dense ids, the map otherwise
+	std::vector<tVertex> verts( m_verts.begin(), m_verts.end() );
+	unsigned long long nv = verts.size();
+	if( nv == 0 ) return;
+
+	int min_id = verts[0]->id(), max_id = verts[0]->id();
+	for( size_t i = 1; i < verts.size(); i ++ )
+	{
+		min_id = std::min( min_id, verts[i]->id() );
+		max_id = std::max( max_id, verts[i]->id() );
+	}
+	bool dense = (unsigned long long)( max_id - min_id ) < 4 * nv + 16;
+	std::vector<int>  id_index( dense ? max_id - min_id + 1 : 0, -1 );
+	std::map<int,int> id_map;
+	for( size_t i = 0; i < verts.size(); i ++ )
+	{
+		if( dense ) id_index[ verts[i]->id() - min_id ] = (int) i;
+		else        id_map[ verts[i]->id() ] = (int) i;
+	}
+
+	std::vector<int> corner( nc );
+	for( size_t c = 0; c < nc; c ++ )
+	{
+		int id = faces[c/3][c%3];
+		int index = -1;
+		if( dense )
+		{
+			if( id >= min_id && id <= max_id ) index = id_index[ id - min_id ];
+		}
+		else
+		{
+			std::map<int,int>::iterator iter = id_map.find( id );
+			if( iter != id_map.end() ) index = iter->second;
+		}
+		assert( index >= 0 );
+		corner[c] = index;
+	}
+
+	//faces and halfedges, the same layout as createFace, halfedge c targets corner c
+	std::vector<tHalfEdge> hes( nc );
+	for( size_t f = 0; f < nf; f ++ )
+	{
+		tFace pF = new CFace();
+		assert( pF != NULL );
+		pF->id() = face_ids.empty() ? (int) f + 1 : face_ids[f];
+		m_faces.push_back( pF );
+		m_map_face.insert( std::pair<int,tFace>( pF->id(), pF ) );
+
+		tHalfEdge * h = &hes[3*f];
+		for( int i = 0; i < 3; i ++ )
+		{
+			h[i] = new CHalfEdge;
+			assert( h[i] != NULL );
+			h[i]->vertex() = verts[ corner[3*f+i] ];
+			verts[ corner[3*f+i] ]->halfedge() = h[i];
+		}
+		for( int i = 0; i < 3; i ++ )
+		{
+			h[i]->he_next() = h[(i+1)%3];
+			h[i]->he_prev() = h[(i+2)%3];
+			h[i]->face()    = pF;
+		}
+		pF->halfedge() = h[2];
+	}
+
+	//the twin of halfedge c is faced by the opposite of the corner facing c
+	bool paired = false;
+	if( opposites != NULL )
+	{
+		paired = true;
+		for( size_t c = 0; c < nc && paired; c ++ )
+		{
+			int o = opposites[ c - c%3 + (c+1)%3 ];
+			if( o < 0 ) continue;
+			size_t t = (size_t) o - o%3 + (o+2)%3;
+			paired = (size_t) o < nc && opposites[o] == (int)( c - c%3 + (c+1)%3 )
+				&& hes[t]->vertex() == hes[ c - c%3 + (c+2)%3 ]->vertex();
+		}
+		if( !paired )
+		{
+			std::cout << "Inconsistent opposite corners, the halfedges are paired by sorting" << std::endl;
+		}
+	}
+
+	if( paired )
+	{
+		for( size_t c = 0; c < nc; c ++ )
+		{
+			int o = opposites[ c - c%3 + (c+1)%3 ];
+			if( o < 0 )
+			{
+				_link_edge( hes[c], NULL );
+				continue;
+			}
+			size_t t = (size_t) o - o%3 + (o+2)%3;
+			if( c < t ) _link_edge( hes[c], hes[t] );
+		}
+	}
+	else
+	{
+		//sort the halfedges by their undirected vertex pair
+		std::vector<unsigned long long> keys( nc );
+		std::vector<int>                order( nc );
+		for( size_t c = 0; c < nc; c ++ )
+		{
+			unsigned long long s = corner[ c - c%3 + (c+2)%3 ];
+			unsigned long long t = corner[c];
+			keys[c]  = std::min( s, t ) * nv + std::max( s, t );
+			order[c] = (int) c;
+		}
+		int bits = 1;
+		while( bits < 64 && ( nv * nv - 1 ) >> bits ) bits ++;
+		CRadixSort<int>::sort( keys, order, bits );
+
+		//pair the halfedges, label the boundary in the same sweep
+		for( size_t i = 0; i < nc; )
+		{
+			size_t j = i + 1;
+			while( j < nc && keys[j] == keys[i] ) j ++;
+
+			tHalfEdge h0 = hes[ order[i] ];
+			tHalfEdge h1 = NULL;
+			if( j - i == 2 )
+			{
+				h1 = hes[ order[i+1] ];
+				if( h1->vertex() == h0->vertex() ) h1 = NULL;
+			}
+			if( j - i > 2 || ( j - i == 2 && h1 == NULL ) )
+			{
+				std::cout << "Illegal Face Construction " << ((tFace) h0->face())->id() << std::endl;
+			}
+
+			for( size_t k = i; k < j; k ++ )
+			{
+				tHalfEdge he = hes[ order[k] ];
+				if( he == h1 ) continue;
+				_link_edge( he, ( he == h0 ) ? h1 : NULL );
+			}
+			i = j;
+		}
+	}
+
+	//remove dangling vertices, in one pass over the list
+	for( typename std::list<tVertex>::iterator viter = m_verts.begin(); viter != m_verts.end(); )
+	{
+		tVertex v = *viter;
+		if( v->halfedge() != NULL )
+		{
+			++ viter;
+			continue;
+		}
+		viter = m_verts.erase( viter );
+		m_map_vert.erase( v->id() );
+		delete v;
+	}
+};
+
+/*!	Create the edge of a halfedge.
+	\param he   the halfedge
+	\param twin its twin, NULL if he is on the boundary
+*/
+template<typename CVertex, typename CEdge, typename CFace, typename CHalfEdge>
+void CBaseMesh<CVertex,CEdge,CFace,CHalfEdge>::_link_edge( tHalfEdge he, tHalfEdge twin )
+{
+	tEdge e = new CEdge;
+	assert( e != NULL );
+	m_edges.push_back( e );
+
+	tVertex s = (tVertex) he->source();
+	tVertex t = (tVertex) he->target();
+	tVertex pV = ( s->id() < t->id() ) ? s : t;
+	( (std::list<CEdge*> &) pV->edges() ).push_back( e );
+
+	he->edge() = e;
+	if( twin != NULL )
+	{
+		twin->edge() = e;
+		//the first vertex of an edge has the smaller id
+		e->halfedge(0) = ( s->id() < t->id() ) ? he : twin;
+		e->halfedge(1) = ( s->id() < t->id() ) ? twin : he;
+		return;
+	}
+
+	//boundary edge, its halfedge is the most ccw in halfedge of the target
+	e->halfedge(0) = he;
+	s->boundary()  = true;
+	t->boundary()  = true;
+	t->halfedge()  = he;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_BASE_MESH_H_ defined
@@ -0,0 +1,297 @@
+/*!
+*      \file BinaryMesh.h
+*      \brief Versioned binary container of a triangle mesh, loadable by mapping the file
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_BINARY_MESH_H_
+#define _MESHLIB_BINARY_MESH_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <streambuf>
+#include "Attributes.h"
+#include "../Parser/MappedFile.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CBinaryMeshHeader, header of an .mb file
+*
+*	The file starts with this header, followed by blocks at the given offsets, every block
+*	starts at a multiple of 8 bytes. Numbers are stored in the byte order of the writer,
+*	which is little endian on all supported platforms. An offset of 0 means the block is
+*	absent.
+*
+*	- vertex ids:  int[num_vertices]
+*	- points:      double[3*num_vertices]
+*	- uv:          double[2*num_vertices]
+*	- face ids:    int[num_faces]
+*	- corners:     int[3*num_faces], V[3f+i], the vertex index of the i-th corner of face f
+*	- opposites:   int[3*num_faces], O[c], the opposite corner of c, -1 on the boundary
+*	- columns:     attribute columns of the vertices, faces and corners, see write_attribute_columns
+*/
+struct CBinaryMeshHeader
+{
+	/*! "MLMB" */
+	char               magic[4];
+	/*! format version */
+	unsigned int       version;
+	/*! number of vertices */
+	unsigned int       num_vertices;
+	/*! number of faces */
+	unsigned int       num_faces;
+	/*! offsets of the blocks */
+	unsigned long long vertex_id_offset;
+	unsigned long long point_offset;
+	unsigned long long uv_offset;
+	unsigned long long face_id_offset;
+	unsigned long long corner_offset;
+	unsigned long long opposite_offset;
+	unsigned long long column_offset;
+	/*! size of the column block */
+	unsigned long long column_size;
+};
+
+/*! current version of the .mb format */
+#define MESHLIB_BINARY_MESH_VERSION 1
+
+/*!
+*	\brief CBinaryMesh, the blocks of a triangle mesh, either owned by the caller for
+*	writing or pointing into a mapped .mb file after reading
+*/
+class CBinaryMesh
+{
+public:
+	/*!	Constructor, no blocks. */
+	CBinaryMesh()
+	{
+		num_vertices = num_faces = 0;
+		vertex_ids = face_ids = corners = opposites = NULL;
+		points = uvs = NULL;
+		columns = NULL;
+		column_size = 0;
+	};
+
+	/*!
+		Map an .mb file, the blocks point into the mapping, nothing is parsed or copied.
+		\param input file name
+		\return false if the file cannot be opened or is not a valid .mb file
+	*/
+	bool open( const char * input );
+	/*!
+		Write the blocks to an .mb file.
+		\param output file name
+		\return whether the file was written, flushed and closed
+	*/
+	bool write( const char * output );
+
+	/*! number of vertices */
+	int            num_vertices;
+	/*! number of faces */
+	int            num_faces;
+	/*! vertex ids, may be NULL, then the ids are 1,2,... */
+	const int    * vertex_ids;
+	/*! xyz of every vertex, may be NULL */
+	const double * points;
+	/*! uv of every vertex, may be NULL */
+	const double * uvs;
+	/*! face ids, may be NULL, then the ids are 1,2,... */
+	const int    * face_ids;
+	/*! vertex index of every corner */
+	const int    * corners;
+	/*! opposite corner of every corner, may be NULL */
+	const int    * opposites;
+	/*! attribute column block, may be NULL */
+	const char   * columns;
+	/*! size of the attribute column block */
+	size_t         column_size;
+
+protected:
+	/*! the mapped file */
+	CMappedFile    m_file;
+};
+
+inline bool CBinaryMesh::open( const char * input )
+{
+	if( !m_file.open( input ) ) return false;
+
+	const char * data = m_file.data();
+	size_t       size = m_file.size();
+	if( size < sizeof( CBinaryMeshHeader ) ) return false;
+
+	const CBinaryMeshHeader * h = (const CBinaryMeshHeader*) data;
+	if( memcmp( h->magic, "MLMB", 4 ) != 0 || h->version != MESHLIB_BINARY_MESH_VERSION )
+	{
+		fprintf( stderr, "%s is not a version %d .mb file\n", input, MESHLIB_BINARY_MESH_VERSION );
+		return false;
+	}
+
+	num_vertices = (int) h->num_vertices;
+	num_faces    = (int) h->num_faces;
+
+	//a block must lie inside the file
+	unsigned long long nv = h->num_vertices, nf = h->num_faces;
+	struct { unsigned long long offset, bytes; } blocks[] = {
+		{ h->vertex_id_offset, nv * sizeof(int) },   { h->point_offset, nv * 3 * sizeof(double) },
+		{ h->uv_offset, nv * 2 * sizeof(double) },   { h->face_id_offset, nf * sizeof(int) },
+		{ h->corner_offset, nf * 3 * sizeof(int) },  { h->opposite_offset, nf * 3 * sizeof(int) },
+		{ h->column_offset, h->column_size } };
+	for( size_t i = 0; i < sizeof( blocks ) / sizeof( blocks[0] ); i ++ )
+	{
+		if( blocks[i].offset != 0 && blocks[i].offset + blocks[i].bytes > size )
+		{
+			fprintf( stderr, "%s is truncated\n", input );
+			return false;
+		}
+	}
+	if( h->corner_offset == 0 && nf > 0 ) return false;
+
+	vertex_ids  = h->vertex_id_offset ? (const int*)   ( data + h->vertex_id_offset ) : NULL;
+	points      = h->point_offset     ? (const double*)( data + h->point_offset )     : NULL;
+	uvs         = h->uv_offset        ? (const double*)( data + h->uv_offset )        : NULL;
+	face_ids    = h->face_id_offset   ? (const int*)   ( data + h->face_id_offset )   : NULL;
+	corners     = h->corner_offset    ? (const int*)   ( data + h->corner_offset )    : NULL;
+	opposites   = h->opposite_offset  ? (const int*)   ( data + h->opposite_offset )  : NULL;
+	columns     = h->column_offset    ? data + h->column_offset : NULL;
+	column_size = (size_t) h->column_size;
+	return true;
+};
+
+inline bool CBinaryMesh::write( const char * output )
+{
+	FILE * fp = fopen( output, "wb" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Error is opening file %s\n", output );
+		return false;
+	}
+
+	CBinaryMeshHeader h;
+	memset( &h, 0, sizeof( h ) );
+	memcpy( h.magic, "MLMB", 4 );
+	h.version      = MESHLIB_BINARY_MESH_VERSION;
+	h.num_vertices = (unsigned int) num_vertices;
+	h.num_faces    = (unsigned int) num_faces;
+
+	unsigned long long nv = num_vertices, nf = num_faces;
+	const void * data[] = { vertex_ids, points, uvs, face_ids, corners, opposites, columns };
+	unsigned long long bytes[] = { nv * sizeof(int), nv * 3 * sizeof(double), nv * 2 * sizeof(double),
+		nf * sizeof(int), nf * 3 * sizeof(int), nf * 3 * sizeof(int), column_size };
+	unsigned long long * offset[] = { &h.vertex_id_offset, &h.point_offset, &h.uv_offset,
+		&h.face_id_offset, &h.corner_offset, &h.opposite_offset, &h.column_offset };
+	const int nblocks = sizeof( bytes ) / sizeof( bytes[0] );
+
+	unsigned long long pos = ( sizeof( h ) + 7 ) & ~7ULL;
+	for( int i = 0; i < nblocks; i ++ )
+	{
+		if( data[i] == NULL ) continue;
+		*offset[i] = pos;
+		pos = ( pos + bytes[i] + 7 ) & ~7ULL;
+	}
+	h.column_size = ( columns != NULL ) ? column_size : 0;
+
+	static const char zeros[8] = { 0 };
+	bool ok = fwrite( &h, sizeof( h ), 1, fp ) == 1;
+	pos = sizeof( h );
+	for( int i = 0; i < nblocks && ok; i ++ )
+	{
+		if( data[i] == NULL ) continue;
+		ok = fwrite( zeros, 1, (size_t)( *offset[i] - pos ), fp ) == *offset[i] - pos;
+		if( ok && bytes[i] > 0 ) ok = fwrite( data[i], 1, (size_t) bytes[i], fp ) == bytes[i];
+		pos = *offset[i] + bytes[i];
+	}
+	ok = ok && fflush( fp ) == 0;
+	ok = ( fclose( fp ) == 0 ) && ok;
+
+	if( !ok ) fprintf( stderr, "Error in writing file %s\n", output );
+	return ok;
+};
+
+/*!
+*	\brief CMemoryStreamBuf, a read only stream buffer over a block of memory, used to read
+*	the attribute columns of a mapped file with read_attribute_columns
+*/
+class CMemoryStreamBuf : public std::streambuf
+{
+public:
+	/*!	Buffer over [begin,begin+size). */
+	CMemoryStreamBuf( const char * begin, size_t size )
+	{
+		char * p = const_cast<char*>( begin );
+		setg( p, p, p + size );
+	};
+
+protected:
+	/*! Relative and absolute seeking inside the block. */
+	virtual pos_type seekoff( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode = std::ios_base::in )
+	{
+		char * p = ( dir == std::ios_base::beg ) ? eback() : ( dir == std::ios_base::cur ) ? gptr() : egptr();
+		p += off;
+		if( p < eback() || p > egptr() ) return pos_type( off_type( -1 ) );
+		setg( eback(), p, egptr() );
+		return pos_type( off_type( p - eback() ) );
+	};
+	/*! Absolute seeking. */
+	virtual pos_type seekpos( pos_type pos, std::ios_base::openmode which = std::ios_base::in )
+	{
+		return seekoff( off_type( pos ), std::ios_base::beg, which );
+	};
+};
+
+/*!
+*	\brief CBinaryColumns, writes and reads the attribute columns of an element class,
+*	elements without CAttributes have no columns
+*/
+template<typename Element, bool has_attributes = CHasAttributes<Element>::value>
+struct CBinaryColumns
+{
+	template<typename Iterator>
+	static void write( std::ostream & os, Iterator begin, Iterator end, int count )
+	{
+		write_attribute_columns<Element>( os, begin, end, count );
+	};
+	template<typename Iterator>
+	static void read( std::istream & is, Iterator begin, Iterator end )
+	{
+		read_attribute_columns<Element>( is, begin, end );
+	};
+};
+
+template<typename Element>
+struct CBinaryColumns<Element,false>
+{
+	template<typename Iterator>
+	static void write( std::ostream & os, Iterator, Iterator, int )
+	{
+		int n = 0;
+		os.write( (const char*) &n, sizeof(int) );
+	};
+	template<typename Iterator>
+	static void read( std::istream & is, Iterator, Iterator )
+	{
+		//skip the columns, written by an element class with attributes
+		int n = 0;
+		is.read( (char*) &n, sizeof(int) );
+		for( int k = 0; k < n && is.good(); k ++ )
+		{
+			int  len, comp, count;
+			char code;
+			is.read( (char*) &len, sizeof(int) );
+			is.seekg( len, std::ios::cur );
+			is.read( &code, 1 );
+			is.read( (char*) &comp, sizeof(int) );
+			is.read( (char*) &count, sizeof(int) );
+			int size = ( code == 'd' )? sizeof(double) : 4;
+			is.seekg( (std::streamoff) size * comp * count, std::ios::cur );
+		}
+	};
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_BINARY_MESH_H_ defined
@@ -0,0 +1,165 @@
+/*!
+*      \file Components.h
+*      \brief Connected components of a mesh, by union-find, with their topology
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_COMPONENTS_H_
+#define _MESHLIB_COMPONENTS_H_
+
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include "boundary.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CUnionFind, disjoint sets of the integers 0..n-1
+*
+*	Union by size and path halving, a sequence of n operations takes nearly linear time.
+*/
+class CUnionFind
+{
+public:
+	/*! n sets of one element. */
+	CUnionFind( int n ) : m_parent( n ), m_size( n, 1 )
+	{
+		for( int i = 0; i < n; i ++ ) m_parent[i] = i;
+	};
+	/*! Representative of the set of i. */
+	int find( int i )
+	{
+		while( m_parent[i] != i )
+		{
+			m_parent[i] = m_parent[ m_parent[i] ];
+			i = m_parent[i];
+		}
+		return i;
+	};
+	/*! Merge the sets of i and j, return false if they are the same. */
+	bool unite( int i, int j )
+	{
+		i = find( i );
+		j = find( j );
+		if( i == j ) return false;
+		if( m_size[i] < m_size[j] ) std::swap( i, j );
+		m_parent[j] = i;
+		m_size[i] += m_size[j];
+		return true;
+	};
+	/*!
+		Label the sets 0..k-1, in the order of their smallest elements.
+		\param label the label of every element, resized
+		\return the number of sets k
+	*/
+	int labels( std::vector<int> & label )
+	{
+		int n = (int) m_parent.size();
+		std::vector<int> root_label( n, -1 );
+		label.resize( n );
+		int k = 0;
+		for( int i = 0; i < n; i ++ )
+		{
+			int r = find( i );
+			if( root_label[r] < 0 ) root_label[r] = k ++;
+			label[i] = root_label[r];
+		}
+		return k;
+	};
+
+protected:
+	/*! parent of every element, roots are their own parent */
+	std::vector<int> m_parent;
+	/*! size of the set of every root */
+	std::vector<int> m_size;
+};
+
+/*!
+*	\brief CComponent, the counts of one connected component
+*/
+struct CComponent
+{
+	CComponent() : vertices( 0 ), edges( 0 ), faces( 0 ), boundaries( 0 ) {};
+	/*! Euler characteristic V - E + F. */
+	int euler() const { return vertices - edges + faces; };
+	/*! Genus of the orientable surface, ( 2 - b - chi ) / 2. */
+	int genus() const { return ( 2 - boundaries - euler() ) / 2; };
+
+	/*! number of vertices, edges, faces and boundary loops */
+	int vertices, edges, faces, boundaries;
+};
+
+/*!
+*	\brief CComponents, the connected components of a mesh
+*
+*	The vertices are indexed in the order of the vertex list, the two ends of every edge are
+*	united, and the components are labeled in the order of their first vertex. Each edge, face
+*	and boundary loop is counted in the component of one of its vertices, so that a mesh of
+*	several components reports the Euler characteristic and the genus of each.
+*
+*	\tparam M mesh class, with the typedefs of CGaussCurvatureMesh
+*/
+template<typename M>
+class CComponents
+{
+public:
+	/*!
+		Label the components of pMesh.
+		\param pMesh the mesh
+		\param boundary its boundary loops
+	*/
+	CComponents( M * pMesh, CBoundary<M> & boundary );
+
+	/*! Number of components. */
+	int size() const { return (int) m_components.size(); };
+	/*! Component c. */
+	const CComponent & operator[]( int c ) const { return m_components[c]; };
+	/*! All components, in the order of their first vertex. */
+	const std::vector<CComponent> & components() const { return m_components; };
+	/*! Component of the vertex v. */
+	int component( typename M::CVertex * v ) const { return m_label[ m_index.find( v )->second ]; };
+
+protected:
+	/*! index of every vertex */
+	std::unordered_map<typename M::CVertex*,int> m_index;
+	/*! component of every vertex */
+	std::vector<int>        m_label;
+	/*! the components */
+	std::vector<CComponent> m_components;
+};
+
+template<typename M>
+CComponents<M>::CComponents( M * pMesh, CBoundary<M> & boundary )
+{
+	int n = 0;
+	m_index.reserve( pMesh->numVertices() );
+	for( typename M::MeshVertexIterator viter( pMesh ); !viter.end(); ++ viter )
+		m_index[ *viter ] = n ++;
+
+	CUnionFind sets( n );
+	for( typename M::MeshEdgeIterator eiter( pMesh ); !eiter.end(); ++ eiter )
+	{
+		typename M::CEdge * e = *eiter;
+		sets.unite( m_index[ pMesh->edgeVertex1( e ) ], m_index[ pMesh->edgeVertex2( e ) ] );
+	}
+	m_components.resize( sets.labels( m_label ) );
+
+	for( int i = 0; i < n; i ++ ) m_components[ m_label[i] ].vertices ++;
+	for( typename M::MeshEdgeIterator eiter( pMesh ); !eiter.end(); ++ eiter )
+		m_components[ component( pMesh->edgeVertex1( *eiter ) ) ].edges ++;
+	for( typename M::MeshFaceIterator fiter( pMesh ); !fiter.end(); ++ fiter )
+		m_components[ component( pMesh->halfedgeTarget( pMesh->faceHalfedge( *fiter ) ) ) ].faces ++;
+	for( size_t l = 0; l < boundary.loops().size(); l ++ )
+	{
+		//a loop whose walk found no halfedge belongs to no component
+		std::list<typename M::CHalfEdge*> & hes = boundary.loops()[l]->halfedges();
+		if( hes.empty() ) continue;
+		m_components[ component( pMesh->halfedgeTarget( hes.front() ) ) ].boundaries ++;
+	}
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_COMPONENTS_H_ defined
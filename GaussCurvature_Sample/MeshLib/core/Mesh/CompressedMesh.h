@@ -0,0 +1,189 @@
+/*!
+*      \file CompressedMesh.h
+*      \brief Compressed container of a triangle mesh, connectivity and quantized coordinates
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_COMPRESSED_MESH_H_
+#define _MESHLIB_COMPRESSED_MESH_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "../Codec/Edgebreaker.h"
+#include "../Parser/MappedFile.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CCompressedMeshHeader, header of an .mc file
+*
+*	The header is followed by the CEdgebreaker stream of the corners, with the points as the
+*	first channel if present and the uv as the next one if present. The length and the
+*	Adler-32 checksum of the stream are kept, a truncated or damaged file is rejected before
+*	it is decoded.
+*/
+struct CCompressedMeshHeader
+{
+	/*! "MLMC" */
+	char         magic[4];
+	/*! format version */
+	unsigned int version;
+	/*! channels of the stream, 1 for the points, 2 for the uv */
+	unsigned int channels;
+	/*! bytes of the stream after the header */
+	unsigned int size;
+	/*! Adler-32 checksum of the stream */
+	unsigned int checksum;
+};
+
+/*! Adler-32 checksum of size bytes */
+inline unsigned int adler32( const unsigned char * data, size_t size )
+{
+	unsigned int a = 1, b = 0;
+	while( size > 0 )
+	{
+		//5552 bytes keep the sums below 2^32 before the modulo
+		size_t n = ( size < 5552 ) ? size : 5552;
+		size -= n;
+		for( ; n > 0; n --, data ++ )
+		{
+			a += *data;
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	return ( b << 16 ) | a;
+};
+
+/*! current version of the .mc format */
+#define MESHLIB_COMPRESSED_MESH_VERSION 2
+
+/*!
+*	\brief CCompressedMesh, the arrays of a triangle mesh, decoded from an .mc file or to
+*	be encoded into one
+*
+*	The arrays are those of CBinaryMesh, without ids: the vertices and faces are numbered in
+*	the order of the traversal, and vertices used by no face are dropped.
+*/
+class CCompressedMesh
+{
+public:
+	/*!	Constructor, no mesh. */
+	CCompressedMesh() { num_vertices = num_faces = 0; };
+
+	/*!
+		Read and decode an .mc file.
+		\param input file name
+		\return false if the file cannot be opened, is not a valid .mc file, or its length or
+		checksum does not match the header
+	*/
+	bool open( const char * input );
+	/*!
+		Encode the arrays and write an .mc file.
+		\param output file name
+		\param bits   bits per quantized coordinate, 1..30
+		\return whether the file was written
+	*/
+	bool write( const char * output, int bits );
+
+	/*! number of vertices */
+	int                 num_vertices;
+	/*! number of faces */
+	int                 num_faces;
+	/*! vertex index of every corner, corner 3f+i is the i-th corner of face f */
+	std::vector<int>    corners;
+	/*! opposite corner of every corner, -1 on the boundary, may be empty */
+	std::vector<int>    opposites;
+	/*! xyz of every vertex, may be empty */
+	std::vector<double> points;
+	/*! uv of every vertex, may be empty */
+	std::vector<double> uvs;
+};
+
+inline bool CCompressedMesh::open( const char * input )
+{
+	CMappedFile file;
+	if( !file.open( input ) ) return false;
+
+	const unsigned char * data = (const unsigned char*) file.data();
+	size_t                size = file.size();
+	CCompressedMeshHeader h;
+	if( size < sizeof( h ) ) return false;
+	memcpy( &h, data, sizeof( h ) );
+	if( memcmp( h.magic, "MLMC", 4 ) != 0 || h.version != MESHLIB_COMPRESSED_MESH_VERSION || h.channels > 3 )
+	{
+		fprintf( stderr, "%s is not a version %d .mc file\n", input, MESHLIB_COMPRESSED_MESH_VERSION );
+		return false;
+	}
+
+	if( h.size != size - sizeof( h ) || h.checksum != adler32( data + sizeof( h ), h.size ) )
+	{
+		fprintf( stderr, "%s is truncated or corrupt\n", input );
+		return false;
+	}
+
+	std::vector<CCodecChannel> channels;
+	if( !CEdgebreaker::decode( data + sizeof( h ), size - sizeof( h ), corners, opposites, num_vertices, channels ) ||
+		channels.size() != (size_t)( ( h.channels & 1 ) + ( ( h.channels >> 1 ) & 1 ) ) )
+	{
+		fprintf( stderr, "%s is corrupt\n", input );
+		return false;
+	}
+	num_faces = (int) corners.size() / 3;
+
+	size_t k = 0;
+	points.clear();
+	uvs.clear();
+	if( h.channels & 1 ) points.swap( channels[k++].values );
+	if( h.channels & 2 ) uvs.swap( channels[k++].values );
+	return true;
+};
+
+inline bool CCompressedMesh::write( const char * output, int bits )
+{
+	CCompressedMeshHeader h;
+	memset( &h, 0, sizeof( h ) );
+	memcpy( h.magic, "MLMC", 4 );
+	h.version = MESHLIB_COMPRESSED_MESH_VERSION;
+
+	std::vector<CCodecChannel> channels;
+	if( !points.empty() )
+	{
+		h.channels |= 1;
+		channels.push_back( CCodecChannel() );
+		channels.back().dimension = 3;
+		channels.back().values    = points;
+	}
+	if( !uvs.empty() )
+	{
+		h.channels |= 2;
+		channels.push_back( CCodecChannel() );
+		channels.back().dimension = 2;
+		channels.back().values    = uvs;
+	}
+
+	std::vector<unsigned char> stream;
+	CEdgebreaker::encode( corners, opposites, num_vertices, channels, bits, stream );
+	h.size     = (unsigned int) stream.size();
+	h.checksum = adler32( stream.empty() ? NULL : &stream[0], stream.size() );
+
+	FILE * fp = fopen( output, "wb" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Error is opening file %s\n", output );
+		return false;
+	}
+	bool ok = fwrite( &h, sizeof( h ), 1, fp ) == 1;
+	if( ok && !stream.empty() ) ok = fwrite( &stream[0], 1, stream.size(), fp ) == stream.size();
+	fclose( fp );
+
+	if( !ok ) fprintf( stderr, "Error in writing file %s\n", output );
+	return ok;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_COMPRESSED_MESH_H_ defined
@@ -0,0 +1,575 @@
+/*!
+*      \file CornerTable.h
+*      \brief Triangle mesh stored as a corner table
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_CORNER_TABLE_H_
+#define _MESHLIB_CORNER_TABLE_H_
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <map>
+#include <list>
+#include <fstream>
+#include <algorithm>
+#include "../Geometry/Point.h"
+#include "BinaryMesh.h"
+#include "../Parser/TextWriter.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CCornerTable, triangle only mesh stored as two integer arrays
+*
+*	Corner c = 3f+i is the i-th corner of face f. V[c] is the vertex of corner c, O[c] is the
+*	opposite corner, namely the corner across the edge facing c, -1 if that edge is on the
+*	boundary. Next and previous corners inside a face are implicit, so the connectivity costs
+*	24 bytes per triangle and every loop over faces or corners is a plain array scan.
+*
+*	Optional per element arrays, such as the vertex normals and curvatures computed by
+*	CGaussCurvature<CCornerTable>, are empty until they are filled and written by write_m
+*	as traits when present.
+*/
+class CCornerTable
+{
+public:
+	/*!	Constructor, the mesh is empty. */
+	CCornerTable(){ m_boundary_corners = 0; };
+
+	/*!
+		Build the corner table from a triangle soup.
+		\param points vertex positions
+		\param triangles three vertex indices per triangle, ccw oriented
+	*/
+	void build( const std::vector<CPoint> & points, const std::vector<int> & triangles );
+	/*!
+		Build the corner table from a halfedge mesh, all faces must be triangles.
+		Vertex and face ids are kept, indices follow the list order of pMesh.
+		\param pMesh input mesh
+	*/
+	template<typename M>
+	void from_mesh( M * pMesh );
+	/*!
+		Read a triangle mesh in .m format, only vertex positions and faces are used.
+		Faces with more than three vertices and faces of unknown vertices are errors.
+		\param input input file name
+		\return whether the file could be read, the table is left empty if not
+	*/
+	bool read_m( const char * input );
+	/*!
+		Write the mesh in .m format, the optional arrays are written as vertex and face traits.
+		\param output output file name
+	*/
+	void write_m( const char * output );
+	/*!
+		Read an .mb file, see CBinaryMesh. The index blocks of the mapped file are the
+		arrays of the table, they are copied in bulk. The corners must name vertices of the
+		file and the opposites must pair the corners, which is checked before they are used.
+		Without a point block the uv coordinates become the points.
+		\param input input file name
+		\return whether the file could be read, the table is left empty if not
+	*/
+	bool read_mb( const char * input );
+	/*!
+		Write the mesh as an .mb file, with points and opposites.
+		\param output output file name
+	*/
+	void write_mb( const char * output );
+	/*!	Remove all elements. */
+	void clear();
+
+	/*! Number of vertices. */
+	int numVertices() { return (int) m_points.size(); };
+	/*! Number of faces. */
+	int numFaces()    { return (int) m_V.size() / 3; };
+	/*! Number of corners. */
+	int numCorners()  { return (int) m_V.size(); };
+	/*! Number of edges, every interior edge is seen by two corners, a boundary edge by one. */
+	int numEdges()    { return ( numCorners() + m_boundary_corners ) / 2; };
+
+	/*! Vertex of corner c. */
+	int V( int c ) { return m_V[c]; };
+	/*! Opposite corner of c, -1 on the boundary. */
+	int O( int c ) { return m_O[c]; };
+	/*! Next corner in the face of c. */
+	static int next( int c ) { return ( c % 3 == 2 ) ? c - 2 : c + 1; };
+	/*! Previous corner in the face of c. */
+	static int prev( int c ) { return ( c % 3 == 0 ) ? c + 2 : c - 1; };
+	/*! Face of corner c. */
+	static int face( int c ) { return c / 3; };
+	/*! Whether the edge facing corner c is on the boundary. */
+	bool cornerBoundary( int c ) { return m_O[c] < 0; };
+	/*! Rotate corner c about its vertex ccwly, -1 at the boundary. */
+	int ccw_swing( int c ) { int o = m_O[next(c)]; return ( o < 0 ) ? -1 : next( o ); };
+	/*! Rotate corner c about its vertex clwly, -1 at the boundary. */
+	int clw_swing( int c ) { int o = m_O[prev(c)]; return ( o < 0 ) ? -1 : prev( o ); };
+
+	/*! The most clw corner of v, -1 for an isolated vertex. */
+	int vertexCorner( int v )     { return m_vertex_corner[v]; };
+	/*! Whether v is on the boundary. */
+	bool vertexBoundary( int v )  { return m_vertex_boundary[v] != 0; };
+	/*! Position of v. */
+	CPoint & vertexPoint( int v ) { return m_points[v]; };
+	/*! Id of v. */
+	int & vertexId( int v )       { return m_vertex_id[v]; };
+	/*! Id of f. */
+	int & faceId( int f )         { return m_face_id[f]; };
+
+	/*! Vertex array, three entries per face. */
+	std::vector<int> & corners()     { return m_V; };
+	/*! Opposite corner array. */
+	std::vector<int> & opposites()   { return m_O; };
+	/*! Vertex positions. */
+	std::vector<CPoint> & points()   { return m_points; };
+	/*! Boundary flag of every vertex. */
+	std::vector<char> & boundaries() { return m_vertex_boundary; };
+
+	/*! Optional vertex normals. */
+	std::vector<CPoint> & vertexNormals()   { return m_vertex_normal; };
+	/*! Optional vertex Gaussian curvatures. */
+	std::vector<double> & vertexCurvatures(){ return m_vertex_k; };
+	/*! Optional face normals. */
+	std::vector<CPoint> & faceNormals()     { return m_face_normal; };
+	/*! Optional face areas. */
+	std::vector<double> & faceAreas()       { return m_face_area; };
+
+protected:
+	/*! Boundary flags and vertex corners from V and O. */
+	void _label();
+
+	/*! Vertex of every corner. */
+	std::vector<int>    m_V;
+	/*! Opposite of every corner. */
+	std::vector<int>    m_O;
+	/*! Number of corners facing a boundary edge. */
+	int                 m_boundary_corners;
+
+	/*! Vertex positions. */
+	std::vector<CPoint> m_points;
+	/*! Vertex ids. */
+	std::vector<int>    m_vertex_id;
+	/*! Most clw corner of every vertex. */
+	std::vector<int>    m_vertex_corner;
+	/*! Boundary flag of every vertex. */
+	std::vector<char>   m_vertex_boundary;
+	/*! Face ids. */
+	std::vector<int>    m_face_id;
+
+	/*! Optional vertex normals. */
+	std::vector<CPoint> m_vertex_normal;
+	/*! Optional vertex curvatures. */
+	std::vector<double> m_vertex_k;
+	/*! Optional face normals. */
+	std::vector<CPoint> m_face_normal;
+	/*! Optional face areas. */
+	std::vector<double> m_face_area;
+};
+
+/*! Remove all elements. */
+inline void CCornerTable::clear()
+{
+	m_V.clear();
+	m_O.clear();
+	m_boundary_corners = 0;
+	m_points.clear();
+	m_vertex_id.clear();
+	m_vertex_corner.clear();
+	m_vertex_boundary.clear();
+	m_face_id.clear();
+	m_vertex_normal.clear();
+	m_vertex_k.clear();
+	m_face_normal.clear();
+	m_face_area.clear();
+};
+
+/*!	Build the corner table from a triangle soup.
+	The corners are sorted by the (min,max) vertex pair of the edge they face, two equal
+	neighbours with opposite directions are opposite corners.
+*/
+inline void CCornerTable::build( const std::vector<CPoint> & points, const std::vector<int> & triangles )
+{
+	int nv = (int) points.size();
+	int nc = (int) triangles.size() / 3 * 3;
+	int nf = nc / 3;
+
+	m_points = points;
+	m_V.assign( triangles.begin(), triangles.begin() + nc );
+	m_O.assign( nc, -1 );
+
+	if( (int) m_vertex_id.size() != nv )
+	{
+		m_vertex_id.resize( nv );
+		for( int v = 0; v < nv; v ++ ) m_vertex_id[v] = v + 1;
+	}
+	if( (int) m_face_id.size() != nf )
+	{
+		m_face_id.resize( nf );
+		for( int f = 0; f < nf; f ++ ) m_face_id[f] = f + 1;
+	}
+
+	//the edge facing corner c runs from V[next(c)] to V[prev(c)]
+	std::vector< std::pair<long long,int> > keys( nc );
+	for( int c = 0; c < nc; c ++ )
+	{
+		long long a = m_V[next(c)];
+		long long b = m_V[prev(c)];
+		keys[c] = std::make_pair( ( std::min( a, b ) << 32 ) | std::max( a, b ), c );
+	}
+	std::sort( keys.begin(), keys.end() );
+
+	for( int i = 0; i + 1 < nc; )
+	{
+		int c0 = keys[i].second;
+		int c1 = keys[i+1].second;
+		if( keys[i].first == keys[i+1].first && m_V[next(c0)] == m_V[prev(c1)] )
+		{
+			m_O[c0] = c1;
+			m_O[c1] = c0;
+			i += 2;
+		}
+		else
+		{
+			i += 1;
+		}
+	}
+
+	_label();
+};
+
+/*!	Boundary flags, and the most clw corner of every vertex, from V and O. */
+inline void CCornerTable::_label()
+{
+	int nv = (int) m_points.size();
+	int nc = (int) m_V.size();
+
+	m_boundary_corners = 0;
+	m_vertex_boundary.assign( nv, 0 );
+	m_vertex_corner.assign( nv, -1 );
+
+	for( int c = 0; c < nc; c ++ )
+	{
+		if( m_O[c] >= 0 ) continue;
+		m_boundary_corners ++;
+		m_vertex_boundary[ m_V[next(c)] ] = 1;
+		m_vertex_boundary[ m_V[prev(c)] ] = 1;
+	}
+
+	for( int c = 0; c < nc; c ++ )
+	{
+		int v = m_V[c];
+		//on the boundary, the most clw corner has no clw neighbour
+		if( m_vertex_corner[v] < 0 || m_O[prev(c)] < 0 )
+		{
+			m_vertex_corner[v] = c;
+		}
+	}
+
+	m_vertex_normal.clear();
+	m_vertex_k.clear();
+	m_face_normal.clear();
+	m_face_area.clear();
+};
+
+/*!	Build the corner table from a halfedge mesh.
+	\param pMesh input mesh, all faces must be triangles
+*/
+template<typename M>
+void CCornerTable::from_mesh( M * pMesh )
+{
+	std::vector<CPoint> points;
+	std::vector<int>    triangles;
+	std::map<typename M::CVertex*, int> vertex_index;
+
+	m_vertex_id.clear();
+	m_face_id.clear();
+
+	for( typename std::list<typename M::CVertex*>::iterator viter = pMesh->vertices().begin(); viter != pMesh->vertices().end(); ++ viter )
+	{
+		typename M::CVertex * v = *viter;
+		vertex_index[v] = (int) points.size();
+		points.push_back( v->point() );
+		m_vertex_id.push_back( v->id() );
+	}
+
+	triangles.reserve( pMesh->numFaces() * 3 );
+	for( typename std::list<typename M::CFace*>::iterator fiter = pMesh->faces().begin(); fiter != pMesh->faces().end(); ++ fiter )
+	{
+		typename M::CFace * f = *fiter;
+		typename M::CHalfEdge * he = pMesh->faceHalfedge( f );
+		for( int i = 0; i < 3; i ++ )
+		{
+			triangles.push_back( vertex_index[ pMesh->halfedgeSource( he ) ] );
+			he = pMesh->halfedgeNext( he );
+		}
+		assert( he == pMesh->faceHalfedge( f ) );
+		m_face_id.push_back( f->id() );
+	}
+
+	build( points, triangles );
+};
+
+/*!	Read a triangle mesh in .m format.
+	\param input input file name
+*/
+inline bool CCornerTable::read_m( const char * input )
+{
+	clear();
+	std::fstream is( input, std::fstream::in );
+	if( is.fail() )
+	{
+		fprintf(stderr,"Error in opening file %s\n", input );
+		return false;
+	}
+
+	std::vector<CPoint> points;
+	std::vector<int>    triangles;
+	std::map<int,int>   vertex_index;
+
+	std::string line;
+	int lineno = 0;
+	while( std::getline( is, line ) )
+	{
+		lineno ++;
+		const char * str = line.c_str();
+		if( line.compare( 0, 7, "Vertex " ) == 0 )
+		{
+			int id;
+			double x = 0, y = 0, z = 0;
+			if( sscanf( str + 7, "%d %lf %lf %lf", &id, &x, &y, &z ) < 3 ) continue;
+			vertex_index[id] = (int) points.size();
+			points.push_back( CPoint( x, y, z ) );
+			m_vertex_id.push_back( id );
+			continue;
+		}
+		if( line.compare( 0, 5, "Face " ) == 0 )
+		{
+			//the vertex ids run up to the traits or the end of the line
+			char * end = NULL;
+			int id = (int) strtol( str + 5, &end, 10 );
+			if( end == str + 5 ) continue;
+			int n = 0, v[3];
+			while( true )
+			{
+				char * next = NULL;
+				int vid = (int) strtol( end, &next, 10 );
+				if( next == end ) break;
+				end = next;
+				if( n == 3 )
+				{
+					fprintf(stderr,"Error in file %s line %d: face %d is not a triangle\n", input, lineno, id );
+					clear();
+					return false;
+				}
+				v[n++] = vid;
+			}
+			if( n < 3 ) continue;
+			for( int i = 0; i < 3; i ++ )
+			{
+				std::map<int,int>::iterator iter = vertex_index.find( v[i] );
+				if( iter == vertex_index.end() )
+				{
+					fprintf(stderr,"Error in file %s line %d: face %d uses the unknown vertex %d\n", input, lineno, id, v[i] );
+					clear();
+					return false;
+				}
+				triangles.push_back( iter->second );
+			}
+			m_face_id.push_back( id );
+		}
+	}
+	is.close();
+
+	build( points, triangles );
+	return true;
+};
+
+/*!	Write the mesh in .m format.
+	\param output output file name
+*/
+inline void CCornerTable::write_m( const char * output )
+{
+	CTextWriter _os;
+	if( !_os.open( output ) )
+	{
+		fprintf(stderr,"Error is opening file %s\n", output );
+		return;
+	}
+
+	bool with_normal = m_vertex_normal.size() == m_points.size() && !m_points.empty();
+	bool with_k      = m_vertex_k.size() == m_points.size() && !m_points.empty();
+
+	format_parallel( _os, m_points.size(), [&]( CTextBuffer & out, size_t v )
+	{
+		CPoint & p = m_points[v];
+		out.put( "Vertex " );
+		out.put_int( m_vertex_id[v] );
+		for( int k = 0; k < 3; k ++ )
+		{
+			out.put( ' ' );
+			out.put_double( p[k] );
+		}
+		if( with_normal || with_k )
+		{
+			out.put( " {" );
+			if( with_k )
+			{
+				out.put( "k=(" );
+				out.put_double( m_vertex_k[v] );
+				out.put( ')' );
+			}
+			if( with_k && with_normal ) out.put( ' ' );
+			if( with_normal )
+			{
+				CPoint & n = m_vertex_normal[v];
+				out.put( "normal=(" );
+				for( int k = 0; k < 3; k ++ )
+				{
+					if( k > 0 ) out.put( ' ' );
+					out.put_double( n[k] );
+				}
+				out.put( ')' );
+			}
+			out.put( '}' );
+		}
+		out.put( '\n' );
+	} );
+
+	bool with_face_normal = m_face_normal.size() * 3 == m_V.size() && !m_V.empty();
+	bool with_area        = m_face_area.size() * 3 == m_V.size() && !m_V.empty();
+
+	format_parallel( _os, m_V.size() / 3, [&]( CTextBuffer & out, size_t f )
+	{
+		out.put( "Face " );
+		out.put_int( m_face_id[f] );
+		for( int i = 0; i < 3; i ++ )
+		{
+			out.put( ' ' );
+			out.put_int( m_vertex_id[ m_V[3*f+i] ] );
+		}
+		if( with_face_normal || with_area )
+		{
+			out.put( " {" );
+			if( with_area )
+			{
+				out.put( "area=(" );
+				out.put_double( m_face_area[f] );
+				out.put( ')' );
+			}
+			if( with_area && with_face_normal ) out.put( ' ' );
+			if( with_face_normal )
+			{
+				CPoint & n = m_face_normal[f];
+				out.put( "normal=(" );
+				for( int k = 0; k < 3; k ++ )
+				{
+					if( k > 0 ) out.put( ' ' );
+					out.put_double( n[k] );
+				}
+				out.put( ')' );
+			}
+			out.put( '}' );
+		}
+		out.put( '\n' );
+	} );
+
+	if( !_os.close() )
+	{
+		fprintf(stderr,"Error in writing file %s\n", output );
+	}
+};
+
+/*!	Read an .mb file.
+	\param input input file name
+*/
+inline bool CCornerTable::read_mb( const char * input )
+{
+	clear();
+	CBinaryMesh mb;
+	if( !mb.open( input ) )
+	{
+		fprintf(stderr,"Error in opening file %s\n", input );
+		return false;
+	}
+
+	int nv = mb.num_vertices;
+	int nc = mb.num_faces * 3;
+
+	//every corner names a vertex, every opposite is a corner whose opposite is the corner back
+	for( int c = 0; c < nc; c ++ )
+	{
+		if( mb.corners[c] < 0 || mb.corners[c] >= nv )
+		{
+			fprintf(stderr,"Error in file %s: corner %d names vertex %d of %d\n", input, c, mb.corners[c], nv );
+			return false;
+		}
+		if( mb.opposites == NULL ) continue;
+		int o = mb.opposites[c];
+		if( o < -1 || o >= nc || ( o >= 0 && ( face( o ) == face( c ) || mb.opposites[o] != c ) ) )
+		{
+			fprintf(stderr,"Error in file %s: corner %d has the opposite %d\n", input, c, o );
+			return false;
+		}
+	}
+
+	m_points.resize( nv );
+	for( int v = 0; v < nv; v ++ )
+	{
+		if( mb.points ) m_points[v] = CPoint( mb.points[3*v], mb.points[3*v+1], mb.points[3*v+2] );
+		else if( mb.uvs ) m_points[v] = CPoint( mb.uvs[2*v], mb.uvs[2*v+1], 0 );
+	}
+
+	m_vertex_id.resize( nv );
+	if( mb.vertex_ids && nv > 0 ) memcpy( &m_vertex_id[0], mb.vertex_ids, nv * sizeof(int) );
+	else for( int v = 0; v < nv; v ++ ) m_vertex_id[v] = v + 1;
+
+	m_face_id.resize( nc / 3 );
+	if( mb.face_ids && nc > 0 ) memcpy( &m_face_id[0], mb.face_ids, nc / 3 * sizeof(int) );
+	else for( int f = 0; f < nc / 3; f ++ ) m_face_id[f] = f + 1;
+
+	m_V.assign( mb.corners, mb.corners + nc );
+	if( mb.opposites == NULL )
+	{
+		//no adjacency block, pair the corners by sorting
+		std::vector<CPoint> points;
+		std::vector<int>    triangles;
+		points.swap( m_points );
+		triangles.swap( m_V );
+		build( points, triangles );
+		return true;
+	}
+	m_O.assign( mb.opposites, mb.opposites + nc );
+	_label();
+	return true;
+};
+
+/*!	Write the mesh as an .mb file.
+	\param output output file name
+*/
+inline void CCornerTable::write_mb( const char * output )
+{
+	int nv = numVertices();
+	std::vector<double> points( 3 * nv );
+	for( int v = 0; v < nv; v ++ )
+	{
+		for( int k = 0; k < 3; k ++ ) points[3*v+k] = m_points[v][k];
+	}
+
+	CBinaryMesh mb;
+	mb.num_vertices = nv;
+	mb.num_faces    = numFaces();
+	mb.vertex_ids   = nv > 0 ? &m_vertex_id[0] : NULL;
+	mb.points       = nv > 0 ? &points[0] : NULL;
+	mb.face_ids     = m_V.empty() ? NULL : &m_face_id[0];
+	mb.corners      = m_V.empty() ? NULL : &m_V[0];
+	mb.opposites    = m_O.empty() ? NULL : &m_O[0];
+	mb.write( output );
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_CORNER_TABLE_H_ defined
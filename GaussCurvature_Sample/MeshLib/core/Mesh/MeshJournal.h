@@ -0,0 +1,460 @@
+/*!
+*      \file MeshJournal.h
+*      \brief Append only journal of the edits of an incremental triangulation, with snapshots
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_MESH_JOURNAL_H_
+#define _MESHLIB_MESH_JOURNAL_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "../Geometry/Point.h"
+#include "../Geometry/Point2.h"
+#include "../Parser/MappedFile.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CMeshJournalHeader, header of a journal file
+*
+*	The header is followed by the entries, each a type byte and a fixed payload, numbers
+*	in the byte order of the writer as in .mb files:
+*
+*	- insert: int vertex id, double u, v, double x, y, z
+*	- split:  int removed face id ( -1 for none ), 3 x ( int face id, int vertex ids[3] )
+*	- flip:   int removed face ids[2], 2 x ( int face id, int vertex ids[3] )
+*	- commit: nothing, closes a group of entries which is replayed as a whole
+*	- edge split: int removed face ids[2], 4 x ( int face id, int vertex ids[3] ), the second
+*	  face and the last two created ones are -1 if the edge is on the boundary
+*
+*	The vertices of a created face are in the order of createFace. The entries apply to the
+*	snapshot of the generation, an .mb file next to the journal, or to an empty mesh for
+*	generation 0. Version 1 journals, without edge splits, are read as well.
+*/
+struct CMeshJournalHeader
+{
+	/*! "MLMJ" */
+	char         magic[4];
+	/*! format version */
+	unsigned int version;
+	/*! number of checkpoints taken before the entries */
+	unsigned int generation;
+};
+
+/*! current version of the journal format */
+#define MESHLIB_MESH_JOURNAL_VERSION 2
+
+/*!
+*	\brief CMeshJournal, records the inserts, splits, edge splits and flips of an incremental
+*	triangulation, so that it can be restored after a crash or its edits replayed elsewhere
+*
+*	The entries of one edit, e.g. an insertion with its splits and flips, are kept in memory
+*	and appended to the file by commit(), with a single write. A crash loses at most the edit
+*	in progress, an incomplete group at the end of the file is dropped by restore().
+*
+*	checkpoint() writes the mesh to a snapshot and starts the next generation of the journal,
+*	every interval commits if an interval is given. The switch is done by renaming over the
+*	old file, which is never removed first, so the journal always names a complete snapshot,
+*	and a snapshot that cannot be written keeps the old generation.
+*/
+template<typename M>
+class CMeshJournal
+{
+public:
+	/*! entry types */
+	enum { J_INSERT = 1, J_SPLIT, J_FLIP, J_COMMIT, J_EDGE_SPLIT };
+
+	/*!	Journal of the edits of mesh, not open. */
+	CMeshJournal( M * mesh ) { m_mesh = mesh; m_fp = NULL; m_generation = 0; m_interval = 0; m_commits = 0; };
+	/*!	Destructor, the pending entries are committed. */
+	~CMeshJournal() { close(); };
+
+	/*!
+		Open the journal. If the file exists, the mesh, which must be empty, is restored from it,
+		otherwise a new journal is started.
+		\param path     file name of the journal
+		\param interval commits between checkpoints, 0 for none
+		\return false if the journal cannot be read or written
+	*/
+	bool open( const char * path, int interval = 0 );
+	/*! Commit the pending entries and close the file. */
+	void close();
+	/*!
+		Load the snapshot of the journal into the mesh and replay its complete groups. The file
+		is rewritten without an incomplete group at its end.
+		\return false if the journal or its snapshot cannot be read
+	*/
+	bool restore();
+	/*!
+		Write the mesh to a new snapshot and start an empty journal on top of it. The pending
+		entries are committed first. Nothing is done while the mesh has no faces.
+		\return false if the snapshot or the journal cannot be written
+	*/
+	bool checkpoint();
+
+	/*! Record a new vertex, with its id, uv and point. */
+	void insert( typename M::tVertex v );
+	/*! Record the split of a face, id -1 for none, into the faces f[0..2]. */
+	void split( int removed, typename M::tFace f[3] );
+	/*! Record the flip of the edge between the faces removed[0..1] into the faces f[0..1]. */
+	void flip( int removed[2], typename M::tFace f[2] );
+	/*! Record the split of the edge between the faces removed[0..1], removed[1] is -1 on the
+		boundary, into the faces f[0..3], f[2] and f[3] are NULL on the boundary. */
+	void split_edge( int removed[2], typename M::tFace f[4] );
+	/*! Close the group of the current edit and append it to the file. */
+	bool commit();
+
+	/*!
+		Replay the complete groups of a journal file on a mesh, which is in the state of the
+		snapshot the journal applies to, e.g. to apply the edits of another process.
+		\param mesh the mesh
+		\param path file name of the journal
+		\return false if the file is not a journal, or an entry does not apply to the mesh
+	*/
+	static bool replay( M & mesh, const char * path );
+
+protected:
+	/*! Append a value to the pending entries. */
+	template<typename T>
+	void _put( const T & value ) { const char * p = (const char*) &value; m_pending.insert( m_pending.end(), p, p + sizeof( T ) ); };
+	/*! Append a created face, its id and its vertex ids in the order of createFace, -1 for NULL. */
+	void _put_face( typename M::tFace f );
+	/*! Size of the payload of an entry type, -1 for an unknown type. */
+	static int _payload( int type );
+	/*!
+		Apply the complete groups of the entries [begin,end) to a mesh.
+		\param applied one past the last applied group
+		\return false if an entry does not apply
+	*/
+	static bool _replay( M & mesh, const char * begin, const char * end, const char *& applied );
+	/*! File name of the snapshot of a generation. */
+	std::string _snapshot( unsigned int generation ) { char g[16]; sprintf( g, ".%u.mb", generation ); return m_path + g; };
+	/*! Write a journal file with the given body and make it the journal, by renaming. */
+	bool _start( const char * body, size_t size );
+	/*! Rename the file from to the file to, replacing it in one step if it exists. */
+	static bool _replace( const char * from, const char * to );
+
+	/*! the mesh */
+	M *               m_mesh;
+	/*! file name of the journal */
+	std::string       m_path;
+	/*! the journal, open for appending */
+	FILE *            m_fp;
+	/*! current generation */
+	unsigned int      m_generation;
+	/*! commits between checkpoints */
+	int               m_interval;
+	/*! commits since the last checkpoint */
+	int               m_commits;
+	/*! entries of the current group */
+	std::vector<char> m_pending;
+};
+
+template<typename M>
+bool CMeshJournal<M>::open( const char * path, int interval )
+{
+	close();
+	m_path     = path;
+	m_interval = interval;
+	m_commits  = 0;
+
+	FILE * fp = fopen( path, "rb" );
+	if( fp != NULL )
+	{
+		fclose( fp );
+		return restore();
+	}
+	m_generation = 0;
+	return _start( NULL, 0 );
+};
+
+template<typename M>
+void CMeshJournal<M>::close()
+{
+	if( m_fp == NULL ) return;
+	commit();
+	fclose( m_fp );
+	m_fp = NULL;
+};
+
+template<typename M>
+bool CMeshJournal<M>::restore()
+{
+	CMappedFile file;
+	if( !file.open( m_path.c_str() ) ) return false;
+
+	CMeshJournalHeader h;
+	if( file.size() < sizeof( h ) ) return false;
+	memcpy( &h, file.data(), sizeof( h ) );
+	if( memcmp( h.magic, "MLMJ", 4 ) != 0 || h.version < 1 || h.version > MESHLIB_MESH_JOURNAL_VERSION )
+	{
+		fprintf( stderr, "%s is not a journal of version 1 to %d\n", m_path.c_str(), MESHLIB_MESH_JOURNAL_VERSION );
+		return false;
+	}
+	m_generation = h.generation;
+
+	if( m_generation > 0 )
+	{
+		if( !m_mesh->read_mb( _snapshot( m_generation ).c_str() ) || m_mesh->numFaces() == 0 ) return false;
+	}
+
+	const char * body    = file.data() + sizeof( h );
+	const char * applied = body;
+	if( !_replay( *m_mesh, body, file.end(), applied ) )
+	{
+		fprintf( stderr, "%s does not apply to its snapshot\n", m_path.c_str() );
+		return false;
+	}
+	if( applied < file.end() )
+		fprintf( stderr, "%s ends with an incomplete edit, which is dropped\n", m_path.c_str() );
+
+	//the complete groups are kept, such that new entries follow them, the file is released
+	//before it is replaced
+	std::vector<char> kept( body, applied );
+	file.close();
+	return _start( kept.empty() ? NULL : &kept[0], kept.size() );
+};
+
+template<typename M>
+bool CMeshJournal<M>::checkpoint()
+{
+	if( m_fp == NULL ) return false;
+	if( !commit() ) return false;
+	if( m_mesh->numFaces() == 0 ) return true;
+
+	//the snapshot is complete before the journal names it
+	std::string snapshot = _snapshot( m_generation + 1 );
+	std::string temp     = snapshot + ".tmp";
+	if( !m_mesh->write_mb( temp.c_str() ) || !_replace( temp.c_str(), snapshot.c_str() ) )
+	{
+		fprintf( stderr, "Error in writing file %s\n", snapshot.c_str() );
+		remove( temp.c_str() );
+		return false;
+	}
+
+	m_generation ++;
+	if( !_start( NULL, 0 ) )
+	{
+		m_generation --;
+		return false;
+	}
+	if( m_generation > 1 ) remove( _snapshot( m_generation - 1 ).c_str() );
+	m_commits = 0;
+	return true;
+};
+
+template<typename M>
+bool CMeshJournal<M>::_start( const char * body, size_t size )
+{
+	if( m_fp != NULL )
+	{
+		fclose( m_fp );
+		m_fp = NULL;
+	}
+
+	CMeshJournalHeader h;
+	memset( &h, 0, sizeof( h ) );
+	memcpy( h.magic, "MLMJ", 4 );
+	h.version    = MESHLIB_MESH_JOURNAL_VERSION;
+	h.generation = m_generation;
+
+	std::string temp = m_path + ".tmp";
+	FILE * fp = fopen( temp.c_str(), "wb" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Error is opening file %s\n", temp.c_str() );
+		return false;
+	}
+	bool ok = fwrite( &h, sizeof( h ), 1, fp ) == 1;
+	if( ok && size > 0 ) ok = fwrite( body, 1, size, fp ) == size;
+	ok = ( fclose( fp ) == 0 ) && ok;
+
+	if( !ok || !_replace( temp.c_str(), m_path.c_str() ) )
+	{
+		fprintf( stderr, "Error in writing file %s\n", m_path.c_str() );
+		return false;
+	}
+
+	m_fp = fopen( m_path.c_str(), "ab" );
+	return m_fp != NULL;
+};
+
+template<typename M>
+bool CMeshJournal<M>::_replace( const char * from, const char * to )
+{
+#ifdef _WIN32
+	//rename fails on Windows if the target exists
+	return MoveFileExA( from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+#else
+	//rename replaces the target atomically on POSIX
+	return rename( from, to ) == 0;
+#endif
+};
+
+template<typename M>
+void CMeshJournal<M>::insert( typename M::tVertex v )
+{
+	m_pending.push_back( (char) J_INSERT );
+	_put( v->id() );
+	for( int k = 0; k < 2; k ++ ) _put( v->uv()[k] );
+	for( int k = 0; k < 3; k ++ ) _put( v->point()[k] );
+};
+
+template<typename M>
+void CMeshJournal<M>::split( int removed, typename M::tFace f[3] )
+{
+	m_pending.push_back( (char) J_SPLIT );
+	_put( removed );
+	for( int i = 0; i < 3; i ++ ) _put_face( f[i] );
+};
+
+template<typename M>
+void CMeshJournal<M>::flip( int removed[2], typename M::tFace f[2] )
+{
+	m_pending.push_back( (char) J_FLIP );
+	_put( removed[0] );
+	_put( removed[1] );
+	for( int i = 0; i < 2; i ++ ) _put_face( f[i] );
+};
+
+template<typename M>
+void CMeshJournal<M>::split_edge( int removed[2], typename M::tFace f[4] )
+{
+	m_pending.push_back( (char) J_EDGE_SPLIT );
+	_put( removed[0] );
+	_put( removed[1] );
+	for( int i = 0; i < 4; i ++ ) _put_face( f[i] );
+};
+
+template<typename M>
+void CMeshJournal<M>::_put_face( typename M::tFace f )
+{
+	if( f == NULL )
+	{
+		for( int i = 0; i < 4; i ++ ) _put( -1 );
+		return;
+	}
+	//createFace leaves the face at the halfedge of its last vertex
+	_put( f->id() );
+	typename M::tHalfEdge he = f->halfedge();
+	for( int i = 0; i < 3; i ++ )
+	{
+		he = he->he_next();
+		_put( he->target()->id() );
+	}
+};
+
+template<typename M>
+bool CMeshJournal<M>::commit()
+{
+	if( m_pending.empty() ) return true;
+	m_pending.push_back( (char) J_COMMIT );
+
+	bool ok = m_fp != NULL && fwrite( &m_pending[0], 1, m_pending.size(), m_fp ) == m_pending.size() && fflush( m_fp ) == 0;
+	m_pending.clear();
+	if( !ok )
+	{
+		fprintf( stderr, "Error in writing file %s\n", m_path.c_str() );
+		return false;
+	}
+
+	if( m_interval > 0 && ++ m_commits >= m_interval ) return checkpoint();
+	return true;
+};
+
+template<typename M>
+int CMeshJournal<M>::_payload( int type )
+{
+	switch( type )
+	{
+	case J_INSERT: return sizeof(int) + 5 * sizeof(double);
+	case J_SPLIT:  return 13 * sizeof(int);
+	case J_FLIP:   return 10 * sizeof(int);
+	case J_COMMIT: return 0;
+	case J_EDGE_SPLIT: return 18 * sizeof(int);
+	default:       return -1;
+	}
+};
+
+template<typename M>
+bool CMeshJournal<M>::replay( M & mesh, const char * path )
+{
+	CMappedFile file;
+	if( !file.open( path ) ) return false;
+
+	CMeshJournalHeader h;
+	if( file.size() < sizeof( h ) ) return false;
+	memcpy( &h, file.data(), sizeof( h ) );
+	if( memcmp( h.magic, "MLMJ", 4 ) != 0 || h.version < 1 || h.version > MESHLIB_MESH_JOURNAL_VERSION ) return false;
+
+	const char * applied = NULL;
+	return _replay( mesh, file.data() + sizeof( h ), file.end(), applied );
+};
+
+template<typename M>
+bool CMeshJournal<M>::_replay( M & mesh, const char * begin, const char * end, const char *& applied )
+{
+	//only the groups closed by a commit are applied
+	const char * last = begin;
+	for( const char * p = begin; p < end; )
+	{
+		int size = _payload( (unsigned char) *p );
+		if( size < 0 || p + 1 + size > end ) break;
+		if( *p == J_COMMIT ) last = p + 1;
+		p += 1 + size;
+	}
+	applied = begin;
+
+	for( const char * p = begin; p < last; )
+	{
+		int type = (unsigned char) *p ++;
+		int n    = _payload( type ) / (int) sizeof(int);
+		int ids[18];
+		if( type == J_INSERT )
+		{
+			double x[5];
+			memcpy( ids, p, sizeof(int) );
+			memcpy( x, p + sizeof(int), sizeof( x ) );
+			typename M::tVertex v = mesh.createVertex( ids[0] );
+			v->uv()    = CPoint2( x[0], x[1] );
+			v->point() = CPoint( x[2], x[3], x[4] );
+		}
+		else if( type == J_SPLIT || type == J_FLIP || type == J_EDGE_SPLIT )
+		{
+			memcpy( ids, p, n * sizeof(int) );
+			int removed = ( type == J_SPLIT ) ? 1 : 2;
+			for( int i = 0; i < removed; i ++ )
+			{
+				if( ids[i] < 0 ) continue;
+				typename M::tFace f = mesh.idFace( ids[i] );
+				if( f == NULL ) return false;
+				mesh.deleteFace( f );
+			}
+			for( int k = removed; k < n; k += 4 )
+			{
+				if( ids[k] < 0 ) continue;
+				typename M::tVertex v[3];
+				for( int i = 0; i < 3; i ++ )
+				{
+					v[i] = mesh.idVertex( ids[k+1+i] );
+					if( v[i] == NULL ) return false;
+				}
+				mesh.createFace( v, ids[k] );
+			}
+		}
+		else
+		{
+			applied = p;
+		}
+		p += _payload( type );
+	}
+	return true;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_MESH_JOURNAL_H_ defined
@@ -0,0 +1,152 @@
+/*!
+*      \file OneRing.h
+*      \brief Snapshot of the one-rings of all vertices in compressed sparse row arrays
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_ONE_RING_H_
+#define _MESHLIB_ONE_RING_H_
+
+#include <vector>
+#include <unordered_map>
+#include "iterators.h"
+#include "../Parallel/ParallelFor.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief COneRing, the neighboring vertices, faces and incoming halfedges of every vertex
+*
+*	The rings are walked once by the iterators of iterators.h, in their order, and stored
+*	back to back: the ring of vertex i is [offset[i],offset[i+1]) of one array per kind. The
+*	vertices are indexed in the order of the vertex list of the mesh, neighbors are stored
+*	as indices, such that per vertex arrays can be read by them.
+*
+*	The snapshot remembers CBaseMesh::topologyVersion(). update() rebuilds it if the mesh
+*	changed since, and is cheap otherwise, so an iterative algorithm calls it once per sweep
+*	and reads the rings as plain arrays. Vertex positions and traits are not part of the
+*	snapshot, they are read through the elements.
+*
+*	\tparam M mesh class, with the typedefs of CGaussCurvatureMesh
+*/
+template<typename M>
+class COneRing
+{
+public:
+	typedef typename M::CVertex   CVertex;
+	typedef typename M::CFace     CFace;
+	typedef typename M::CHalfEdge CHalfEdge;
+
+	/*!	Snapshot of pMesh, built by the first update(). */
+	COneRing( M * pMesh ) : m_pMesh( pMesh ), m_version( 0 ), m_built( false ) {};
+
+	/*! Whether the snapshot matches the current topology of the mesh. */
+	bool valid() { return m_built && m_version == m_pMesh->topologyVersion(); };
+	/*! Rebuild the snapshot if it is stale. */
+	void update() { if( !valid() ) build(); };
+	/*! Rebuild the snapshot, the rings are walked in parallel. */
+	void build();
+
+	/*! Number of vertices. */
+	int  size() const { return (int) m_verts.size(); };
+	/*! Vertex i. */
+	CVertex * vertex( int i ) const { return m_verts[i]; };
+	/*! Index of vertex v, -1 if v is not in the snapshot. */
+	int  index( CVertex * v ) const
+	{
+		typename std::unordered_map<CVertex*,int>::const_iterator iter = m_index.find( v );
+		return ( iter == m_index.end() ) ? -1 : iter->second;
+	};
+
+	/*! Indices of the neighboring vertices of vertex i ccwly, as vertex_vertices. */
+	CArrayRange<int> vertices( int i ) const
+	{
+		return CArrayRange<int>( m_vv.data() + m_vv_offset[i], m_vv.data() + m_vv_offset[i+1] );
+	};
+	/*! Neighboring faces of vertex i ccwly, as vertex_faces. */
+	CArrayRange<CFace*> faces( int i ) const
+	{
+		return CArrayRange<CFace*>( m_vf.data() + m_offset[i], m_vf.data() + m_offset[i+1] );
+	};
+	/*! Incoming halfedges of vertex i ccwly, as vertex_in_halfedges. */
+	CArrayRange<CHalfEdge*> in_halfedges( int i ) const
+	{
+		return CArrayRange<CHalfEdge*>( m_vh.data() + m_offset[i], m_vh.data() + m_offset[i+1] );
+	};
+
+protected:
+	/*! the mesh */
+	M *                               m_pMesh;
+	/*! topology version of the snapshot */
+	unsigned int                      m_version;
+	/*! whether the snapshot has been built */
+	bool                              m_built;
+
+	/*! vertices in list order */
+	std::vector<CVertex*>             m_verts;
+	/*! index of every vertex */
+	std::unordered_map<CVertex*,int>  m_index;
+	/*! ring of vertex i in m_vv */
+	std::vector<size_t>               m_vv_offset;
+	/*! neighboring vertex indices */
+	std::vector<int>                  m_vv;
+	/*! ring of vertex i in m_vf and m_vh */
+	std::vector<size_t>               m_offset;
+	/*! neighboring faces */
+	std::vector<CFace*>               m_vf;
+	/*! incoming halfedges */
+	std::vector<CHalfEdge*>           m_vh;
+};
+
+template<typename M>
+void COneRing<M>::build()
+{
+	m_verts.assign( m_pMesh->vertices().begin(), m_pMesh->vertices().end() );
+	size_t n = m_verts.size();
+
+	m_index.clear();
+	m_index.reserve( n );
+	for( size_t i = 0; i < n; i ++ ) m_index[ m_verts[i] ] = (int) i;
+
+	//ring sizes, isolated vertices have none, a vertex has as many faces as incoming halfedges
+	m_vv_offset.assign( n + 1, 0 );
+	m_offset.assign( n + 1, 0 );
+	parallel_for( 0, n, [&]( size_t i )
+	{
+		CVertex * v = m_verts[i];
+		if( v->halfedge() == NULL ) return;
+		size_t nv = 0, nh = 0;
+		for( CVertex * w : vertex_vertices<M>( v ) ) { (void) w; nv ++; }
+		for( CHalfEdge * h : vertex_in_halfedges( m_pMesh, v ) ) { (void) h; nh ++; }
+		m_vv_offset[i+1] = nv;
+		m_offset[i+1]    = nh;
+	} );
+	for( size_t i = 0; i < n; i ++ )
+	{
+		m_vv_offset[i+1] += m_vv_offset[i];
+		m_offset[i+1]    += m_offset[i];
+	}
+
+	m_vv.resize( m_vv_offset[n] );
+	m_vf.resize( m_offset[n] );
+	m_vh.resize( m_offset[n] );
+	parallel_for( 0, n, [&]( size_t i )
+	{
+		CVertex * v = m_verts[i];
+		if( v->halfedge() == NULL ) return;
+		size_t k = m_vv_offset[i];
+		for( CVertex * w : vertex_vertices<M>( v ) ) m_vv[k++] = index( w );
+		k = m_offset[i];
+		for( CFace * f : vertex_faces<M>( v ) ) m_vf[k++] = f;
+		k = m_offset[i];
+		for( CHalfEdge * h : vertex_in_halfedges( m_pMesh, v ) ) m_vh[k++] = h;
+	} );
+
+	m_version = m_pMesh->topologyVersion();
+	m_built   = true;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_ONE_RING_H_ defined
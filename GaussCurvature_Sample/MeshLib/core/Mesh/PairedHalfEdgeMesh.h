@@ -0,0 +1,515 @@
+/*!
+*      \file PairedHalfEdgeMesh.h
+*      \brief Index based triangle mesh, the two halfedges of an edge are stored as an adjacent pair
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_PAIRED_HALFEDGE_MESH_H_
+#define _MESHLIB_PAIRED_HALFEDGE_MESH_H_
+
+#include <assert.h>
+#include <math.h>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "../Geometry/Point.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CPairedHalfEdgeMesh, triangle mesh whose halfedges are allocated in pairs
+*
+*	Halfedge 2e and 2e+1 are the two halfedges of edge e, therefore the dual halfedge
+*	of h is h^1 and the edge of h is h>>1, the edge needs no storage at all. Every
+*	halfedge stores its target vertex, its next halfedge and its face. Boundary edges
+*	own a halfedge as well, its face is -1 and its next halfedge runs along the boundary
+*	loop, such that rotations never meet a NULL dual.
+*
+*	The halfedge of a vertex is its most clw out halfedge, the same convention as
+*	CVertex::most_clw_out_halfedge, hence the one ring is visited in the same ccw order as
+*	by the iterators of CBaseMesh; the ring of a boundary vertex starts at the same
+*	neighbour, that of an interior vertex may start at another one.
+*
+*	Optional per element arrays, such as the vertex normals and curvatures computed by
+*	CGaussCurvature<CPairedHalfEdgeMesh>, are empty until they are filled.
+*/
+class CPairedHalfEdgeMesh
+{
+public:
+	/*!	Constructor, the mesh is empty. */
+	CPairedHalfEdgeMesh(){};
+
+	/*!
+		Build the mesh from a triangle soup.
+		\param points vertex positions
+		\param triangles three vertex indices per triangle, ccw oriented
+	*/
+	void build( const std::vector<CPoint> & points, const std::vector<int> & triangles );
+	/*!
+		Build the mesh from a halfedge mesh, all faces must be triangles.
+		Vertex and face ids are kept, vertex and face indices follow the list order of pMesh.
+		\param pMesh input mesh
+	*/
+	template<typename M>
+	void from_mesh( M * pMesh );
+	/*!	Remove all elements. */
+	void clear();
+
+	/*! Number of vertices. */
+	int numVertices()  { return (int) m_points.size(); };
+	/*! Number of edges. */
+	int numEdges()     { return (int) m_target.size() / 2; };
+	/*! Number of faces. */
+	int numFaces()     { return (int) m_face_halfedge.size(); };
+	/*! Number of halfedges, boundary halfedges included. */
+	int numHalfEdges() { return (int) m_target.size(); };
+
+	/*! Dual halfedge of h. */
+	static int halfedgeSym( int h )  { return h ^ 1; };
+	/*! Edge of h. */
+	static int halfedgeEdge( int h ) { return h >> 1; };
+	/*! Halfedge id of edge e, id is 0 or 1. */
+	static int edgeHalfedge( int e, int id ) { return ( e << 1 ) | id; };
+
+	/*! Target vertex of h. */
+	int halfedgeTarget( int h ) { return m_target[h]; };
+	/*! Source vertex of h. */
+	int halfedgeSource( int h ) { return m_target[h^1]; };
+	/*! Next halfedge of h. */
+	int halfedgeNext( int h )   { return m_next[h]; };
+	/*! Previous halfedge of h. */
+	int halfedgePrev( int h );
+	/*! Face of h, -1 if h is a boundary halfedge. */
+	int halfedgeFace( int h )   { return m_face[h]; };
+	/*! Whether h is a boundary halfedge, namely it is attached to no face. */
+	bool isBoundary( int h )    { return m_face[h] < 0; };
+
+	/*! Whether edge e is on the boundary. */
+	bool edgeBoundary( int e )  { return m_face[e<<1] < 0 || m_face[(e<<1)|1] < 0; };
+	/*! Length of edge e. */
+	double edgeLength( int e )  { return ( m_points[m_target[e<<1]] - m_points[m_target[(e<<1)|1]] ).norm(); };
+
+	/*! The most clw out halfedge of v, -1 for an isolated vertex. */
+	int vertexHalfedge( int v ) { return m_vertex_halfedge[v]; };
+	/*! Whether v is on the boundary. */
+	bool vertexBoundary( int v ) { int h = m_vertex_halfedge[v]; return h >= 0 && m_face[h^1] < 0; };
+	/*! Position of v. */
+	CPoint & vertexPoint( int v ) { return m_points[v]; };
+	/*! Id of v, as in the input mesh. */
+	int & vertexId( int v )     { return m_vertex_id[v]; };
+
+	/*! A halfedge of face f. */
+	int faceHalfedge( int f )   { return m_face_halfedge[f]; };
+	/*! Id of f, as in the input mesh. */
+	int & faceId( int f )       { return m_face_id[f]; };
+
+	/*! Rotate the out halfedge h about its source ccwly, the result may be a boundary halfedge. */
+	int ccw_rotate_about_source( int h ) { return m_next[m_next[h]] ^ 1; };
+	/*! Rotate the out halfedge h about its source clwly. */
+	int clw_rotate_about_source( int h ) { return m_next[h^1]; };
+	/*! Rotate the in halfedge h about its target ccwly. */
+	int ccw_rotate_about_target( int h ) { return halfedgePrev( h^1 ); };
+	/*! Rotate the in halfedge h about its target clwly, the result may be a boundary halfedge. */
+	int clw_rotate_about_target( int h ) { return m_next[h] ^ 1; };
+
+	/*! Vertex positions. */
+	std::vector<CPoint> & points() { return m_points; };
+
+	/*! Optional vertex normals. */
+	std::vector<CPoint> & vertexNormals()   { return m_vertex_normal; };
+	/*! Optional vertex Gaussian curvatures. */
+	std::vector<double> & vertexCurvatures(){ return m_vertex_k; };
+	/*! Optional face normals. */
+	std::vector<CPoint> & faceNormals()     { return m_face_normal; };
+	/*! Optional face areas. */
+	std::vector<double> & faceAreas()       { return m_face_area; };
+
+protected:
+	/*! Vertex positions. */
+	std::vector<CPoint> m_points;
+	/*! Vertex ids. */
+	std::vector<int>    m_vertex_id;
+	/*! Most clw out halfedge of each vertex. */
+	std::vector<int>    m_vertex_halfedge;
+	/*! Target vertex of each halfedge. */
+	std::vector<int>    m_target;
+	/*! Next halfedge of each halfedge. */
+	std::vector<int>    m_next;
+	/*! Face of each halfedge, -1 on the boundary. */
+	std::vector<int>    m_face;
+	/*! One halfedge of each face. */
+	std::vector<int>    m_face_halfedge;
+	/*! Face ids. */
+	std::vector<int>    m_face_id;
+
+	/*! Optional vertex normals. */
+	std::vector<CPoint> m_vertex_normal;
+	/*! Optional vertex curvatures. */
+	std::vector<double> m_vertex_k;
+	/*! Optional face normals. */
+	std::vector<CPoint> m_face_normal;
+	/*! Optional face areas. */
+	std::vector<double> m_face_area;
+};
+
+/*! Remove all elements. */
+inline void CPairedHalfEdgeMesh::clear()
+{
+	m_points.clear();
+	m_vertex_id.clear();
+	m_vertex_halfedge.clear();
+	m_target.clear();
+	m_next.clear();
+	m_face.clear();
+	m_face_halfedge.clear();
+	m_face_id.clear();
+	m_vertex_normal.clear();
+	m_vertex_k.clear();
+	m_face_normal.clear();
+	m_face_area.clear();
+};
+
+/*! Previous halfedge of h. Inside a triangle it is next of next, along the boundary
+	the in halfedges of the source are rotated clwly until the boundary one is met.
+*/
+inline int CPairedHalfEdgeMesh::halfedgePrev( int h )
+{
+	if( m_face[h] >= 0 ) return m_next[m_next[h]];
+
+	int g = h ^ 1;
+	while( m_face[g] >= 0 )
+	{
+		g = m_next[g] ^ 1;
+	}
+	return g;
+};
+
+/*!	Build the mesh from a triangle soup.
+	The corners are sorted by their (min,max) vertex pair, equal neighbours become the two
+	halfedges of one edge, an unmatched corner gets a boundary halfedge as its dual.
+*/
+inline void CPairedHalfEdgeMesh::build( const std::vector<CPoint> & points, const std::vector<int> & triangles )
+{
+	int nv = (int) points.size();
+	int nf = (int) triangles.size() / 3;
+	int nc = nf * 3;
+
+	m_points = points;
+	if( (int) m_vertex_id.size() != nv )
+	{
+		m_vertex_id.resize( nv );
+		for( int v = 0; v < nv; v ++ ) m_vertex_id[v] = v + 1;
+	}
+	if( (int) m_face_id.size() != nf )
+	{
+		m_face_id.resize( nf );
+		for( int f = 0; f < nf; f ++ ) m_face_id[f] = f + 1;
+	}
+
+	//sort the corners by their undirected edge
+	std::vector< std::pair<long long,int> > keys( nc );
+	for( int c = 0; c < nc; c ++ )
+	{
+		int s = triangles[c];
+		int t = triangles[ c - c % 3 + ( c + 1 ) % 3 ];
+		long long a = std::min( s, t );
+		long long b = std::max( s, t );
+		keys[c] = std::make_pair( ( a << 32 ) | b, c );
+	}
+	std::sort( keys.begin(), keys.end() );
+
+	//pair the corners, corner c gets halfedge hc[c]
+	std::vector<int> hc( nc );
+	m_target.clear();
+	m_face.clear();
+	m_target.reserve( nc + nc / 8 + 2 );
+	m_face.reserve( nc + nc / 8 + 2 );
+
+	for( int i = 0; i < nc; )
+	{
+		int c0 = keys[i].second;
+		int h  = (int) m_target.size();
+		int t0 = triangles[ c0 - c0 % 3 + ( c0 + 1 ) % 3 ];
+
+		hc[c0] = h;
+		m_target.push_back( t0 );
+		m_face.push_back( c0 / 3 );
+
+		if( i + 1 < nc && keys[i+1].first == keys[i].first && triangles[ keys[i+1].second ] == t0 )
+		{
+			int c1 = keys[i+1].second;
+			hc[c1] = h + 1;
+			m_target.push_back( triangles[c0] );
+			m_face.push_back( c1 / 3 );
+			i += 2;
+		}
+		else
+		{
+			//boundary halfedge, or a non manifold / inconsistently oriented edge
+			m_target.push_back( triangles[c0] );
+			m_face.push_back( -1 );
+			i += 1;
+		}
+	}
+
+	int nh = (int) m_target.size();
+	m_next.assign( nh, -1 );
+	m_face_halfedge.resize( nf );
+
+	for( int c = 0; c < nc; c ++ )
+	{
+		m_next[ hc[c] ] = hc[ c - c % 3 + ( c + 1 ) % 3 ];
+	}
+	for( int f = 0; f < nf; f ++ )
+	{
+		m_face_halfedge[f] = hc[3*f];
+	}
+
+	//vertex halfedge, the most clw out halfedge is the one whose dual is on the boundary
+	m_vertex_halfedge.assign( nv, -1 );
+	std::vector<int> boundary_out( nv, -1 );
+
+	for( int h = 0; h < nh; h ++ )
+	{
+		int s = m_target[h^1];
+		if( m_face[h] < 0 )
+		{
+			boundary_out[s] = h;
+			continue;
+		}
+		if( m_vertex_halfedge[s] < 0 || m_face[h^1] < 0 )
+		{
+			m_vertex_halfedge[s] = h;
+		}
+	}
+
+	//link the boundary loops, the boundary halfedge into t continues with the one out of t
+	for( int h = 0; h < nh; h ++ )
+	{
+		if( m_face[h] >= 0 ) continue;
+		m_next[h] = boundary_out[ m_target[h] ];
+	}
+};
+
+/*!	Build the mesh from a halfedge mesh.
+	\param pMesh input mesh, all faces must be triangles
+*/
+template<typename M>
+void CPairedHalfEdgeMesh::from_mesh( M * pMesh )
+{
+	std::vector<CPoint> points;
+	std::vector<int>    triangles;
+	std::map<typename M::CVertex*, int> vertex_index;
+
+	m_vertex_id.clear();
+	m_face_id.clear();
+
+	for( typename std::list<typename M::CVertex*>::iterator viter = pMesh->vertices().begin(); viter != pMesh->vertices().end(); ++ viter )
+	{
+		typename M::CVertex * v = *viter;
+		vertex_index[v] = (int) points.size();
+		points.push_back( v->point() );
+		m_vertex_id.push_back( v->id() );
+	}
+
+	for( typename std::list<typename M::CFace*>::iterator fiter = pMesh->faces().begin(); fiter != pMesh->faces().end(); ++ fiter )
+	{
+		typename M::CFace * f = *fiter;
+		typename M::CHalfEdge * he = pMesh->faceHalfedge( f );
+		for( int i = 0; i < 3; i ++ )
+		{
+			triangles.push_back( vertex_index[ pMesh->halfedgeSource( he ) ] );
+			he = pMesh->halfedgeNext( he );
+		}
+		assert( he == pMesh->faceHalfedge( f ) );
+		m_face_id.push_back( f->id() );
+	}
+
+	build( points, triangles );
+};
+
+/*!
+	\brief PairedVertexOutHalfedgeIterator, transverse the out halfedges of a vertex ccwly,
+	starting from the most clw one. Boundary halfedges are skipped.
+*/
+class PairedVertexOutHalfedgeIterator
+{
+public:
+	/*!
+		PairedVertexOutHalfedgeIterator constructor
+		\param pMesh the current mesh
+		\param v     the current vertex
+	*/
+	PairedVertexOutHalfedgeIterator( CPairedHalfEdgeMesh * pMesh, int v )
+	{ m_pMesh = pMesh; m_halfedge = m_first = pMesh->vertexHalfedge( v ); };
+
+	/*! prefix ++ operator, goes to the next ccw out halfedge */
+	void operator++()
+	{
+		assert( m_halfedge >= 0 );
+		m_halfedge = m_pMesh->ccw_rotate_about_source( m_halfedge );
+		if( m_halfedge == m_first || m_pMesh->isBoundary( m_halfedge ) ) m_halfedge = -1;
+	};
+	/*! postfix ++ operator, goes to the next ccw out halfedge */
+	void operator++(int) { ++ (*this); };
+
+	/*! The current halfedge. */
+	int value() { return m_halfedge; };
+	/*! The current halfedge. */
+	int operator*() { return m_halfedge; };
+	/*! Whether all the out halfedges have been visited. */
+	bool end() { return m_halfedge < 0; };
+
+private:
+	/*! Current mesh. */
+	CPairedHalfEdgeMesh * m_pMesh;
+	/*! The most clw out halfedge. */
+	int m_first;
+	/*! Current halfedge. */
+	int m_halfedge;
+};
+
+/*!
+	\brief PairedVertexInHalfedgeIterator, transverse the in halfedges of a vertex ccwly,
+	starting from the most clw one. Boundary halfedges are skipped.
+*/
+class PairedVertexInHalfedgeIterator
+{
+public:
+	/*!
+		PairedVertexInHalfedgeIterator constructor
+		\param pMesh the current mesh
+		\param v     the current vertex
+	*/
+	PairedVertexInHalfedgeIterator( CPairedHalfEdgeMesh * pMesh, int v )
+	{
+		m_pMesh = pMesh;
+		m_out = m_first = pMesh->vertexHalfedge( v );
+		m_halfedge = ( m_out < 0 ) ? -1 : pMesh->halfedgeNext( pMesh->halfedgeNext( m_out ) );
+	};
+
+	/*! prefix ++ operator, goes to the next ccw in halfedge */
+	void operator++()
+	{
+		assert( m_halfedge >= 0 );
+		m_out = m_halfedge ^ 1;
+		if( m_out == m_first || m_pMesh->isBoundary( m_out ) )
+		{
+			m_halfedge = -1;
+			return;
+		}
+		m_halfedge = m_pMesh->halfedgeNext( m_pMesh->halfedgeNext( m_out ) );
+	};
+	/*! postfix ++ operator, goes to the next ccw in halfedge */
+	void operator++(int) { ++ (*this); };
+
+	/*! The current halfedge. */
+	int value() { return m_halfedge; };
+	/*! The current halfedge. */
+	int operator*() { return m_halfedge; };
+	/*! Whether all the in halfedges have been visited. */
+	bool end() { return m_halfedge < 0; };
+
+private:
+	/*! Current mesh. */
+	CPairedHalfEdgeMesh * m_pMesh;
+	/*! The most clw out halfedge. */
+	int m_first;
+	/*! The out halfedge in the face of the current in halfedge. */
+	int m_out;
+	/*! Current halfedge. */
+	int m_halfedge;
+};
+
+/*!
+	\brief PairedVertexVertexIterator, transverse the neighbouring vertices of a vertex ccwly.
+	On the boundary both boundary neighbours are visited, the last one through the boundary halfedge.
+*/
+class PairedVertexVertexIterator
+{
+public:
+	/*!
+		PairedVertexVertexIterator constructor
+		\param pMesh the current mesh
+		\param v     the current vertex
+	*/
+	PairedVertexVertexIterator( CPairedHalfEdgeMesh * pMesh, int v )
+	{ m_pMesh = pMesh; m_halfedge = m_first = pMesh->vertexHalfedge( v ); };
+
+	/*! prefix ++ operator, goes to the next ccw neighbour */
+	void operator++()
+	{
+		assert( m_halfedge >= 0 );
+		if( m_pMesh->isBoundary( m_halfedge ) )
+		{
+			m_halfedge = -1;
+			return;
+		}
+		m_halfedge = m_pMesh->ccw_rotate_about_source( m_halfedge );
+		if( m_halfedge == m_first ) m_halfedge = -1;
+	};
+	/*! postfix ++ operator, goes to the next ccw neighbour */
+	void operator++(int) { ++ (*this); };
+
+	/*! The current neighbouring vertex. */
+	int value() { return m_pMesh->halfedgeTarget( m_halfedge ); };
+	/*! The current neighbouring vertex. */
+	int operator*() { return value(); };
+	/*! The out halfedge pointing to the current neighbour. */
+	int halfedge() { return m_halfedge; };
+	/*! Whether all the neighbours have been visited. */
+	bool end() { return m_halfedge < 0; };
+
+private:
+	/*! Current mesh. */
+	CPairedHalfEdgeMesh * m_pMesh;
+	/*! The most clw out halfedge. */
+	int m_first;
+	/*! Current out halfedge. */
+	int m_halfedge;
+};
+
+/*!
+	\brief PairedFaceHalfedgeIterator, transverse the three halfedges of a face ccwly.
+*/
+class PairedFaceHalfedgeIterator
+{
+public:
+	/*!
+		PairedFaceHalfedgeIterator constructor
+		\param pMesh the current mesh
+		\param f     the current face
+	*/
+	PairedFaceHalfedgeIterator( CPairedHalfEdgeMesh * pMesh, int f )
+	{ m_pMesh = pMesh; m_halfedge = m_first = pMesh->faceHalfedge( f ); };
+
+	/*! prefix ++ operator, goes to the next ccw halfedge */
+	void operator++()
+	{
+		assert( m_halfedge >= 0 );
+		m_halfedge = m_pMesh->halfedgeNext( m_halfedge );
+		if( m_halfedge == m_first ) m_halfedge = -1;
+	};
+	/*! postfix ++ operator, goes to the next ccw halfedge */
+	void operator++(int) { ++ (*this); };
+
+	/*! The current halfedge. */
+	int value() { return m_halfedge; };
+	/*! The current halfedge. */
+	int operator*() { return m_halfedge; };
+	/*! Whether all the halfedges have been visited. */
+	bool end() { return m_halfedge < 0; };
+
+private:
+	/*! Current mesh. */
+	CPairedHalfEdgeMesh * m_pMesh;
+	/*! The first halfedge. */
+	int m_first;
+	/*! Current halfedge. */
+	int m_halfedge;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_PAIRED_HALFEDGE_MESH_H_ defined
@@ -0,0 +1,339 @@
+/*!
+*      \file PlyFormat.h
+*      \brief Header and property handling of binary PLY files
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_PLY_FORMAT_H_
+#define _MESHLIB_PLY_FORMAT_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Attributes.h"
+#include "../Parser/TextScanner.h"
+
+namespace MeshLib{
+
+/*! scalar types of PLY properties */
+enum EPlyType { PLY_NONE, PLY_INT8, PLY_UINT8, PLY_INT16, PLY_UINT16, PLY_INT32, PLY_UINT32, PLY_FLOAT32, PLY_FLOAT64 };
+
+/*!	The scalar type of a PLY type name, both the old (char, float) and the sized (int8, float32) names.
+*/
+inline EPlyType _ply_type( const CStringView & name )
+{
+	static const char * names[] = { "char", "int8", "uchar", "uint8", "short", "int16", "ushort", "uint16",
+		"int", "int32", "uint", "uint32", "float", "float32", "double", "float64" };
+	for( int i = 0; i < 16; i ++ )
+	{
+		if( name == names[i] ) return (EPlyType)( i / 2 + 1 );
+	}
+	return PLY_NONE;
+};
+
+/*!	Size in bytes of a PLY scalar type. */
+inline size_t _ply_size( EPlyType type )
+{
+	static const size_t sizes[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+	return sizes[type];
+};
+
+/*!	Read a little endian PLY scalar. */
+inline double _ply_load( const char * p, EPlyType type )
+{
+	switch( type )
+	{
+	case PLY_INT8:    { signed char    v; memcpy( &v, p, 1 ); return v; }
+	case PLY_UINT8:   { unsigned char  v; memcpy( &v, p, 1 ); return v; }
+	case PLY_INT16:   { short          v; memcpy( &v, p, 2 ); return v; }
+	case PLY_UINT16:  { unsigned short v; memcpy( &v, p, 2 ); return v; }
+	case PLY_INT32:   { int            v; memcpy( &v, p, 4 ); return v; }
+	case PLY_UINT32:  { unsigned int   v; memcpy( &v, p, 4 ); return v; }
+	case PLY_FLOAT32: { float          v; memcpy( &v, p, 4 ); return v; }
+	case PLY_FLOAT64: { double         v; memcpy( &v, p, 8 ); return v; }
+	default: return 0;
+	}
+};
+
+/*!
+*	\brief CPlyProperty, one property of a PLY element
+*/
+struct CPlyProperty
+{
+	/*! name of the property */
+	std::string name;
+	/*! scalar type, the type of the list entries for lists */
+	EPlyType    type;
+	/*! type of the list length, PLY_NONE if the property is not a list */
+	EPlyType    count_type;
+};
+
+/*!
+*	\brief CPlyElement, one element of a PLY file, e.g. vertex or face
+*/
+struct CPlyElement
+{
+	/*! name of the element */
+	std::string               name;
+	/*! number of records */
+	size_t                    count;
+	/*! properties of every record */
+	std::vector<CPlyProperty> properties;
+
+	/*!
+		Locate the properties of one record.
+		\param p      first byte of the record
+		\param end    end of the file
+		\param fields position of every property, the length of lists is at the position
+		\return one past the record, NULL if the file ends within the record
+	*/
+	const char * record( const char * p, const char * end, std::vector<const char*> & fields ) const
+	{
+		fields.resize( properties.size() );
+		for( size_t k = 0; k < properties.size(); k ++ )
+		{
+			const CPlyProperty & prop = properties[k];
+			fields[k] = p;
+			size_t bytes;
+			if( prop.count_type == PLY_NONE )
+			{
+				bytes = _ply_size( prop.type );
+			}
+			else
+			{
+				if( p + _ply_size( prop.count_type ) > end ) return NULL;
+				int n = (int) _ply_load( p, prop.count_type );
+				bytes = _ply_size( prop.count_type ) + ( n > 0 ? n : 0 ) * _ply_size( prop.type );
+			}
+			if( p + bytes > end ) return NULL;
+			p += bytes;
+		}
+		return p;
+	};
+	/*! Index of a property, -1 if there is none. */
+	int find( const char * property ) const
+	{
+		for( size_t k = 0; k < properties.size(); k ++ )
+			if( properties[k].name == property ) return (int) k;
+		return -1;
+	};
+};
+
+/*!
+*	\brief CPlyHeader, the header of a PLY file
+*/
+class CPlyHeader
+{
+public:
+	/*! storage formats */
+	enum Format { ASCII, BINARY_LITTLE_ENDIAN, BINARY_BIG_ENDIAN };
+
+	/*!
+		Parse the header.
+		\param begin first byte of the file
+		\param end   end of the file
+		\return false if this is not a PLY file
+	*/
+	bool parse( const char * begin, const char * end );
+
+	/*! storage format */
+	Format                   format;
+	/*! the elements, in file order */
+	std::vector<CPlyElement> elements;
+	/*! first byte after the header */
+	const char *             body;
+};
+
+inline bool CPlyHeader::parse( const char * begin, const char * end )
+{
+	CTextScanner scanner( begin, end );
+	CStringView  line;
+	CStringView  token;
+
+	elements.clear();
+	body   = NULL;
+	format = ASCII;
+
+	if( !scanner.next_line( line ) || !( line == "ply" ) ) return false;
+
+	while( scanner.next_line( line ) )
+	{
+		CLineScanner ls( line );
+		if( !ls.token( token ) ) continue;
+
+		if( token == "end_header" )
+		{
+			body = scanner.position();
+			return true;
+		}
+		if( token == "format" )
+		{
+			ls.token( token );
+			if( token == "binary_little_endian" )   format = BINARY_LITTLE_ENDIAN;
+			else if( token == "binary_big_endian" ) format = BINARY_BIG_ENDIAN;
+			else                                    format = ASCII;
+			continue;
+		}
+		if( token == "element" )
+		{
+			CPlyElement element;
+			int count = 0;
+			ls.token( token );
+			element.name = token.str();
+			ls.parse_int( count );
+			element.count = (size_t)( count > 0 ? count : 0 );
+			elements.push_back( element );
+			continue;
+		}
+		if( token == "property" && !elements.empty() )
+		{
+			CPlyProperty prop;
+			prop.count_type = PLY_NONE;
+			ls.token( token );
+			if( token == "list" )
+			{
+				ls.token( token );
+				prop.count_type = _ply_type( token );
+				ls.token( token );
+			}
+			prop.type = _ply_type( token );
+			ls.token( token );
+			prop.name = token.str();
+			if( prop.type == PLY_NONE ) return false;
+			elements.back().properties.push_back( prop );
+			continue;
+		}
+		//comment, obj_info
+	}
+	return false;
+};
+
+/*!
+*	\brief CPlyAttributes, maps the attributes of an element class to PLY properties
+*
+*	A scalar attribute is the property of its key, the components of a vector attribute are
+*	the properties key_x, key_y ( and key_z ). Values are stored with the scalar type of the
+*	attribute, double, float or int.
+*/
+template<typename Element, bool has_attributes = CHasAttributes<Element>::value>
+struct CPlyAttributes
+{
+	/*! Property name of component i of an attribute with n components. */
+	static std::string _name( const char * key, int i, int n )
+	{
+		std::string name( key );
+		if( n > 1 ) { name += "_"; name += "xyz"[i]; }
+		return name;
+	};
+	/*! PLY type of an attribute code. */
+	static const char * _type( int code )
+	{
+		return ( code == 'd' ) ? "double" : ( code == 'f' ) ? "float" : "int";
+	};
+
+	struct CDeclare
+	{
+		std::string * header;
+		size_t        size;
+		template<typename Tag> void visit()
+		{
+			typedef CAttributeType<typename Tag::value_type> T;
+			for( int i = 0; i < T::components; i ++ )
+			{
+				*header += "property ";
+				*header += _type( T::code );
+				*header += " " + _name( Tag::name(), i, T::components ) + "\n";
+			}
+			size += sizeof( typename T::scalar_type ) * T::components;
+		};
+	};
+	struct CStore
+	{
+		Element * e;
+		char *    out;
+		template<typename Tag> void visit()
+		{
+			typedef CAttributeType<typename Tag::value_type> T;
+			size_t bytes = sizeof( typename T::scalar_type ) * T::components;
+			memcpy( out, T::data( e->template attr<Tag>() ), bytes );
+			out += bytes;
+		};
+	};
+	struct CLocate
+	{
+		Element *           e;
+		const std::string * name;
+		long                offset;
+		EPlyType            type;
+		template<typename Tag> void visit()
+		{
+			typedef CAttributeType<typename Tag::value_type> T;
+			for( int i = 0; i < T::components && type == PLY_NONE; i ++ )
+			{
+				if( *name != _name( Tag::name(), i, T::components ) ) continue;
+				offset = (long)( (char*)( T::data( e->template attr<Tag>() ) + i ) - (char*) e );
+				type   = ( T::code == 'd' ) ? PLY_FLOAT64 : ( T::code == 'f' ) ? PLY_FLOAT32 : PLY_INT32;
+			}
+		};
+	};
+
+	/*!
+		Append the property lines of the attributes to a header.
+		\return bytes of the attributes of one element
+	*/
+	static size_t declare( std::string & header )
+	{
+		CDeclare d; d.header = &header; d.size = 0;
+		Element::attribute_list::for_each_attribute( d );
+		return d.size;
+	};
+	/*!
+		Store the attributes of an element.
+		\return one past the stored bytes
+	*/
+	static char * store( Element * e, char * out )
+	{
+		CStore s; s.e = e; s.out = out;
+		Element::attribute_list::for_each_attribute( s );
+		return s.out;
+	};
+	/*!
+		The storage of the attribute component called name, as a byte offset from the
+		element, which is the same for all the elements of the class.
+		\return the type of the component, PLY_NONE if there is no such attribute
+	*/
+	static EPlyType locate( Element * e, const std::string & name, long & offset )
+	{
+		CLocate l; l.e = e; l.name = &name; l.offset = 0; l.type = PLY_NONE;
+		Element::attribute_list::for_each_attribute( l );
+		offset = l.offset;
+		return l.type;
+	};
+};
+
+template<typename Element>
+struct CPlyAttributes<Element,false>
+{
+	static size_t   declare( std::string & ) { return 0; };
+	static char *   store( Element *, char * out ) { return out; };
+	static EPlyType locate( Element *, const std::string &, long & ) { return PLY_NONE; };
+};
+
+/*!	Store a value into the attribute component at the given offset of an element. */
+inline void _ply_assign( void * element, long offset, EPlyType type, double value )
+{
+	char * p = (char*) element + offset;
+	switch( type )
+	{
+	case PLY_FLOAT64: { double v = value;        memcpy( p, &v, sizeof(v) ); break; }
+	case PLY_FLOAT32: { float  v = (float) value; memcpy( p, &v, sizeof(v) ); break; }
+	case PLY_INT32:   { int    v = (int) value;   memcpy( p, &v, sizeof(v) ); break; }
+	default: break;
+	}
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_PLY_FORMAT_H_ defined
@@ -0,0 +1,163 @@
+/*!
+*      \file TraitTable.h
+*      \brief Sparse side tables for the trait strings of vertex, edge, face and halfedge
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_TRAIT_TABLE_H_
+#define _MESHLIB_TRAIT_TABLE_H_
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+namespace MeshLib{
+
+/*!
+*	\brief CTraitTable, sparse table mapping a mesh element to its trait string
+*
+*	The trait string is only needed to round trip the {...} attributes of an .m file,
+*	therefore it is not stored in the element itself. Only the elements which really
+*	carry traits own an entry, meshes without traits pay nothing: they never create an
+*	entry and every query returns before touching a lock.
+*
+*	The table is shared by all meshes, which may be read, written and destroyed on the
+*	threads of the pool at the same time. It is split into shards by the address of the
+*	element, each a hash map under its own lock, so that threads working on different
+*	elements rarely wait for each other. A reference returned by string stays valid until
+*	the entry is erased; only the thread owning the element may write through it.
+*
+*	\tparam T element base class, CVertex, CEdge, CFace or CHalfEdge
+*/
+template<typename T>
+class CTraitTable
+{
+public:
+	/*!
+		The trait string of an element, an empty entry is created if there is none. Use
+		find to read and set to assign, which create no entry for an empty string.
+		\param e the element
+		\return reference to the trait string of e
+	*/
+	static std::string & string( const T * e )
+	{
+		CShard & shard = _shard( e );
+		std::lock_guard<std::mutex> guard( shard.lock );
+		typename CMap::iterator iter = shard.map.find( e );
+		if( iter != shard.map.end() ) return iter->second;
+		_count() ++;
+		return shard.map[e];
+	};
+	/*!
+		Assign the trait string of an element, an empty string removes its entry.
+		\param e the element
+		\param s the trait string
+	*/
+	static void set( const T * e, const std::string & s )
+	{
+		if( s.empty() )
+		{
+			erase( e );
+			return;
+		}
+		string( e ) = s;
+	};
+	/*!
+		Whether an element carries a non-empty trait string, no entry is created.
+		\param e the element
+	*/
+	static bool has_string( const T * e )
+	{
+		return find( e ) != NULL;
+	};
+	/*!
+		The trait string of an element without creating an entry.
+		\param e the element
+		\return the non-empty trait string of e, NULL if there is none
+	*/
+	static const std::string * find( const T * e )
+	{
+		if( _count().load() == 0 ) return NULL;
+		CShard & shard = _shard( e );
+		std::lock_guard<std::mutex> guard( shard.lock );
+		typename CMap::const_iterator iter = shard.map.find( e );
+		return ( iter != shard.map.end() && !iter->second.empty() ) ? &iter->second : NULL;
+	};
+	/*!
+		Remove the trait string of an element, called when the element is destroyed.
+		\param e the element
+	*/
+	static void erase( const T * e )
+	{
+		if( _count().load() == 0 ) return;
+		CShard & shard = _shard( e );
+		std::lock_guard<std::mutex> guard( shard.lock );
+		if( shard.map.erase( e ) > 0 ) _count() --;
+	};
+	/*!
+		Hand the trait string of one element over to another one.
+		\param from the element owning the string
+		\param to   the element receiving the string
+	*/
+	static void move( const T * from, const T * to )
+	{
+		if( _count().load() == 0 || from == to ) return;
+		std::string s;
+		{
+			CShard & shard = _shard( from );
+			std::lock_guard<std::mutex> guard( shard.lock );
+			typename CMap::iterator iter = shard.map.find( from );
+			if( iter == shard.map.end() ) return;
+			s.swap( iter->second );
+			shard.map.erase( iter );
+			_count() --;
+		}
+		set( to, s );
+	};
+	/*!
+		Number of elements owning a trait string.
+	*/
+	static size_t size() { return _count().load(); };
+
+protected:
+	/*! number of shards, a power of two */
+	enum { SHARDS = 64 };
+	/*! map of one shard */
+	typedef std::unordered_map<const T*, std::string> CMap;
+	/*! a map and its lock, on its own cache lines */
+	struct CShard
+	{
+		std::mutex lock;
+		CMap       map;
+		char       padding[64];
+	};
+	/*! the shard of an element, by its address without the bits of the alignment */
+	static CShard & _shard( const T * e )
+	{
+		size_t h = (size_t) e;
+		h = ( h >> 4 ) ^ ( h >> 12 );
+		return _shards()[ h & ( SHARDS - 1 ) ];
+	};
+	/*!
+		The shards. They are allocated once and never released, such that meshes
+		destroyed during static destruction can still remove their entries. The
+		initialization of a function-local static is thread-safe.
+	*/
+	static CShard * _shards()
+	{
+		static CShard * pShards = new CShard[SHARDS];
+		return pShards;
+	};
+	/*! number of entries of all the shards, checked without a lock */
+	static std::atomic<size_t> & _count()
+	{
+		static std::atomic<size_t> * pCount = new std::atomic<size_t>( 0 );
+		return *pCount;
+	};
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_TRAIT_TABLE_H_ defined
@@ -1,301 +1,364 @@
-/*!
-*      \file Boundary.h
-*      \brief Trace boundary loops
-*	   \author David Gu
-*      \date 10/07/2010
-*
-*/
-
-
-#ifndef _BOUNDARY_H_
-#define _BOUNDARY_H_
-
-#include <iostream>
-#include <fstream>
-#include <algorithm>
-#include <vector>
-#include <list>
-#include <set>
-
-#include "../Mesh/BaseMesh.h"
-#include "../Mesh/iterators.h"
-
-namespace MeshLib
-{
-/*!
-	\brief CLoop Boundary loop  class.	
-*/
-
-template<typename M>
-class CLoop
-{
-public:
-	/*!
-		Constructor of the CLoop
-		\param pMesh  pointer to the current mesh
-		\param pH halfedge on the boundary loop
-	*/
-	CLoop( M * pMesh, typename M::CHalfEdge * pH );
-	/*!
-		Constructor of the CLoop
-		\param pMesh  pointer to the current mesh
-	*/
-	 CLoop( M * pMesh ) { m_pMesh = pMesh; m_length = 0; m_pHalfedge = NULL; };
-	 /*!
-		Destructor of CLoop.
-	 */
-	~CLoop();
-	
-	/*!
-	The list of haledges on the current boundary loop.
-	*/
-	std::list<typename M::CHalfEdge*>  & halfedges() 
-	{
-		return m_halfedges;
-	}
-	
-	/*!
-		The length of the current boundary loop.
-	*/
-	double length() 
-	{ 
-		return m_length; 
-	}
-	/*!
-	 *  Output to a file
-	 */
-	void write( const char * file );
-	/*!
-	 *  Input from a file
-	 */
-	void read( const char * file );
-
-protected:
-	/*!
-		Pointer to the current mesh.
-	*/
-	M		* m_pMesh;
-	/*! The length of the current boundary loop.
-	*/
-	double										    m_length;
-	/*!
-		Starting halfedge of the current boundary loop.
-	*/
-	typename M::CHalfEdge						  * m_pHalfedge;
-	/*!
-		List of consecutive halfedges along the boundary loop.
-	*/
-	std::list<typename M::CHalfEdge*>				m_halfedges;
-
-};
-
-/*!
-	\brief CBoundary Boundary  class.	
-	\tparam CVertex Vertex type
-	\tparam CEdge   Edge   type
-	\tparam CFace   Face   type
-	\tparam CHalfEdge HalfEdge type
-*/
-
-template<typename M>
-class CBoundary
-{
-
-public:
-	/*!
-	CBoundary constructor
-	\param pMesh pointer to the current mesh
-	*/
-	CBoundary( M * pMesh );
-	/*!
-	CBoundary destructor
-	*/
-	~CBoundary();
-	/*!
-	The list of boundary loops.
-	*/
-	std::vector<CLoop<M>*> & loops() 
-	{ 
-		return m_loops; 
-	} 
-
-protected:
-	/*!
-		Pointer to the current mesh.
-	*/
-	M * m_pMesh;
-	/*!
-		List of boundary loops.
-	*/
-	typename std::vector<CLoop<M>*> m_loops;
-	/*!
-		Bubble sort the loops
-		\param loops the vector of loops
-	*/
-	void _bubble_sort( std::vector<CLoop<M>*> & loops);
-};
-
-/*!
-	CLoop constructure, trace the boundary loop, starting from the halfedge pH.
-	\param pMesh pointer to the current mesh
-	\param pH  halfedge on the current boundary loop
-*/
-template<typename M>
-CLoop<M>::CLoop( M *pMesh, typename M::CHalfEdge * pH )
-{
-	m_pMesh     = pMesh;
-	m_pHalfedge = pH;
-
-	m_length = 0;
-	M::CHalfEdge * he = pH;
-
-	//trace the boundary loop
-	do{
-		M::CVertex * v = m_pMesh->halfedgeTarget( he ); //(M::CVertex*)he->target();
-		he = m_pMesh->vertexMostClwOutHalfEdge( v );
-		m_halfedges.push_back( he );
-		m_length += m_pMesh->edgeLength( (M::CEdge*)he->edge() );
-	}while( he != m_pHalfedge );
-}
-
-/*!
-CLoop destructor, clean up the list of halfedges in the loop
-*/
-template<typename M>
-CLoop<M>::~CLoop()
-{
-	m_halfedges.clear();
-}
-
-
-/*!
-	_bubble_sort
-	bubble sort  a vector of boundary loop objects, according to their lengths
-	\param loops vector of loops
-*/
-template<typename M>
-void CBoundary<M>::_bubble_sort( std::vector<CLoop<M>*> & loops)
-{
-      int i, j, flag = 1;    // set flag to 1 to start first pass
-      CLoop<M> * temp;             // holding variable
-      int numLength = (int)loops.size( ); 
-      for(i = 1; (i <= numLength) && flag; i++)
-     {
-          flag = 0;
-          for (j=0; j < (numLength -1); j++)
-         {
-               if (loops[j+1]->length() > loops[j]->length() )      // ascending order simply changes to <
-              { 
-                    temp = loops[j];								// swap elements
-                    loops[j] = loops[j+1];
-                    loops[j+1] = temp;
-                    flag = 1;										// indicates that a swap occurred.
-               }
-          }
-     }
-}
-
-/*!
-	CBoundary constructor
-	\param pMesh the current mesh
-*/
-template<typename M>
-CBoundary<M>::CBoundary( M * pMesh )
-{
-	m_pMesh = pMesh;
-	//collect all boundary halfedges
-	std::set<M::CHalfEdge*> boundary_hes;
-	for( M::MeshEdgeIterator eiter( m_pMesh); !eiter.end(); eiter ++ )
-	{
-		M::CEdge * e = *eiter;
-		if( !m_pMesh->isBoundary(e) ) continue;
-
-		M::CHalfEdge * he = m_pMesh->edgeHalfedge( e, 0);
-		boundary_hes.insert( he );
-	}
-	//trace all the boundary loops
-	while( !boundary_hes.empty() )
-	{
-		//get the first boundary halfedge
-		std::set<M::CHalfEdge*>::iterator siter = boundary_hes.begin();
-		M::CHalfEdge * he = *siter;
-		//trace along this boundary halfedge
-		CLoop<M> * pL = new CLoop<M>( m_pMesh, he );
-		assert(pL);
-		m_loops.push_back( pL );
-		//remove all the boundary halfedges, which are in the same boundary loop as the head, from the halfedge list
-		for( std::list<M::CHalfEdge*>::iterator hiter = pL->halfedges().begin(); hiter != pL->halfedges().end(); hiter ++ )
-		{
-			M::CHalfEdge * he = *hiter;
-			siter = boundary_hes.find( he );
-			if( siter == boundary_hes.end() ) continue;
-			boundary_hes.erase( siter );
-		}
-	}
-	
-	//std::sort( vlps.begin(), vlps.end(), loop_compare<CVertex,CFace,CEdge,CHalfEdge> );
-	_bubble_sort( m_loops );
-}
-
-/*!	CBoundary destructor, delete all boundary loop objects.
-*/
-template<typename M>
-CBoundary<M>::~CBoundary()
-{
-	for( int i = 0; i < (int)m_loops.size(); i ++ )
-	{
-		CLoop<M> * pL = m_loops[i];
-		delete pL;
-	}
-};
-
-/*!
-	Output the loop to a file
-	\param file_name the name of the file
-*/
-template<typename M>
-void CLoop<M>::write( const char * file_name )
-{
-	std::ofstream myfile;
-	myfile.open (file_name);
-	for( std::list<M::CHalfEdge*>::iterator hiter = m_halfedges.begin(); hiter != m_halfedges.end(); hiter ++ )
-	{
-		M::CHalfEdge * pH = *hiter;
-		M::CVertex * pV = m_pMesh->halfedgeSource(pH);
-		M::CVertex * pW = m_pMesh->halfedgeTarget(pH);
-		myfile << pV->id() << " " << pW->id() << std::endl;
-	}
-	myfile.close();
-};
-
-/*!
-	Output the loop to a file
-	\param file_name the name of the file
-*/
-template<typename M>
-void CLoop<M>::read( const char * file_name )
-{
-	std::ifstream myfile;
-	myfile.open (file_name);
-
-	if (myfile.is_open())
-	{
-		while ( myfile.good() )
-		{
-			int source, target;
-			myfile >> source >> target;
-			M::CVertex * pS = m_pMesh->idVertex( source );
-			M::CVertex * pT = m_pMesh->idVertex( target );
-			M::CEdge   * pE = m_pMesh->vertexEdge( pS, pT );
-			M::CHalfEdge * pH = m_pMesh->edgeHalfedge(pE,0);
-			m_halfedges.push_back( pH );
-		}
-		myfile.close();
-	}
-
-};
-
-
-}
-#endif
-
+/*!
+*      \file Boundary.h
+*      \brief Trace boundary loops
+*	   \author David Gu
+*      \date 10/07/2010
+*
+*/
+
+
+#ifndef _BOUNDARY_H_
+#define _BOUNDARY_H_
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <list>
+#include <map>
+
+#include "../Mesh/BaseMesh.h"
+#include "../Mesh/iterators.h"
+
+namespace MeshLib
+{
+template<typename M> class CBoundary;
+
+/*!
+	\brief CLoop Boundary loop  class.	
+*/
+
+template<typename M>
+class CLoop
+{
+public:
+	/*!
+		Constructor of the CLoop
+		\param pMesh  pointer to the current mesh
+		\param pH halfedge on the boundary loop
+	*/
+	CLoop( M * pMesh, typename M::CHalfEdge * pH );
+	/*!
+		Constructor of the CLoop
+		\param pMesh  pointer to the current mesh
+	*/
+	 CLoop( M * pMesh ) { m_pMesh = pMesh; m_length = 0; m_pHalfedge = NULL; };
+	 /*!
+		Destructor of CLoop.
+	 */
+	~CLoop();
+	
+	/*!
+	The list of haledges on the current boundary loop.
+	*/
+	std::list<typename M::CHalfEdge*>  & halfedges() 
+	{
+		return m_halfedges;
+	}
+	
+	/*!
+		The length of the current boundary loop.
+	*/
+	double length() 
+	{ 
+		return m_length; 
+	}
+	/*!
+	 *  Output to a file
+	 */
+	void write( const char * file );
+	/*!
+	 *  Input from a file
+	 */
+	void read( const char * file );
+
+protected:
+	/*! CBoundary fills the loops it traces. */
+	friend class CBoundary<M>;
+	/*!
+		The boundary halfedge following he on its loop, found by rotating about the target of he
+		over the faces between the two boundary edges only, NULL if the mesh is broken.
+	*/
+	static typename M::CHalfEdge * _next( typename M::CHalfEdge * he );
+
+	/*!
+		Pointer to the current mesh.
+	*/
+	M		* m_pMesh;
+	/*! The length of the current boundary loop.
+	*/
+	double										    m_length;
+	/*!
+		Starting halfedge of the current boundary loop.
+	*/
+	typename M::CHalfEdge						  * m_pHalfedge;
+	/*!
+		List of consecutive halfedges along the boundary loop.
+	*/
+	std::list<typename M::CHalfEdge*>				m_halfedges;
+
+};
+
+/*!
+	\brief CBoundary Boundary  class.	
+
+	The boundary halfedges are collected in one pass over the edges into a flat array and grouped
+	by their source vertex, so that the halfedge following another one on its loop is found in
+	constant time; a bitmap over the array marks the ones already traced. All loops are found in
+	time linear in the size of the mesh. The loops are sorted by length, longest first. A CBoundary owns its loops and is
+	not copied.
+	\tparam CVertex Vertex type
+	\tparam CEdge   Edge   type
+	\tparam CFace   Face   type
+	\tparam CHalfEdge HalfEdge type
+*/
+
+template<typename M>
+class CBoundary
+{
+
+public:
+	/*!
+	CBoundary constructor
+	\param pMesh pointer to the current mesh
+	*/
+	CBoundary( M * pMesh );
+	/*!
+	CBoundary destructor
+	*/
+	~CBoundary();
+	/*!
+	The list of boundary loops.
+	*/
+	std::vector<CLoop<M>*> & loops() 
+	{ 
+		return m_loops; 
+	} 
+
+protected:
+	/*!
+		Pointer to the current mesh.
+	*/
+	M * m_pMesh;
+	/*!
+		List of boundary loops.
+	*/
+	typename std::vector<CLoop<M>*> m_loops;
+	/*!
+		Whether loop a is longer than loop b
+	*/
+	static bool _longer( CLoop<M> * a, CLoop<M> * b ) { return a->length() > b->length(); };
+
+private:
+	/*!
+		The loops are owned, a copy would delete them twice.
+	*/
+	CBoundary( const CBoundary & );
+	CBoundary & operator=( const CBoundary & );
+};
+
+/*!
+	CLoop constructure, trace the boundary loop, starting from the halfedge pH.
+	\param pMesh pointer to the current mesh
+	\param pH  halfedge on the current boundary loop
+*/
+template<typename M>
+CLoop<M>::CLoop( M *pMesh, typename M::CHalfEdge * pH )
+{
+	m_pMesh     = pMesh;
+	m_pHalfedge = pH;
+
+	m_length = 0;
+	typename M::CHalfEdge * he = pH;
+
+	//trace the boundary loop
+	do{
+		he = _next( he );
+		if( he == NULL ) break;
+		m_halfedges.push_back( he );
+		m_length += m_pMesh->edgeLength( (typename M::CEdge*)he->edge() );
+	}while( he != m_pHalfedge );
+}
+
+template<typename M>
+typename M::CHalfEdge * CLoop<M>::_next( typename M::CHalfEdge * he )
+{
+	//the out halfedges of the target, clockwise from the face of he up to the boundary
+	typename M::CHalfEdge * n = (typename M::CHalfEdge*) he->he_next();
+	typename M::CHalfEdge * first = n;
+	while( n->he_sym() != NULL )
+	{
+		n = (typename M::CHalfEdge*) n->he_sym()->he_next();
+		if( n == first ) return NULL;
+	}
+	return n;
+};
+
+/*!
+CLoop destructor, clean up the list of halfedges in the loop
+*/
+template<typename M>
+CLoop<M>::~CLoop()
+{
+	m_halfedges.clear();
+}
+
+
+/*!
+	CBoundary constructor
+	\param pMesh the current mesh
+*/
+template<typename M>
+CBoundary<M>::CBoundary( M * pMesh )
+{
+	m_pMesh = pMesh;
+	//collect all boundary halfedges into a flat array
+	std::vector<typename M::CHalfEdge*> hes;
+	for( typename M::MeshEdgeIterator eiter( m_pMesh); !eiter.end(); eiter ++ )
+	{
+		typename M::CEdge * e = *eiter;
+		if( !m_pMesh->isBoundary(e) ) continue;
+		hes.push_back( m_pMesh->edgeHalfedge( e, 0) );
+	}
+	int nb = (int) hes.size();
+	if( nb == 0 ) return;
+
+	//index of the source vertex of every boundary halfedge, a table for dense ids, the map otherwise
+	int min_id = m_pMesh->halfedgeSource( hes[0] )->id(), max_id = min_id;
+	for( int i = 1; i < nb; i ++ )
+	{
+		int id = m_pMesh->halfedgeSource( hes[i] )->id();
+		min_id = std::min( min_id, id );
+		max_id = std::max( max_id, id );
+	}
+	bool dense = (unsigned long long)( max_id - min_id ) < 4 * (unsigned long long) nb + 16;
+	std::vector<int>  id_index( dense ? max_id - min_id + 1 : 0, -1 );
+	std::map<int,int> id_map;
+	std::vector<int>  source( nb );
+	int ns = 0;
+	for( int i = 0; i < nb; i ++ )
+	{
+		int id = m_pMesh->halfedgeSource( hes[i] )->id();
+		int & index = dense ? id_index[ id - min_id ] : id_map.insert( std::make_pair( id, -1 ) ).first->second;
+		if( index < 0 ) index = ns ++;
+		source[i] = index;
+	}
+
+	//boundary halfedges grouped by their source, one per vertex unless the vertex is on several loops
+	std::vector<int> first( ns + 1, 0 ), out( nb );
+	for( int i = 0; i < nb; i ++ ) first[ source[i] + 1 ] ++;
+	for( int s = 0; s < ns; s ++ ) first[ s + 1 ] += first[s];
+	std::vector<int> fill( first.begin(), first.end() - 1 );
+	for( int i = 0; i < nb; i ++ ) out[ fill[ source[i] ] ++ ] = i;
+
+	//the boundary halfedge following hes[j] is the one leaving its target, -1 if the mesh is broken
+	auto next = [&]( int j ) -> int
+	{
+		int id = m_pMesh->halfedgeTarget( hes[j] )->id();
+		int s  = -1;
+		if( dense )
+		{
+			if( id >= min_id && id <= max_id ) s = id_index[ id - min_id ];
+		}
+		else
+		{
+			std::map<int,int>::iterator iter = id_map.find( id );
+			if( iter != id_map.end() ) s = iter->second;
+		}
+		if( s < 0 ) return -1;
+		if( first[s+1] - first[s] == 1 ) return out[ first[s] ];
+
+		typename M::CHalfEdge * he = CLoop<M>::_next( hes[j] );
+		for( int k = first[s]; k < first[s+1]; k ++ )
+		{
+			if( hes[ out[k] ] == he ) return out[k];
+		}
+		return -1;
+	};
+
+	//trace all the boundary loops, each from its first halfedge not traced yet
+	std::vector<unsigned char> traced( nb, 0 );
+	for( int i = 0; i < nb; i ++ )
+	{
+		if( traced[i] ) continue;
+		CLoop<M> * pL = new CLoop<M>( m_pMesh );
+		assert(pL);
+		pL->m_pHalfedge = hes[i];
+		m_loops.push_back( pL );
+
+		int j = i;
+		do{
+			j = next( j );
+			if( j < 0 || traced[j] ) break;
+			traced[j] = 1;
+			pL->m_halfedges.push_back( hes[j] );
+			pL->m_length += m_pMesh->edgeLength( (typename M::CEdge*)hes[j]->edge() );
+		}while( j != i );
+	}
+	
+	//stable, loops of equal length keep the order they were traced in
+	std::stable_sort( m_loops.begin(), m_loops.end(), _longer );
+}
+
+/*!	CBoundary destructor, delete all boundary loop objects.
+*/
+template<typename M>
+CBoundary<M>::~CBoundary()
+{
+	for( int i = 0; i < (int)m_loops.size(); i ++ )
+	{
+		CLoop<M> * pL = m_loops[i];
+		delete pL;
+	}
+};
+
+/*!
+	Output the loop to a file
+	\param file_name the name of the file
+*/
+template<typename M>
+void CLoop<M>::write( const char * file_name )
+{
+	std::ofstream myfile;
+	myfile.open (file_name);
+	for( std::list<M::CHalfEdge*>::iterator hiter = m_halfedges.begin(); hiter != m_halfedges.end(); hiter ++ )
+	{
+		M::CHalfEdge * pH = *hiter;
+		M::CVertex * pV = m_pMesh->halfedgeSource(pH);
+		M::CVertex * pW = m_pMesh->halfedgeTarget(pH);
+		myfile << pV->id() << " " << pW->id() << std::endl;
+	}
+	myfile.close();
+};
+
+/*!
+	Output the loop to a file
+	\param file_name the name of the file
+*/
+template<typename M>
+void CLoop<M>::read( const char * file_name )
+{
+	std::ifstream myfile;
+	myfile.open (file_name);
+
+	if (myfile.is_open())
+	{
+		while ( myfile.good() )
+		{
+			int source, target;
+			myfile >> source >> target;
+			M::CVertex * pS = m_pMesh->idVertex( source );
+			M::CVertex * pT = m_pMesh->idVertex( target );
+			M::CEdge   * pE = m_pMesh->vertexEdge( pS, pT );
+			M::CHalfEdge * pH = m_pMesh->edgeHalfedge(pE,0);
+			m_halfedges.push_back( pH );
+		}
+		myfile.close();
+	}
+
+};
+
+
+}
+#endif
+
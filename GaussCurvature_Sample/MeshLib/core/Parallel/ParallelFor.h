@@ -0,0 +1,122 @@
+/*!
+*      \file ParallelFor.h
+*      \brief Parallel loops over the vertices, edges and faces of a mesh
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_PARALLEL_FOR_H_
+#define _MESHLIB_PARALLEL_FOR_H_
+
+#include <vector>
+#include "ThreadPool.h"
+
+namespace MeshLib{
+
+/*
+	The element lists of CBaseMesh are copied into arrays, one pass over the list, and the
+	arrays are cut into chunks for CThreadPool, a pool of one thread walks the list instead.
+	The body is called once per element, it may write the element and read its neighbors, but
+	must not write shared data, except through CThreadLocal or the reduce functions below.
+*/
+
+/*! Call f( e ) for every element of a list in parallel. */
+template<typename List, typename F>
+void _parallel_for_list( List & list, const F & f, size_t grain )
+{
+	if( CThreadPool::instance().size() == 1 )
+	{
+		for( typename List::iterator iter = list.begin(); iter != list.end(); ++ iter ) f( *iter );
+		return;
+	}
+	std::vector<typename List::value_type> elements( list.begin(), list.end() );
+	parallel_for( 0, elements.size(), [&]( size_t i ){ f( elements[i] ); }, grain );
+};
+
+/*! Reduce over a list in parallel, with the chunks and the order of parallel_reduce. */
+template<typename List, typename T, typename F, typename R>
+T _parallel_reduce_list( List & list, const T & identity, const F & f, const R & reduce, size_t grain )
+{
+	size_t n = list.size();
+	if( n == 0 ) return identity;
+	if( CThreadPool::instance().size() > 1 )
+	{
+		std::vector<typename List::value_type> elements( list.begin(), list.end() );
+		return parallel_reduce( 0, n, identity, [&]( size_t i, T & value ){ f( elements[i], value ); }, reduce, grain );
+	}
+
+	size_t chunk   = parallel_grain( n, grain );
+	T      value   = identity;
+	T      partial = identity;
+	size_t i       = 0;
+	for( typename List::iterator iter = list.begin(); iter != list.end(); ++ iter )
+	{
+		f( *iter, partial );
+		if( ++ i % chunk != 0 && i != n ) continue;
+		if( i <= chunk ) value = partial; else reduce( value, partial );
+		partial = identity;
+	}
+	return value;
+};
+
+/*!
+	Call f( vertex ) for every vertex of the mesh in parallel.
+	\param grain chunk size, 0 for the default
+*/
+template<typename M, typename F>
+void parallel_for_vertices( M * pMesh, const F & f, size_t grain = 0 )
+{
+	_parallel_for_list( pMesh->vertices(), f, grain );
+};
+
+/*!
+	Call f( edge ) for every edge of the mesh in parallel.
+	\param grain chunk size, 0 for the default
+*/
+template<typename M, typename F>
+void parallel_for_edges( M * pMesh, const F & f, size_t grain = 0 )
+{
+	_parallel_for_list( pMesh->edges(), f, grain );
+};
+
+/*!
+	Call f( face ) for every face of the mesh in parallel.
+	\param grain chunk size, 0 for the default
+*/
+template<typename M, typename F>
+void parallel_for_faces( M * pMesh, const F & f, size_t grain = 0 )
+{
+	_parallel_for_list( pMesh->faces(), f, grain );
+};
+
+/*!
+	Reduce over the vertices in parallel, f( vertex, value ) accumulates a vertex, the partial
+	values are merged by reduce( value, partial ) in list order, see parallel_reduce.
+*/
+template<typename M, typename T, typename F, typename R>
+T parallel_reduce_vertices( M * pMesh, const T & identity, const F & f, const R & reduce, size_t grain = 0 )
+{
+	return _parallel_reduce_list( pMesh->vertices(), identity, f, reduce, grain );
+};
+
+/*!
+	Reduce over the edges in parallel, see parallel_reduce_vertices.
+*/
+template<typename M, typename T, typename F, typename R>
+T parallel_reduce_edges( M * pMesh, const T & identity, const F & f, const R & reduce, size_t grain = 0 )
+{
+	return _parallel_reduce_list( pMesh->edges(), identity, f, reduce, grain );
+};
+
+/*!
+	Reduce over the faces in parallel, see parallel_reduce_vertices.
+*/
+template<typename M, typename T, typename F, typename R>
+T parallel_reduce_faces( M * pMesh, const T & identity, const F & f, const R & reduce, size_t grain = 0 )
+{
+	return _parallel_reduce_list( pMesh->faces(), identity, f, reduce, grain );
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_PARALLEL_FOR_H_ defined
@@ -0,0 +1,137 @@
+/*!
+*      \file RadixSort.h
+*      \brief Parallel LSD radix sort of integer keys carrying a value
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_RADIX_SORT_H_
+#define _MESHLIB_RADIX_SORT_H_
+
+#include <assert.h>
+#include <vector>
+#include <algorithm>
+#include "ThreadPool.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CRadixSort, stable least significant digit radix sort of 64 bit keys
+*
+*	Every pass sorts 11 bits. The input is cut into one chunk per thread of CThreadPool,
+*	the digits of every chunk are counted as a task of the pool, the counts are turned into
+*	per chunk offsets, and every chunk is scattered as a task. Since the chunks are scattered
+*	in order the sort is stable, and the result does not depend on the number of threads.
+*
+*	\tparam V value type attached to every key
+*/
+template<typename V>
+class CRadixSort
+{
+public:
+	/*!
+		Sort keys and values by key.
+		\param keys   the keys
+		\param values the values, values[i] belongs to keys[i]
+		\param bits   number of significant bits of the keys, the higher ones are ignored
+	*/
+	static void sort( std::vector<unsigned long long> & keys, std::vector<V> & values, int bits = 64 );
+
+protected:
+	/*! number of bits per pass */
+	enum { DIGIT_BITS = 11, DIGITS = 1 << DIGIT_BITS };
+	/*! below this size a single chunk is used */
+	enum { PARALLEL_THRESHOLD = 1 << 16 };
+
+	/*! count the digits of keys[begin,end) */
+	static void _count( const unsigned long long * keys, size_t begin, size_t end, int shift, size_t * count );
+	/*! scatter keys[begin,end) to the positions in offset */
+	static void _scatter( const unsigned long long * keys, const V * values, size_t begin, size_t end, int shift, size_t * offset,
+		                  unsigned long long * keys_out, V * values_out );
+};
+
+template<typename V>
+void CRadixSort<V>::_count( const unsigned long long * keys, size_t begin, size_t end, int shift, size_t * count )
+{
+	std::fill( count, count + DIGITS, (size_t) 0 );
+	for( size_t i = begin; i < end; i ++ )
+	{
+		count[ ( keys[i] >> shift ) & ( DIGITS - 1 ) ] ++;
+	}
+};
+
+template<typename V>
+void CRadixSort<V>::_scatter( const unsigned long long * keys, const V * values, size_t begin, size_t end, int shift, size_t * offset,
+							  unsigned long long * keys_out, V * values_out )
+{
+	for( size_t i = begin; i < end; i ++ )
+	{
+		size_t pos = offset[ ( keys[i] >> shift ) & ( DIGITS - 1 ) ] ++;
+		keys_out[pos]   = keys[i];
+		values_out[pos] = values[i];
+	}
+};
+
+template<typename V>
+void CRadixSort<V>::sort( std::vector<unsigned long long> & keys, std::vector<V> & values, int bits )
+{
+	assert( keys.size() == values.size() );
+	size_t n = keys.size();
+	if( n < 2 ) return;
+
+	CThreadPool & pool = CThreadPool::instance();
+	int nchunks = 1;
+	if( n >= PARALLEL_THRESHOLD ) nchunks = std::min( pool.size(), 16 );
+
+	std::vector<unsigned long long> keys_tmp( n );
+	std::vector<V>                  values_tmp( n );
+	std::vector<size_t>             count( nchunks * DIGITS );
+	std::vector<size_t>             chunk( nchunks + 1 );
+	for( int t = 0; t <= nchunks; t ++ ) chunk[t] = n * t / nchunks;
+
+	for( int shift = 0; shift < bits; shift += DIGIT_BITS )
+	{
+		const unsigned long long * ki = &keys[0];
+		const V                  * vi = &values[0];
+
+		//histograms, a single chunk runs on the caller
+		pool.run( nchunks, [&]( size_t t, int ){
+			_count( ki, chunk[t], chunk[t+1], shift, &count[t*DIGITS] );
+		} );
+
+		//skip the pass if all keys share the digit
+		bool trivial = false;
+		for( int d = 0; d < DIGITS && !trivial; d ++ )
+		{
+			size_t total = 0;
+			for( int t = 0; t < nchunks; t ++ ) total += count[t*DIGITS+d];
+			if( total == n ) trivial = true;
+			else if( total != 0 ) break;
+		}
+		if( trivial ) continue;
+
+		//offsets, digit major then chunk, keeps the sort stable
+		size_t sum = 0;
+		for( int d = 0; d < DIGITS; d ++ )
+		{
+			for( int t = 0; t < nchunks; t ++ )
+			{
+				size_t c = count[t*DIGITS+d];
+				count[t*DIGITS+d] = sum;
+				sum += c;
+			}
+		}
+
+		//scatter
+		pool.run( nchunks, [&]( size_t t, int ){
+			_scatter( ki, vi, chunk[t], chunk[t+1], shift, &count[t*DIGITS], &keys_tmp[0], &values_tmp[0] );
+		} );
+
+		keys.swap( keys_tmp );
+		values.swap( values_tmp );
+	}
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_RADIX_SORT_H_ defined
@@ -0,0 +1,379 @@
+/*!
+*      \file ThreadPool.h
+*      \brief Persistent work stealing thread pool, parallel loops and reductions over index ranges
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_THREAD_POOL_H_
+#define _MESHLIB_THREAD_POOL_H_
+
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <algorithm>
+
+namespace MeshLib{
+
+/*!
+*	\brief CThreadPool, threads started once and reused by every parallel loop
+*
+*	run( n, f ) calls f( task, thread ) for the tasks 0..n-1. The tasks are dealt in contiguous
+*	blocks to per thread queues, a thread takes the tasks of its own queue from the front and,
+*	once it is empty, steals from the back of the others. The calling thread works as thread 0.
+*	A run started inside a task, or on a pool of one thread, executes on the calling thread.
+*/
+class CThreadPool
+{
+public:
+	/*!
+		Start the pool.
+		\param nthreads number of threads including the caller, the hardware concurrency if <= 0
+	*/
+	explicit CThreadPool( int nthreads = 0 );
+	/*!	Stop and join the threads. */
+	~CThreadPool();
+
+	/*!	The pool shared by parallel_for and parallel_reduce, started at its first use. */
+	static CThreadPool & instance()
+	{
+		static CThreadPool pool;
+		return pool;
+	};
+
+	/*! Number of threads, including the caller. */
+	int size() const { return (int) m_queues.size(); };
+
+	/*!
+		Run f( task, thread ) for every task in [0,ntasks), return once all of them are done.
+		thread is in [0,size()), no two tasks run on the same thread at the same time. The
+		first exception thrown by a task is rethrown.
+	*/
+	template<typename F>
+	void run( size_t ntasks, const F & f );
+
+protected:
+	/*!	\brief task queue of one thread */
+	struct CQueue
+	{
+		std::mutex         lock;
+		std::deque<size_t> tasks;
+	};
+
+	/*! loop of worker thread index */
+	void _worker( int index );
+	/*! execute tasks until all the queues are empty */
+	void _drain( int index );
+	/*! take a task from the own queue, else steal one */
+	bool _pop( int index, size_t & task );
+
+	/*! thread index of the calling thread, -1 outside of a task */
+	static int & _current()
+	{
+		static thread_local int index = -1;
+		return index;
+	};
+
+	/*! worker threads, the caller is thread 0 */
+	std::vector<std::thread>   m_threads;
+	/*! one queue per thread */
+	std::vector<CQueue*>       m_queues;
+	/*! the current job */
+	std::function<void(size_t,int)> m_job;
+	/*! tasks of the current job not finished yet */
+	std::atomic<size_t>        m_remaining;
+	/*! first exception of the current job */
+	std::exception_ptr         m_error;
+
+	/*! protects m_generation, m_stop and m_error */
+	std::mutex                 m_lock;
+	/*! wakes the workers up for a new job */
+	std::condition_variable    m_wake;
+	/*! signals the caller that the job is done */
+	std::condition_variable    m_done;
+	/*! serializes the runs of different callers */
+	std::mutex                 m_run;
+	/*! number of jobs started */
+	size_t                     m_generation;
+	/*! whether the pool is being destroyed */
+	bool                       m_stop;
+};
+
+inline CThreadPool::CThreadPool( int nthreads )
+{
+	if( nthreads <= 0 ) nthreads = (int) std::thread::hardware_concurrency();
+	if( nthreads <= 0 ) nthreads = 1;
+
+	m_remaining  = 0;
+	m_generation = 0;
+	m_stop       = false;
+	for( int t = 0; t < nthreads; t ++ ) m_queues.push_back( new CQueue );
+	for( int t = 1; t < nthreads; t ++ ) m_threads.push_back( std::thread( &CThreadPool::_worker, this, t ) );
+};
+
+inline CThreadPool::~CThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard( m_lock );
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for( size_t t = 0; t < m_threads.size(); t ++ ) m_threads[t].join();
+	for( size_t t = 0; t < m_queues.size(); t ++ ) delete m_queues[t];
+};
+
+inline void CThreadPool::_worker( int index )
+{
+	_current() = index;
+	size_t seen = 0;
+	while( true )
+	{
+		{
+			std::unique_lock<std::mutex> guard( m_lock );
+			m_wake.wait( guard, [&](){ return m_stop || m_generation != seen; } );
+			if( m_stop ) return;
+			seen = m_generation;
+		}
+		_drain( index );
+	}
+};
+
+inline bool CThreadPool::_pop( int index, size_t & task )
+{
+	int n = size();
+	for( int k = 0; k < n; k ++ )
+	{
+		CQueue * q = m_queues[ ( index + k ) % n ];
+		std::lock_guard<std::mutex> guard( q->lock );
+		if( q->tasks.empty() ) continue;
+		if( k == 0 ) { task = q->tasks.front(); q->tasks.pop_front(); }
+		else         { task = q->tasks.back();  q->tasks.pop_back();  }
+		return true;
+	}
+	return false;
+};
+
+inline void CThreadPool::_drain( int index )
+{
+	size_t task;
+	while( _pop( index, task ) )
+	{
+		try
+		{
+			m_job( task, index );
+		}
+		catch( ... )
+		{
+			std::lock_guard<std::mutex> guard( m_lock );
+			if( !m_error ) m_error = std::current_exception();
+		}
+		if( -- m_remaining == 0 )
+		{
+			std::lock_guard<std::mutex> guard( m_lock );
+			m_done.notify_all();
+		}
+	}
+};
+
+template<typename F>
+void CThreadPool::run( size_t ntasks, const F & f )
+{
+	if( ntasks == 0 ) return;
+
+	//nested, or nothing to share
+	int current = _current();
+	if( current >= 0 || size() == 1 || ntasks == 1 )
+	{
+		int index = ( current >= 0 ) ? current : 0;
+		for( size_t t = 0; t < ntasks; t ++ ) f( t, index );
+		return;
+	}
+
+	std::lock_guard<std::mutex> serial( m_run );
+	m_job       = [&f]( size_t task, int thread ){ f( task, thread ); };
+	m_error     = std::exception_ptr();
+	m_remaining = ntasks;
+
+	int n = size();
+	for( int q = 0; q < n; q ++ )
+	{
+		std::lock_guard<std::mutex> guard( m_queues[q]->lock );
+		for( size_t t = ntasks * q / n; t < ntasks * ( q + 1 ) / n; t ++ ) m_queues[q]->tasks.push_back( t );
+	}
+	{
+		std::lock_guard<std::mutex> guard( m_lock );
+		m_generation ++;
+	}
+	m_wake.notify_all();
+
+	_current() = 0;
+	_drain( 0 );
+	_current() = -1;
+
+	std::unique_lock<std::mutex> guard( m_lock );
+	m_done.wait( guard, [&](){ return m_remaining == 0; } );
+	m_job = std::function<void(size_t,int)>();
+	if( m_error ) std::rethrow_exception( m_error );
+};
+
+/*!
+	Chunk size of a parallel loop over n indices. It depends on n only, not on the number of
+	threads, so that reductions combine the same partial results on every machine.
+	\param grain requested chunk size, 0 for the default
+*/
+inline size_t parallel_grain( size_t n, size_t grain )
+{
+	if( grain > 0 ) return grain;
+	//at least 512 indices, at most 256 chunks
+	return std::max( (size_t) 512, ( n + 255 ) / 256 );
+};
+
+/*!
+	Call f( first, last, thread ) for chunks [first,last) covering [begin,end) in parallel.
+	\param grain chunk size, 0 for the default
+*/
+template<typename F>
+void parallel_for_chunks( size_t begin, size_t end, const F & f, size_t grain = 0 )
+{
+	if( end <= begin ) return;
+	size_t n       = end - begin;
+	size_t chunk   = parallel_grain( n, grain );
+	size_t nchunks = ( n + chunk - 1 ) / chunk;
+
+	CThreadPool::instance().run( nchunks, [&]( size_t c, int thread ){
+		size_t first = begin + c * chunk;
+		size_t last  = std::min( first + chunk, end );
+		f( first, last, thread );
+	} );
+};
+
+/*!
+	Call f( i ) for every i in [begin,end) in parallel.
+	\param grain chunk size, 0 for the default
+*/
+template<typename F>
+void parallel_for( size_t begin, size_t end, const F & f, size_t grain = 0 )
+{
+	parallel_for_chunks( begin, end, [&]( size_t first, size_t last, int ){
+		for( size_t i = first; i < last; i ++ ) f( i );
+	}, grain );
+};
+
+/*!
+	Reduce [begin,end) in parallel. Every chunk starts from identity and calls f( i, value )
+	for its indices, the partial values are combined by reduce( value, partial ) in the order
+	of the chunks, so the result does not depend on the number of threads.
+	\return the combined value
+*/
+template<typename T, typename F, typename R>
+T parallel_reduce( size_t begin, size_t end, const T & identity, const F & f, const R & reduce, size_t grain = 0 )
+{
+	if( end <= begin ) return identity;
+	size_t chunk = parallel_grain( end - begin, grain );
+	std::vector<T> partial( ( end - begin + chunk - 1 ) / chunk, identity );
+
+	parallel_for_chunks( begin, end, [&]( size_t first, size_t last, int ){
+		T & value = partial[ ( first - begin ) / chunk ];
+		for( size_t i = first; i < last; i ++ ) f( i, value );
+	}, chunk );
+
+	T value = partial[0];
+	for( size_t c = 1; c < partial.size(); c ++ ) reduce( value, partial[c] );
+	return value;
+};
+
+/*!
+*	\brief CCompensatedSum, a sum of doubles which carries its rounding error along
+*
+*	Neumaier's variant of Kahan summation, the error of a sum of n terms does not grow with n.
+*	As the reduce of parallel_reduce the result is reproducible and accurate, e.g. a total
+*	curvature which has to match 2PI times the Euler characteristic.
+*/
+struct CCompensatedSum
+{
+	CCompensatedSum() : sum( 0 ), error( 0 ) {};
+
+	/*! Add a term. */
+	void add( double x )
+	{
+		double t = sum + x;
+		error += ( fabs( sum ) >= fabs( x ) ) ? ( sum - t ) + x : ( x - t ) + sum;
+		sum    = t;
+	};
+	/*! Add a partial sum. */
+	void add( const CCompensatedSum & other )
+	{
+		add( other.sum );
+		error += other.error;
+	};
+	/*! The sum. */
+	double value() const { return sum + error; };
+
+	/*! rounded sum */
+	double sum;
+	/*! rounding error of sum */
+	double error;
+};
+
+/*!
+	Sum of f( i ) over [begin,end) in parallel, compensated, see CCompensatedSum. The result
+	does not depend on the number of threads.
+	\param grain chunk size, 0 for the default
+*/
+template<typename F>
+double parallel_sum( size_t begin, size_t end, const F & f, size_t grain = 0 )
+{
+	return parallel_reduce( begin, end, CCompensatedSum(),
+		[&]( size_t i, CCompensatedSum & s ){ s.add( f( i ) ); },
+		[]( CCompensatedSum & s, const CCompensatedSum & t ){ s.add( t ); }, grain ).value();
+};
+
+/*!
+*	\brief CThreadLocal, one value per thread of a pool, padded to separate cache lines
+*
+*	A task accumulates into local( thread ), the values are merged by combine once the loop
+*	is done. Unlike parallel_reduce the merged result depends on which thread ran which task.
+*/
+template<typename T>
+class CThreadLocal
+{
+public:
+	/*!	One copy of identity per thread of pool. */
+	CThreadLocal( const T & identity, CThreadPool & pool = CThreadPool::instance() )
+		: m_slots( pool.size(), CSlot( identity ) ) {};
+
+	/*! value of a thread */
+	T & local( int thread ) { return m_slots[thread].value; };
+
+	/*!	Merge all the values by reduce( value, other ), in the order of the threads. */
+	template<typename R>
+	T combine( const R & reduce ) const
+	{
+		T value = m_slots[0].value;
+		for( size_t t = 1; t < m_slots.size(); t ++ ) reduce( value, m_slots[t].value );
+		return value;
+	};
+
+protected:
+	/*!	\brief value of one thread, on its own cache line */
+	struct CSlot
+	{
+		CSlot( const T & v ) : value( v ) {};
+		T    value;
+		char padding[64];
+	};
+	/*! the values */
+	std::vector<CSlot> m_slots;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_THREAD_POOL_H_ defined
@@ -0,0 +1,158 @@
+/*!
+*      \file MChunk.h
+*      \brief Parallel parsing of the records of an .m file into plain arrays
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_M_CHUNK_H_
+#define _MESHLIB_M_CHUNK_H_
+
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "../Geometry/Point.h"
+#include "../Parallel/ThreadPool.h"
+#include "TextScanner.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CMChunk, the records of a range of lines of an .m file
+*
+*	Parsing does not touch any mesh, it only fills arrays, therefore the chunks of a file
+*	can be parsed by different threads. Vertex ids used by faces are kept as they are,
+*	they are resolved after all the chunks have been parsed and all the vertices exist,
+*	so a face may refer to a vertex of any chunk. Traits are views into the file.
+*	Edge and Corner records need the connectivity, their lines are kept to be handled
+*	after the faces are built.
+*/
+class CMChunk
+{
+public:
+	/*!	Constructor, the chunk is empty. */
+	CMChunk() { m_polygon = false; };
+	/*!	Parse the lines in [begin,end), begin must be the beginning of a line. */
+	void parse( const char * begin, const char * end );
+
+	/*!	Parse a file in parallel.
+		The text is cut at line breaks into chunks, which are parsed as tasks of CThreadPool.
+		\param begin   first byte of the file
+		\param end     one past the last byte
+		\param chunks  the parsed chunks, in file order
+		\param nchunks number of chunks, 0 for one per thread of the pool
+	*/
+	static void parse_file( const char * begin, const char * end, std::vector<CMChunk> & chunks, int nchunks = 0 );
+
+	/*! vertex ids */
+	std::vector<int>     m_vertex_id;
+	/*! vertex positions */
+	std::vector<CPoint>  m_vertex_point;
+	/*! vertex traits, index into the vertex arrays of the chunk and the trait */
+	std::vector< std::pair<int,CStringView> > m_vertex_trait;
+
+	/*! face ids */
+	std::vector<int>     m_face_id;
+	/*! vertices of face f are m_face_vertex[ m_face_offset[f], m_face_offset[f+1] ) */
+	std::vector<int>     m_face_offset;
+	/*! vertex ids of all faces */
+	std::vector<int>     m_face_vertex;
+	/*! face traits, index into the face arrays of the chunk and the trait */
+	std::vector< std::pair<int,CStringView> > m_face_trait;
+	/*! whether the chunk contains a face which is not a triangle */
+	bool                 m_polygon;
+
+	/*! Edge and Corner lines */
+	std::vector<CStringView> m_records;
+};
+
+inline void CMChunk::parse( const char * begin, const char * end )
+{
+	m_polygon = false;
+	m_face_offset.assign( 1, 0 );
+
+	CTextScanner scanner( begin, end );
+	CStringView  line;
+
+	while( scanner.next_line( line ) )
+	{
+		CLineScanner ls( line );
+		CStringView  token;
+		CStringView  trait;
+		int id;
+
+		if( !ls.token( token ) ) continue;
+
+		if( token == "Vertex" )
+		{
+			if( !ls.parse_int( id ) ) continue;
+			CPoint p;
+			for( int i = 0; i < 3; i ++ )
+			{
+				if( !ls.parse_double( p[i] ) ) break;
+			}
+			m_vertex_id.push_back( id );
+			m_vertex_point.push_back( p );
+			if( ls.trait( trait ) )
+			{
+				m_vertex_trait.push_back( std::make_pair( (int) m_vertex_id.size() - 1, trait ) );
+			}
+			continue;
+		}
+
+		if( token == "Face" )
+		{
+			if( !ls.parse_int( id ) ) continue;
+			int vid, n = 0;
+			while( ls.parse_int( vid ) )
+			{
+				m_face_vertex.push_back( vid );
+				n ++;
+			}
+			if( n != 3 ) m_polygon = true;
+			m_face_id.push_back( id );
+			m_face_offset.push_back( (int) m_face_vertex.size() );
+			if( ls.trait( trait ) )
+			{
+				m_face_trait.push_back( std::make_pair( (int) m_face_id.size() - 1, trait ) );
+			}
+			continue;
+		}
+
+		if( token == "Edge" || token == "Corner" )
+		{
+			m_records.push_back( line );
+		}
+	}
+};
+
+inline void CMChunk::parse_file( const char * begin, const char * end, std::vector<CMChunk> & chunks, int nchunks )
+{
+	//small files are not worth a task
+	const size_t min_chunk = 1 << 20;
+
+	if( nchunks <= 0 ) nchunks = CThreadPool::instance().size();
+	size_t size = (size_t)( end - begin );
+	nchunks = (int) std::max( (size_t) 1, std::min( (size_t) nchunks, size / min_chunk ) );
+
+	//cut behind line breaks
+	std::vector<const char*> bounds( nchunks + 1 );
+	bounds[0] = begin;
+	bounds[nchunks] = end;
+	for( int t = 1; t < nchunks; t ++ )
+	{
+		const char * p = std::max( begin + size * t / nchunks, bounds[t-1] );
+		const char * e = ( p < end ) ? (const char*) memchr( p, '\n', end - p ) : NULL;
+		bounds[t] = ( e == NULL ) ? end : e + 1;
+	}
+
+	//a single chunk is parsed on the caller
+	chunks.assign( nchunks, CMChunk() );
+	CThreadPool::instance().run( nchunks, [&]( size_t t, int ){
+		chunks[t].parse( bounds[t], bounds[t+1] );
+	} );
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_M_CHUNK_H_ defined
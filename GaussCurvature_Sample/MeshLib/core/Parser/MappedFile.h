@@ -0,0 +1,178 @@
+/*!
+*      \file MappedFile.h
+*      \brief Read only memory mapped file
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_MAPPED_FILE_H_
+#define _MESHLIB_MAPPED_FILE_H_
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace MeshLib{
+
+/*!
+*	\brief CMappedFile, the whole content of a file as one read only block of memory
+*
+*	The file is mapped into memory, such that parsers can work on the bytes directly
+*	without copying lines into buffers. If the file cannot be mapped, e.g. it is empty
+*	or it is a pipe, it is read into a buffer instead.
+*/
+class CMappedFile
+{
+public:
+	/*!	Constructor, no file is opened. */
+	CMappedFile();
+	/*!	Destructor, unmaps the file. */
+	~CMappedFile() { close(); };
+
+	/*!
+		Map a file.
+		\param filename name of the file
+		\return whether the file could be opened
+	*/
+	bool open( const char * filename );
+	/*!	Unmap the file. */
+	void close();
+
+	/*! First byte of the file. */
+	const char * data()  { return m_data; };
+	/*! One past the last byte of the file. */
+	const char * end()   { return m_data + m_size; };
+	/*! Size of the file in bytes. */
+	size_t       size()  { return m_size; };
+
+protected:
+	/*! First byte of the file. */
+	const char *      m_data;
+	/*! Size of the file. */
+	size_t            m_size;
+	/*! Whether m_data is a mapping, otherwise it points into m_buffer. */
+	bool              m_mapped;
+	/*! Content of files which cannot be mapped. */
+	std::vector<char> m_buffer;
+#ifdef _WIN32
+	/*! Windows file handle. */
+	HANDLE            m_file;
+	/*! Windows mapping handle. */
+	HANDLE            m_mapping;
+#endif
+
+private:
+	/*! Not copyable. */
+	CMappedFile( const CMappedFile & );
+	/*! Not copyable. */
+	CMappedFile & operator=( const CMappedFile & );
+};
+
+inline CMappedFile::CMappedFile()
+{
+	m_data   = NULL;
+	m_size   = 0;
+	m_mapped = false;
+#ifdef _WIN32
+	m_file    = INVALID_HANDLE_VALUE;
+	m_mapping = NULL;
+#endif
+};
+
+inline bool CMappedFile::open( const char * filename )
+{
+	close();
+
+#ifdef _WIN32
+	m_file = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+	if( m_file != INVALID_HANDLE_VALUE )
+	{
+		LARGE_INTEGER size;
+		if( GetFileSizeEx( m_file, &size ) && size.QuadPart > 0 )
+		{
+			m_mapping = CreateFileMappingA( m_file, NULL, PAGE_READONLY, 0, 0, NULL );
+			if( m_mapping != NULL )
+			{
+				m_data = (const char*) MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 );
+				if( m_data != NULL )
+				{
+					m_size   = (size_t) size.QuadPart;
+					m_mapped = true;
+					return true;
+				}
+			}
+		}
+		close();
+	}
+#else
+	int fd = ::open( filename, O_RDONLY );
+	if( fd >= 0 )
+	{
+		struct stat st;
+		if( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) && st.st_size > 0 )
+		{
+			void * p = mmap( NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+			if( p != MAP_FAILED )
+			{
+#ifdef MADV_SEQUENTIAL
+				madvise( p, (size_t) st.st_size, MADV_SEQUENTIAL );
+#endif
+				::close( fd );
+				m_data   = (const char*) p;
+				m_size   = (size_t) st.st_size;
+				m_mapped = true;
+				return true;
+			}
+		}
+		::close( fd );
+	}
+#endif
+
+	//fall back to reading the file
+	FILE * fp = fopen( filename, "rb" );
+	if( fp == NULL ) return false;
+
+	char chunk[1<<16];
+	size_t n;
+	while( ( n = fread( chunk, 1, sizeof( chunk ), fp ) ) > 0 )
+	{
+		m_buffer.insert( m_buffer.end(), chunk, chunk + n );
+	}
+	fclose( fp );
+
+	m_data = m_buffer.empty() ? NULL : &m_buffer[0];
+	m_size = m_buffer.size();
+	return true;
+};
+
+inline void CMappedFile::close()
+{
+#ifdef _WIN32
+	if( m_mapped && m_data != NULL ) UnmapViewOfFile( m_data );
+	if( m_mapping != NULL ) CloseHandle( m_mapping );
+	if( m_file != INVALID_HANDLE_VALUE ) CloseHandle( m_file );
+	m_mapping = NULL;
+	m_file    = INVALID_HANDLE_VALUE;
+#else
+	if( m_mapped && m_data != NULL ) munmap( (void*) m_data, m_size );
+#endif
+	m_buffer.clear();
+	m_data   = NULL;
+	m_size   = 0;
+	m_mapped = false;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_MAPPED_FILE_H_ defined
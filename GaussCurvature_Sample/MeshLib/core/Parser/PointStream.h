@@ -0,0 +1,323 @@
+/*!
+*      \file PointStream.h
+*      \brief Point sets read in blocks by a background thread
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_POINT_STREAM_H_
+#define _MESHLIB_POINT_STREAM_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include "../Geometry/Point.h"
+#include "TextScanner.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+namespace MeshLib{
+
+/*!
+*	\brief CPointStream, reads a point set from a file or stdin, block by block
+*
+*	A reader thread reads fixed size blocks, converts them into batches of points and
+*	queues them, while the caller consumes the previous batches. At most QUEUE_SIZE
+*	batches are queued, so the memory does not depend on the size of the input.
+*
+*	Supported formats
+*	- XYZ: text, one point per line, numbers separated by blanks
+*	- CSV: text, numbers separated by ',' or ';'
+*	- FLOAT32, FLOAT64: raw arrays of dimension floats or doubles per point, in the byte
+*	  order of the machine
+*
+*	Text lines which do not start with at least two numbers, such as headers and
+*	comments, are skipped, a missing z is 0.
+*/
+class CPointStream
+{
+public:
+	/*! input formats */
+	enum Format { XYZ, CSV, FLOAT32, FLOAT64 };
+
+	/*!	Constructor, no input. */
+	CPointStream();
+	/*!	Destructor, stops the reader. */
+	~CPointStream() { close(); };
+
+	/*!
+		Open the input and start reading.
+		\param filename  name of the file, "-" for stdin
+		\param format    format of the file
+		\param dimension components per point of the binary formats, 2 or 3
+		\return whether the input could be opened
+	*/
+	bool open( const char * filename, Format format, int dimension = 3 );
+	/*!	Stop reading and close the input. */
+	void close();
+
+	/*!
+		The next batch of points, waits until the reader has produced it.
+		\param batch the points, replaced
+		\return false at the end of the input
+	*/
+	bool next( std::vector<CPoint> & batch );
+
+	/*! Bounding box of the points consumed so far. */
+	void bounding_box( CPoint & lo, CPoint & hi ) { lo = m_min; hi = m_max; };
+	/*! Number of points consumed so far. */
+	size_t count() { return m_count; };
+
+	/*! Format given by the extension of a file name, .csv, .f32, .f64, XYZ otherwise. */
+	static Format format_of( const char * filename );
+
+	/*! bytes per block */
+	enum { BLOCK_SIZE = 1 << 22 };
+	/*! number of queued batches */
+	enum { QUEUE_SIZE = 4 };
+
+protected:
+	/*! Reader thread. */
+	void _read();
+	/*! Convert the complete records of a text block, return the bytes used. */
+	size_t _parse_text( const char * begin, const char * end, bool last, std::vector<CPoint> & batch );
+	/*! Convert the complete records of a binary block, return the bytes used. */
+	size_t _parse_binary( const char * begin, const char * end, std::vector<CPoint> & batch );
+	/*! Queue a batch, waits while the queue is full. */
+	bool _push( std::vector<CPoint> & batch );
+
+	/*! the input */
+	FILE *                   m_fp;
+	/*! format of the input */
+	Format                   m_format;
+	/*! components per binary point */
+	int                      m_dimension;
+	/*! reader thread */
+	std::thread              m_reader;
+
+	/*! batches read but not consumed */
+	std::deque< std::vector<CPoint> > m_queue;
+	/*! guards the queue and the flags */
+	std::mutex               m_mutex;
+	/*! signals changes of the queue */
+	std::condition_variable  m_changed;
+	/*! the reader reached the end of the input */
+	bool                     m_done;
+	/*! the consumer stopped reading */
+	bool                     m_stop;
+
+	/*! bounding box */
+	CPoint                   m_min;
+	CPoint                   m_max;
+	/*! number of points consumed */
+	size_t                   m_count;
+
+private:
+	/*! Not copyable. */
+	CPointStream( const CPointStream & );
+	/*! Not copyable. */
+	CPointStream & operator=( const CPointStream & );
+};
+
+inline CPointStream::CPointStream()
+{
+	m_fp        = NULL;
+	m_format    = XYZ;
+	m_dimension = 3;
+	m_done      = true;
+	m_stop      = false;
+	m_count     = 0;
+};
+
+inline CPointStream::Format CPointStream::format_of( const char * filename )
+{
+	const char * dot = strrchr( filename, '.' );
+	if( dot == NULL ) return XYZ;
+	if( strcmp( dot, ".csv" ) == 0 ) return CSV;
+	if( strcmp( dot, ".f32" ) == 0 ) return FLOAT32;
+	if( strcmp( dot, ".f64" ) == 0 ) return FLOAT64;
+	return XYZ;
+};
+
+inline bool CPointStream::open( const char * filename, Format format, int dimension )
+{
+	close();
+
+	if( strcmp( filename, "-" ) == 0 )
+	{
+		m_fp = stdin;
+#ifdef _WIN32
+		//stdin is a text stream on Windows, which would translate the bytes of binary points
+		_setmode( _fileno( stdin ), _O_BINARY );
+#endif
+	}
+	else
+	{
+		m_fp = fopen( filename, "rb" );
+		if( m_fp == NULL ) return false;
+	}
+
+	m_format    = format;
+	m_dimension = ( dimension == 2 ) ? 2 : 3;
+	m_done      = false;
+	m_stop      = false;
+	m_count     = 0;
+	m_min       = CPoint(  1e300,  1e300,  1e300 );
+	m_max       = CPoint( -1e300, -1e300, -1e300 );
+
+	m_reader = std::thread( &CPointStream::_read, this );
+	return true;
+};
+
+inline void CPointStream::close()
+{
+	if( m_reader.joinable() )
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_stop = true;
+		}
+		m_changed.notify_all();
+		m_reader.join();
+	}
+	if( m_fp != NULL && m_fp != stdin ) fclose( m_fp );
+	m_fp = NULL;
+	m_queue.clear();
+	m_done = true;
+};
+
+inline bool CPointStream::next( std::vector<CPoint> & batch )
+{
+	std::unique_lock<std::mutex> lock( m_mutex );
+	while( m_queue.empty() && !m_done ) m_changed.wait( lock );
+	if( m_queue.empty() ) return false;
+
+	batch.swap( m_queue.front() );
+	m_queue.pop_front();
+	lock.unlock();
+	m_changed.notify_all();
+
+	for( size_t i = 0; i < batch.size(); i ++ )
+	{
+		for( int k = 0; k < 3; k ++ )
+		{
+			m_min[k] = std::min( m_min[k], batch[i][k] );
+			m_max[k] = std::max( m_max[k], batch[i][k] );
+		}
+	}
+	m_count += batch.size();
+	return true;
+};
+
+inline bool CPointStream::_push( std::vector<CPoint> & batch )
+{
+	std::unique_lock<std::mutex> lock( m_mutex );
+	while( m_queue.size() >= QUEUE_SIZE && !m_stop ) m_changed.wait( lock );
+	if( m_stop ) return false;
+
+	m_queue.push_back( std::vector<CPoint>() );
+	m_queue.back().swap( batch );
+	lock.unlock();
+	m_changed.notify_all();
+	return true;
+};
+
+inline void CPointStream::_read()
+{
+	//a block holds the tail of the previous one, an incomplete line or record
+	std::vector<char> block( BLOCK_SIZE );
+	size_t filled = 0;
+	bool   text   = ( m_format == XYZ || m_format == CSV );
+
+	while( true )
+	{
+		size_t n    = fread( &block[0] + filled, 1, block.size() - filled, m_fp );
+		bool   last = ( n == 0 );
+		filled += n;
+
+		std::vector<CPoint> batch;
+		const char * begin = &block[0];
+		size_t used = text ? _parse_text( begin, begin + filled, last, batch ) : _parse_binary( begin, begin + filled, batch );
+
+		if( !batch.empty() && !_push( batch ) ) break;
+		if( last ) break;
+
+		//keep the tail, grow the block for lines longer than a block
+		memmove( &block[0], &block[0] + used, filled - used );
+		filled -= used;
+		if( filled == block.size() ) block.resize( block.size() * 2 );
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_done = true;
+	}
+	m_changed.notify_all();
+};
+
+inline size_t CPointStream::_parse_text( const char * begin, const char * end, bool last, std::vector<CPoint> & batch )
+{
+	//only complete lines, unless the input ended
+	const char * stop = end;
+	if( !last )
+	{
+		while( stop > begin && stop[-1] != '\n' ) stop --;
+	}
+
+	CTextScanner scanner( begin, stop );
+	CStringView  line;
+	while( scanner.next_line( line ) )
+	{
+		const char * p = line.begin();
+		const char * e = line.end();
+		CPoint pt;
+		int    k = 0;
+		while( k < 3 )
+		{
+			while( p < e && ( *p == ' ' || *p == '\t' || *p == ',' || *p == ';' ) ) p ++;
+			if( p == e || !fast_parse_double( p, e, pt[k] ) ) break;
+			k ++;
+		}
+		if( k >= 2 ) batch.push_back( pt );
+	}
+	return (size_t)( stop - begin );
+};
+
+inline size_t CPointStream::_parse_binary( const char * begin, const char * end, std::vector<CPoint> & batch )
+{
+	size_t scalar = ( m_format == FLOAT32 ) ? sizeof(float) : sizeof(double);
+	size_t record = scalar * m_dimension;
+	size_t n      = (size_t)( end - begin ) / record;
+
+	batch.resize( n );
+	for( size_t i = 0; i < n; i ++ )
+	{
+		const char * r = begin + i * record;
+		for( int k = 0; k < m_dimension; k ++ )
+		{
+			if( m_format == FLOAT32 )
+			{
+				float v;
+				memcpy( &v, r + k * scalar, sizeof(float) );
+				batch[i][k] = v;
+			}
+			else
+			{
+				memcpy( &batch[i][k], r + k * scalar, sizeof(double) );
+			}
+		}
+	}
+	return n * record;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_POINT_STREAM_H_ defined
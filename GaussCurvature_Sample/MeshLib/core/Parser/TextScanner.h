@@ -0,0 +1,243 @@
+/*!
+*      \file TextScanner.h
+*      \brief Allocation free scanning of lines, tokens and numbers in a block of text
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_TEXT_SCANNER_H_
+#define _MESHLIB_TEXT_SCANNER_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+namespace MeshLib{
+
+/*!
+*	\brief CStringView, a range of characters owned by somebody else
+*/
+class CStringView
+{
+public:
+	/*!	Empty view. */
+	CStringView() { m_begin = m_end = NULL; };
+	/*!	View of [begin,end). */
+	CStringView( const char * begin, const char * end ) { m_begin = begin; m_end = end; };
+
+	/*! First character. */
+	const char * begin() const { return m_begin; };
+	/*! One past the last character. */
+	const char * end()   const { return m_end; };
+	/*! Number of characters. */
+	size_t size()  const { return (size_t)( m_end - m_begin ); };
+	/*! Whether the view is empty. */
+	bool   empty() const { return m_end == m_begin; };
+	/*! Compare with a zero terminated string. */
+	bool operator==( const char * s ) const
+	{
+		size_t n = strlen( s );
+		return n == size() && memcmp( m_begin, s, n ) == 0;
+	};
+	/*! Copy into a std::string. */
+	std::string str() const { return std::string( m_begin, m_end ); };
+
+protected:
+	/*! First character. */
+	const char * m_begin;
+	/*! One past the last character. */
+	const char * m_end;
+};
+
+/*!
+	Parse a decimal floating point number starting at p, p is moved behind the number.
+	Numbers with at most 15 significant digits and a decimal exponent within 22 are exactly
+	representable as a quotient or product of two doubles and converted directly, all the
+	others ( and inf, nan ) go through strtod, so the result is always correctly rounded.
+	\param p     current position
+	\param end   end of the text
+	\param value the parsed number
+	\return whether a number was found
+*/
+inline bool fast_parse_double( const char *& p, const char * end, double & value )
+{
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const char * s = p;
+	bool negative = false;
+	if( s < end && ( *s == '-' || *s == '+' ) ) { negative = ( *s == '-' ); s ++; }
+
+	unsigned long long mantissa = 0;
+	int  digits   = 0;
+	int  exponent = 0;
+	bool any      = false;
+	bool exact    = true;
+
+	for( ; s < end && *s >= '0' && *s <= '9'; s ++ )
+	{
+		any = true;
+		if( digits < 19 ) { mantissa = mantissa * 10 + ( *s - '0' ); if( mantissa ) digits ++; }
+		else { exponent ++; if( *s != '0' ) exact = false; }
+	}
+	if( s < end && *s == '.' )
+	{
+		for( s ++; s < end && *s >= '0' && *s <= '9'; s ++ )
+		{
+			any = true;
+			if( digits < 19 ) { mantissa = mantissa * 10 + ( *s - '0' ); if( mantissa ) digits ++; exponent --; }
+			else if( *s != '0' ) exact = false;
+		}
+	}
+
+	if( any && s < end && ( *s == 'e' || *s == 'E' ) )
+	{
+		const char * e = s + 1;
+		bool eneg = false;
+		if( e < end && ( *e == '-' || *e == '+' ) ) { eneg = ( *e == '-' ); e ++; }
+		if( e < end && *e >= '0' && *e <= '9' )
+		{
+			int x = 0;
+			for( ; e < end && *e >= '0' && *e <= '9'; e ++ ) if( x < 100000 ) x = x * 10 + ( *e - '0' );
+			exponent += eneg ? -x : x;
+			s = e;
+		}
+	}
+
+	if( any && exact && digits <= 15 && exponent >= -22 && exponent <= 22 )
+	{
+		double v = (double) mantissa;
+		v = ( exponent < 0 ) ? v / pow10[-exponent] : v * pow10[exponent];
+		value = negative ? -v : v;
+		p = s;
+		return true;
+	}
+
+	//general case, strtod needs a terminated copy
+	char buffer[128];
+	size_t n = (size_t)( end - p );
+	if( n > sizeof( buffer ) - 1 ) n = sizeof( buffer ) - 1;
+	memcpy( buffer, p, n );
+	buffer[n] = 0;
+
+	char * stop = NULL;
+	double v = strtod( buffer, &stop );
+	if( stop == buffer ) return false;
+	value = v;
+	p += ( stop - buffer );
+	return true;
+};
+
+/*!
+	Parse a decimal integer starting at p, p is moved behind the number.
+	\param p     current position
+	\param end   end of the text
+	\param value the parsed number
+	\return whether a number was found
+*/
+inline bool fast_parse_int( const char *& p, const char * end, int & value )
+{
+	const char * s = p;
+	bool negative = false;
+	if( s < end && ( *s == '-' || *s == '+' ) ) { negative = ( *s == '-' ); s ++; }
+	if( s == end || *s < '0' || *s > '9' ) return false;
+
+	long long v = 0;
+	for( ; s < end && *s >= '0' && *s <= '9'; s ++ )
+	{
+		v = v * 10 + ( *s - '0' );
+	}
+	value = (int)( negative ? -v : v );
+	p = s;
+	return true;
+};
+
+/*!
+*	\brief CLineScanner, splits one line into blank separated tokens and numbers
+*/
+class CLineScanner
+{
+public:
+	/*!	Scan the line [begin,end). */
+	CLineScanner( const char * begin, const char * end ) { m_p = begin; m_end = end; };
+	/*!	Scan a line. */
+	CLineScanner( const CStringView & line ) { m_p = line.begin(); m_end = line.end(); };
+
+	/*! Skip blanks, return whether anything is left. */
+	bool skip_blanks()
+	{
+		while( m_p < m_end && ( *m_p == ' ' || *m_p == '\t' || *m_p == '\r' ) ) m_p ++;
+		return m_p < m_end;
+	};
+	/*! The next blank separated token. */
+	bool token( CStringView & t )
+	{
+		if( !skip_blanks() ) return false;
+		const char * b = m_p;
+		while( m_p < m_end && *m_p != ' ' && *m_p != '\t' && *m_p != '\r' ) m_p ++;
+		t = CStringView( b, m_p );
+		return true;
+	};
+	/*! The next integer, fails on anything else, e.g. a trait. */
+	bool parse_int( int & v )       { return skip_blanks() && fast_parse_int( m_p, m_end, v ); };
+	/*! The next floating point number. */
+	bool parse_double( double & v ) { return skip_blanks() && fast_parse_double( m_p, m_end, v ); };
+	/*!
+		The content of the next {...} block of the line, without the braces.
+		\return false if there is no block, or the block is empty
+	*/
+	bool trait( CStringView & t )
+	{
+		const char * sp = (const char*) memchr( m_p, '{', m_end - m_p );
+		if( sp == NULL ) return false;
+		const char * ep = (const char*) memchr( sp, '}', m_end - sp );
+		if( ep == NULL ) return false;
+		m_p = ep + 1;
+		t = CStringView( sp + 1, ep );
+		return !t.empty();
+	};
+	/*! The rest of the line. */
+	CStringView rest() { return CStringView( m_p, m_end ); };
+
+protected:
+	/*! Current position. */
+	const char * m_p;
+	/*! End of the line. */
+	const char * m_end;
+};
+
+/*!
+*	\brief CTextScanner, splits a block of text into lines
+*/
+class CTextScanner
+{
+public:
+	/*!	Scan the text [begin,end). */
+	CTextScanner( const char * begin, const char * end ) { m_p = begin; m_end = end; };
+
+	/*!
+		The next line, without the line break.
+		\return false at the end of the text
+	*/
+	bool next_line( CStringView & line )
+	{
+		if( m_p >= m_end ) return false;
+		const char * e = (const char*) memchr( m_p, '\n', m_end - m_p );
+		if( e == NULL ) e = m_end;
+		line = CStringView( m_p, ( e > m_p && e[-1] == '\r' ) ? e - 1 : e );
+		m_p = ( e < m_end ) ? e + 1 : m_end;
+		return true;
+	};
+	/*! Current position, the beginning of the next line. */
+	const char * position() { return m_p; };
+
+protected:
+	/*! Current position. */
+	const char * m_p;
+	/*! End of the text. */
+	const char * m_end;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_TEXT_SCANNER_H_ defined
@@ -0,0 +1,229 @@
+/*!
+*      \file TextWriter.h
+*      \brief Block buffered text output with fast number formatting
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_TEXT_WRITER_H_
+#define _MESHLIB_TEXT_WRITER_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "../Parallel/ThreadPool.h"
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && ( __cplusplus >= 201703L || ( defined(_MSVC_LANG) && _MSVC_LANG >= 201703L ) )
+#include <charconv>
+#endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define MESHLIB_HAS_TO_CHARS
+#endif
+
+namespace MeshLib{
+
+/*!
+	Format a double in the shortest form which reads back to the same value, by std::to_chars
+	where the standard library has it, otherwise with 17 significant digits.
+	\param buffer at least 32 characters, not terminated
+	\param v      the value
+	\return number of characters
+*/
+inline size_t format_double( char * buffer, double v )
+{
+#ifdef MESHLIB_HAS_TO_CHARS
+	std::to_chars_result r = std::to_chars( buffer, buffer + 32, v );
+	return (size_t)( r.ptr - buffer );
+#else
+	char text[32];
+	int n = snprintf( text, sizeof( text ), "%.17g", v );
+	memcpy( buffer, text, n );
+	return (size_t) n;
+#endif
+};
+
+/*!
+*	\brief CTextBuffer, text formatted into memory
+*
+*	Doubles are written by format_double, they read back to the same value.
+*/
+class CTextBuffer
+{
+public:
+	/*!	Constructor, the buffer is empty. */
+	CTextBuffer() {};
+
+	/*! Append a character. */
+	void put( char c )                  { m_text.push_back( c ); };
+	/*! Append a zero terminated string. */
+	void put( const char * s )          { m_text.append( s ); };
+	/*! Append n characters. */
+	void put( const char * s, size_t n ){ m_text.append( s, n ); };
+	/*! Append a string. */
+	void put( const std::string & s )   { m_text.append( s ); };
+	/*! Append an integer. */
+	void put_int( long long v );
+	/*! Append a double. */
+	void put_double( double v );
+
+	/*! Formatted text. */
+	const char * data() const { return m_text.data(); };
+	/*! Number of characters. */
+	size_t       size() const { return m_text.size(); };
+	/*! Remove the text, the memory is kept. */
+	void         clear()      { m_text.clear(); };
+
+protected:
+	/*! the text */
+	std::string m_text;
+};
+
+inline void CTextBuffer::put_int( long long v )
+{
+	char buffer[24];
+	char * p = buffer + sizeof( buffer );
+	unsigned long long u = ( v < 0 ) ? 0ULL - (unsigned long long) v : (unsigned long long) v;
+	do{
+		*--p = (char)( '0' + u % 10 );
+		u /= 10;
+	}while( u != 0 );
+	if( v < 0 ) *--p = '-';
+	m_text.append( p, buffer + sizeof( buffer ) - p );
+};
+
+inline void CTextBuffer::put_double( double v )
+{
+	char buffer[32];
+	m_text.append( buffer, format_double( buffer, v ) );
+};
+
+/*!
+*	\brief CTextWriter, a text file written in large blocks
+*
+*	Lines are formatted into the buffer, which goes to the file whenever it exceeds
+*	BLOCK_SIZE bytes. Nothing is flushed per line.
+*/
+class CTextWriter : public CTextBuffer
+{
+public:
+	/*!	Constructor, no file is open. */
+	CTextWriter() { m_fp = NULL; m_ok = true; };
+	/*!	Destructor, writes the rest and closes the file. */
+	~CTextWriter() { close(); };
+
+	/*!
+		Create a file.
+		\param filename name of the file
+		\return whether the file could be created
+	*/
+	bool open( const char * filename )
+	{
+		close();
+		m_fp = fopen( filename, "wb" );
+		m_ok = ( m_fp != NULL );
+		return m_ok;
+	};
+	/*!	Write the rest and close the file.
+		\return whether all the text was written
+	*/
+	bool close()
+	{
+		if( m_fp == NULL ) return m_ok;
+		flush();
+		fclose( m_fp );
+		m_fp = NULL;
+		return m_ok;
+	};
+
+	/*! End a line, the buffer goes to the file once it is large. */
+	void end_line()
+	{
+		m_text.push_back( '\n' );
+		if( m_text.size() >= BLOCK_SIZE ) flush();
+	};
+	/*! Write the buffer to the file. */
+	void flush()
+	{
+		if( m_fp != NULL && !m_text.empty() )
+		{
+			m_ok = m_ok && fwrite( m_text.data(), 1, m_text.size(), m_fp ) == m_text.size();
+		}
+		m_text.clear();
+	};
+	/*! Write text formatted elsewhere, after the buffered one. */
+	void write( const CTextBuffer & text )
+	{
+		flush();
+		if( m_fp != NULL && text.size() > 0 )
+		{
+			m_ok = m_ok && fwrite( text.data(), 1, text.size(), m_fp ) == text.size();
+		}
+	};
+
+	/*! size of the blocks written to the file */
+	enum { BLOCK_SIZE = 1 << 20 };
+
+protected:
+	/*! the file */
+	FILE * m_fp;
+	/*! whether all writes succeeded */
+	bool   m_ok;
+
+private:
+	/*! Not copyable. */
+	CTextWriter( const CTextWriter & );
+	/*! Not copyable. */
+	CTextWriter & operator=( const CTextWriter & );
+};
+
+/*!
+	Format n records and write them in order.
+	The records are cut into rounds of nthreads chunks, every chunk is formatted into its
+	own buffer as a task of CThreadPool, then the buffers are written one after the other,
+	so the output is the same for any number of threads. format( buffer, i ) appends the
+	lines of record i including their line breaks, it must not modify shared state.
+	\param writer   the output
+	\param n        number of records
+	\param format   the formatter
+	\param nthreads chunks per round, 0 for one per thread of the pool, 1 to format in the calling thread
+*/
+template<typename F>
+void format_parallel( CTextWriter & writer, size_t n, F format, int nthreads = 0 )
+{
+	//records per chunk
+	const size_t chunk = 1 << 15;
+
+	if( nthreads <= 0 ) nthreads = CThreadPool::instance().size();
+	nthreads = (int) std::max( (size_t) 1, std::min( (size_t) nthreads, n / chunk ) );
+
+	if( nthreads == 1 )
+	{
+		for( size_t i = 0; i < n; i ++ )
+		{
+			format( (CTextBuffer&) writer, i );
+			if( writer.size() >= CTextWriter::BLOCK_SIZE ) writer.flush();
+		}
+		return;
+	}
+
+	std::vector<CTextBuffer> buffers( nthreads );
+	for( size_t round = 0; round < n; round += chunk * nthreads )
+	{
+		CThreadPool::instance().run( nthreads, [&]( size_t t, int ){
+			size_t b = std::min( n, round + chunk * t );
+			size_t e = std::min( n, b + chunk );
+			buffers[t].clear();
+			for( size_t i = b; i < e; i ++ ) format( buffers[t], i );
+		} );
+		for( int t = 0; t < nthreads; t ++ ) writer.write( buffers[t] );
+	}
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_TEXT_WRITER_H_ defined
@@ -0,0 +1,223 @@
+/*!
+*      \file TraitParser.h
+*      \brief Allocation free parsing and in place writing of trait strings, key=(value) key ...
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_TRAIT_PARSER_H_
+#define _MESHLIB_TRAIT_PARSER_H_
+
+#include <string.h>
+#include <string>
+#include "TextScanner.h"
+#include "TextWriter.h"
+#include "../Geometry/Point.h"
+#include "../Geometry/Point2.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CTraitParser, walks the tokens of a trait string, e.g. "uv=(0.5 0.25) father=(12) sharp"
+*
+*	Tokens are separated by blanks. A token is either key=(value) or a bare key, whose value is
+*	empty. Keys and values are views into the string, which must outlive the parser, nothing is
+*	copied. The static members parse values into numbers and points, and edit a trait string in
+*	place.
+*/
+class CTraitParser
+{
+public:
+	/*!	Parse the trait [begin,end). */
+	CTraitParser( const char * begin, const char * end ) { m_begin = m_p = begin; m_end = end; };
+	/*!	Parse a trait, e.g. the {...} block of a line. */
+	CTraitParser( const CStringView & trait ) { m_begin = m_p = trait.begin(); m_end = trait.end(); };
+	/*!	Parse a trait string. */
+	CTraitParser( const std::string & trait )
+	{
+		m_begin = m_p = trait.c_str();
+		m_end   = m_begin + trait.size();
+	};
+
+	/*!
+		The next token.
+		\param key   the key
+		\param value the text between the parentheses, empty for a bare key
+		\return false at the end of the trait
+	*/
+	bool next( CStringView & key, CStringView & value )
+	{
+		const char * head;
+		return _next( key, value, head );
+	};
+	/*!
+		Find the first token with the key, from the beginning of the trait.
+		\param key   the key
+		\param value the value of the token
+		\return whether the key is present
+	*/
+	bool find( const char * key, CStringView & value )
+	{
+		m_p = m_begin;
+		CStringView k;
+		while( next( k, value ) )
+		{
+			if( k == key ) return true;
+		}
+		return false;
+	};
+	/*!
+		Parse the value of the first token with the key, e.g. get( "uv", v->uv() ).
+		\return false if the key is missing or its value is not a T
+	*/
+	template<typename T>
+	bool get( const char * key, T & v )
+	{
+		CStringView value;
+		return find( key, value ) && parse( value, v );
+	};
+
+	/*! Parse a value as a double. */
+	static bool parse( const CStringView & value, double & v ) { return parse( value, &v, 1 ); };
+	/*! Parse a value as a float. */
+	static bool parse( const CStringView & value, float & v )
+	{
+		double d;
+		if( !parse( value, &d, 1 ) ) return false;
+		v = (float) d;
+		return true;
+	};
+	/*! Parse a value as an int. */
+	static bool parse( const CStringView & value, int & v )
+	{
+		const char * p = _skip( value.begin(), value.end() );
+		return fast_parse_int( p, value.end(), v );
+	};
+	/*! Parse a value (x y z) as a point. */
+	static bool parse( const CStringView & value, CPoint & v )  { return parse( value, &v[0], 3 ); };
+	/*! Parse a value (u v) as a point in the plane. */
+	static bool parse( const CStringView & value, CPoint2 & v ) { return parse( value, &v[0], 2 ); };
+	/*!
+		Parse n blank separated numbers.
+		\return whether n numbers were read
+	*/
+	static bool parse( const CStringView & value, double * v, int n )
+	{
+		const char * p = value.begin();
+		for( int i = 0; i < n; i ++ )
+		{
+			p = _skip( p, value.end() );
+			if( !fast_parse_double( p, value.end(), v[i] ) ) return false;
+		}
+		return true;
+	};
+
+	/*!
+		Append the token key=(v[0] v[1] ...) to a trait string, the numbers are written in the
+		shortest form which reads back to the same value.
+	*/
+	static void append( std::string & str, const char * key, const double * v, int n )
+	{
+		char buffer[40];
+		if( !str.empty() ) str += ' ';
+		str += key;
+		str += "=(";
+		for( int i = 0; i < n; i ++ )
+		{
+			size_t m = 0;
+			if( i > 0 ) buffer[m++] = ' ';
+			m += format_double( buffer + m, v[i] );
+			str.append( buffer, m );
+		}
+		str += ')';
+	};
+	/*! Append key=(v). */
+	static void append( std::string & str, const char * key, double v )         { append( str, key, &v, 1 ); };
+	/*! Append key=(x y z). */
+	static void append( std::string & str, const char * key, const CPoint & v )
+	{
+		double d[3] = { v[0], v[1], v[2] };
+		append( str, key, d, 3 );
+	};
+	/*! Append key=(u v). */
+	static void append( std::string & str, const char * key, const CPoint2 & v )
+	{
+		double d[2] = { v[0], v[1] };
+		append( str, key, d, 2 );
+	};
+	/*!
+		Remove the first token with the key from a trait string, with its separating blanks.
+		\return whether a token was removed
+	*/
+	static bool remove( std::string & str, const char * key )
+	{
+		CTraitParser parser( str );
+		CStringView  k, value;
+		const char * head;
+		while( parser._next( k, value, head ) )
+		{
+			if( !( k == key ) ) continue;
+
+			size_t begin = head - str.c_str();
+			size_t end   = parser.m_p - str.c_str();
+			while( end < str.size() && str[end] == ' ' ) end ++;
+			while( begin > 0 && end == str.size() && str[begin-1] == ' ' ) begin --;
+			str.erase( begin, end - begin );
+			return true;
+		}
+		return false;
+	};
+
+protected:
+	/*! Skip blanks. */
+	static const char * _skip( const char * p, const char * end )
+	{
+		while( p < end && ( *p == ' ' || *p == '\t' ) ) p ++;
+		return p;
+	};
+	/*! The next token, head is its first character. */
+	bool _next( CStringView & key, CStringView & value, const char *& head )
+	{
+		m_p = _skip( m_p, m_end );
+		if( m_p >= m_end ) return false;
+
+		head = m_p;
+		while( m_p < m_end && *m_p != ' ' && *m_p != '\t' && *m_p != '=' ) m_p ++;
+		key = CStringView( head, m_p );
+
+		if( m_p == m_end || *m_p != '=' )
+		{
+			value = CStringView( m_p, m_p );
+			return true;
+		}
+
+		//key=(value), or key=value up to the next blank
+		m_p = _skip( m_p + 1, m_end );
+		if( m_p < m_end && *m_p == '(' )
+		{
+			const char * b = m_p + 1;
+			const char * e = (const char*) memchr( b, ')', m_end - b );
+			if( e == NULL ) e = m_end;
+			value = CStringView( b, e );
+			m_p   = ( e < m_end ) ? e + 1 : m_end;
+		}
+		else
+		{
+			const char * b = m_p;
+			while( m_p < m_end && *m_p != ' ' && *m_p != '\t' ) m_p ++;
+			value = CStringView( b, m_p );
+		}
+		return true;
+	};
+
+	/*! Beginning of the trait. */
+	const char * m_begin;
+	/*! Current position. */
+	const char * m_p;
+	/*! End of the trait. */
+	const char * m_end;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_TRAIT_PARSER_H_ defined
@@ -0,0 +1,154 @@
+/*!
+*      \file ConjugateGradient.h
+*      \brief Preconditioned conjugate gradient solver for sparse symmetric positive definite systems
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_CONJUGATE_GRADIENT_H_
+#define _MESHLIB_CONJUGATE_GRADIENT_H_
+
+#include <math.h>
+#include <vector>
+#include "SparseMatrix.h"
+#include "../Parallel/ThreadPool.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CPreconditioner, approximate inverse of a matrix, applied once per iteration of
+*	CConjugateGradient; it must be symmetric positive definite
+*/
+class CPreconditioner
+{
+public:
+	virtual ~CPreconditioner() {};
+	/*! z = M^-1 r, z is resized */
+	virtual void apply( const std::vector<double> & r, std::vector<double> & z ) = 0;
+};
+
+/*!
+*	\brief CConjugateGradient, solves A x = b for a symmetric positive definite matrix A
+*
+*	Without a preconditioner, the inverse of the diagonal of A ( Jacobi ) is used, so that
+*	every step is a parallel product with A and a few parallel vector operations. The dot
+*	products are compensated sums over fixed chunks, the iterates are the same on any
+*	number of threads.
+*/
+class CConjugateGradient
+{
+public:
+	/*!
+		Solver for the matrix A, which must outlive the solver, as the preconditioner.
+		\param A square, symmetric, positive definite matrix
+		\param P preconditioner, Jacobi if NULL
+	*/
+	CConjugateGradient( const CSparseMatrix & A, CPreconditioner * P = NULL );
+
+	/*! Stop once |b - A x| <= tolerance |b|, 1e-10 by default. */
+	double & tolerance()     { return m_tolerance; };
+	/*! Maximal number of iterations, 10000 by default. */
+	int    & max_iterations(){ return m_max_iterations; };
+	/*! Relative residual |b - A x| / |b| after the last solve. */
+	double residual() const  { return m_residual; };
+
+	/*!
+		Solve A x = b.
+		\param b right hand side
+		\param x the initial guess, zero if it is empty, replaced by the solution
+		\return number of iterations, -1 if the tolerance was not met
+	*/
+	int solve( const std::vector<double> & b, std::vector<double> & x );
+
+protected:
+	/*! dot product of two vectors, in parallel */
+	static double _dot( const std::vector<double> & a, const std::vector<double> & b )
+	{
+		return parallel_sum( 0, a.size(), [&]( size_t i ){ return a[i] * b[i]; } );
+	};
+
+	/*! z = M^-1 r */
+	void _precondition( const std::vector<double> & r, std::vector<double> & z );
+
+	/*! the matrix */
+	const CSparseMatrix & m_A;
+	/*! the preconditioner, NULL for Jacobi */
+	CPreconditioner *     m_P;
+	/*! inverse of the diagonal of the matrix, for Jacobi */
+	std::vector<double>   m_inverse_diagonal;
+	/*! relative tolerance */
+	double                m_tolerance;
+	/*! maximal number of iterations */
+	int                   m_max_iterations;
+	/*! relative residual of the last solve */
+	double                m_residual;
+};
+
+inline CConjugateGradient::CConjugateGradient( const CSparseMatrix & A, CPreconditioner * P ) : m_A( A ), m_P( P )
+{
+	m_tolerance      = 1e-10;
+	m_max_iterations = 10000;
+	m_residual       = 0;
+	if( m_P != NULL ) return;
+	m_inverse_diagonal = A.diagonal();
+	for( size_t i = 0; i < m_inverse_diagonal.size(); i ++ )
+	{
+		double d = m_inverse_diagonal[i];
+		m_inverse_diagonal[i] = ( d != 0 ) ? 1.0 / d : 1.0;
+	}
+};
+
+inline void CConjugateGradient::_precondition( const std::vector<double> & r, std::vector<double> & z )
+{
+	if( m_P != NULL )
+	{
+		m_P->apply( r, z );
+		return;
+	}
+	z.resize( r.size() );
+	parallel_for( 0, r.size(), [&]( size_t i ){ z[i] = m_inverse_diagonal[i] * r[i]; } );
+};
+
+inline int CConjugateGradient::solve( const std::vector<double> & b, std::vector<double> & x )
+{
+	size_t n = b.size();
+	if( x.size() != n ) x.assign( n, 0.0 );
+
+	std::vector<double> r( n ), z( n ), p( n ), q( n );
+	m_A.multiply( x, q );
+	parallel_for( 0, n, [&]( size_t i ){ r[i] = b[i] - q[i]; } );
+	_precondition( r, z );
+	p = z;
+
+	double norm_b = sqrt( _dot( b, b ) );
+	if( norm_b == 0 ) norm_b = 1;
+	double rz = _dot( r, z );
+	m_residual = sqrt( _dot( r, r ) ) / norm_b;
+
+	for( int iter = 0; iter < m_max_iterations; iter ++ )
+	{
+		if( m_residual <= m_tolerance ) return iter;
+
+		m_A.multiply( p, q );
+		double pq = _dot( p, q );
+		if( pq <= 0 ) return -1;
+		double alpha = rz / pq;
+		parallel_for( 0, n, [&]( size_t i )
+		{
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+		} );
+		_precondition( r, z );
+
+		double rz_next = _dot( r, z );
+		double beta    = rz_next / rz;
+		rz = rz_next;
+		parallel_for( 0, n, [&]( size_t i ){ p[i] = z[i] + beta * p[i]; } );
+		m_residual = sqrt( _dot( r, r ) ) / norm_b;
+	}
+	return ( m_residual <= m_tolerance ) ? m_max_iterations : -1;
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_CONJUGATE_GRADIENT_H_ defined
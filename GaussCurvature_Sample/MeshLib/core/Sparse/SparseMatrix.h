@@ -0,0 +1,200 @@
+/*!
+*      \file SparseMatrix.h
+*      \brief Sparse matrix in compressed sparse row storage, with a parallel product
+*      \date 10/19/2026
+*
+*/
+
+#ifndef _MESHLIB_SPARSE_MATRIX_H_
+#define _MESHLIB_SPARSE_MATRIX_H_
+
+#include <assert.h>
+#include <stddef.h>
+#include <algorithm>
+#include <vector>
+#include "../Parallel/ThreadPool.h"
+
+namespace MeshLib{
+
+/*!
+*	\brief CSparseMatrix, matrix in compressed sparse row ( CSR ) storage
+*
+*	The entries of row i are [offset(i),offset(i+1)) of the column and value arrays. The
+*	structure is set once by reserve() from the sizes of the rows, then every row fills its
+*	own entries, such that the rows can be assembled in parallel. The columns of a row need
+*	not be sorted, a column appears at most once in a row. The products with vectors and
+*	matrices compute their rows in parallel.
+*/
+class CSparseMatrix
+{
+public:
+	/*!	Empty matrix. */
+	CSparseMatrix() : m_cols( 0 ) {};
+
+	/*!
+		Set the structure, the columns and values are zero.
+		\param sizes number of entries of every row
+		\param cols  number of columns
+	*/
+	void reserve( const std::vector<int> & sizes, int cols );
+
+	/*! Number of rows. */
+	int    rows()     const { return (int) m_offset.size() - 1; };
+	/*! Number of columns. */
+	int    cols()     const { return m_cols; };
+	/*! Number of stored entries. */
+	size_t nonzeros() const { return m_value.size(); };
+
+	/*! First entry of row i. */
+	size_t offset( int i ) const { return m_offset[i]; };
+	/*! Column of entry k. */
+	int    & column( size_t k )       { return m_column[k]; };
+	int      column( size_t k ) const { return m_column[k]; };
+	/*! Value of entry k. */
+	double & value( size_t k )        { return m_value[k]; };
+	double   value( size_t k )  const { return m_value[k]; };
+
+	/*!	Value at row i and column j, 0 if it is not stored. */
+	double at( int i, int j ) const;
+	/*!	The diagonal, 0 where it is not stored. */
+	std::vector<double> diagonal() const;
+
+	/*!
+		y = A x, the rows are computed in parallel.
+		\param x vector of cols() values
+		\param y vector of rows() values, resized
+	*/
+	void multiply( const std::vector<double> & x, std::vector<double> & y ) const;
+	/*!
+		C = A B, the rows of C are computed in parallel.
+		\param B matrix of cols() rows
+		\param C the product, replaced
+	*/
+	void multiply( const CSparseMatrix & B, CSparseMatrix & C ) const;
+	/*!
+		T = A^T.
+		\param T the transpose, replaced
+	*/
+	void transpose( CSparseMatrix & T ) const;
+
+protected:
+	/*! number of columns */
+	int                 m_cols;
+	/*! first entry of every row, and one past the last */
+	std::vector<size_t> m_offset;
+	/*! column of every entry */
+	std::vector<int>    m_column;
+	/*! value of every entry */
+	std::vector<double> m_value;
+};
+
+inline void CSparseMatrix::reserve( const std::vector<int> & sizes, int cols )
+{
+	m_cols = cols;
+	m_offset.assign( sizes.size() + 1, 0 );
+	for( size_t i = 0; i < sizes.size(); i ++ ) m_offset[i+1] = m_offset[i] + sizes[i];
+	m_column.assign( m_offset.back(), 0 );
+	m_value.assign( m_offset.back(), 0.0 );
+};
+
+inline double CSparseMatrix::at( int i, int j ) const
+{
+	for( size_t k = m_offset[i]; k < m_offset[i+1]; k ++ )
+	{
+		if( m_column[k] == j ) return m_value[k];
+	}
+	return 0;
+};
+
+inline std::vector<double> CSparseMatrix::diagonal() const
+{
+	std::vector<double> d( rows(), 0.0 );
+	parallel_for( 0, rows(), [&]( size_t i ){ d[i] = at( (int) i, (int) i ); } );
+	return d;
+};
+
+inline void CSparseMatrix::multiply( const std::vector<double> & x, std::vector<double> & y ) const
+{
+	assert( (int) x.size() == m_cols );
+	y.resize( rows() );
+	parallel_for( 0, rows(), [&]( size_t i )
+	{
+		double s = 0;
+		for( size_t k = m_offset[i]; k < m_offset[i+1]; k ++ ) s += m_value[k] * x[ m_column[k] ];
+		y[i] = s;
+	} );
+};
+
+inline void CSparseMatrix::multiply( const CSparseMatrix & B, CSparseMatrix & C ) const
+{
+	assert( B.rows() == m_cols );
+	int n = rows();
+	int m = B.cols();
+
+	//row i of C merges the rows of B for the entries of row i, a thread marks the position
+	//of every column in the row it computes
+	std::vector< std::vector<int> >    columns( n );
+	std::vector< std::vector<double> > values( n );
+	std::vector<int> unmarked;
+	CThreadLocal< std::vector<int> > marks( unmarked );
+	parallel_for_chunks( 0, n, [&]( size_t first, size_t last, int thread )
+	{
+		std::vector<int> & mark = marks.local( thread );
+		if( mark.empty() ) mark.assign( m, -1 );
+		for( size_t i = first; i < last; i ++ )
+		{
+			std::vector<int>    & col = columns[i];
+			std::vector<double> & val = values[i];
+			for( size_t k = m_offset[i]; k < m_offset[i+1]; k ++ )
+			{
+				int j = m_column[k];
+				for( size_t l = B.m_offset[j]; l < B.m_offset[j+1]; l ++ )
+				{
+					int c = B.m_column[l];
+					if( mark[c] < 0 )
+					{
+						mark[c] = (int) col.size();
+						col.push_back( c );
+						val.push_back( 0 );
+					}
+					val[ mark[c] ] += m_value[k] * B.m_value[l];
+				}
+			}
+			for( size_t c = 0; c < col.size(); c ++ ) mark[ col[c] ] = -1;
+		}
+	} );
+
+	std::vector<int> sizes( n );
+	for( int i = 0; i < n; i ++ ) sizes[i] = (int) columns[i].size();
+	C.reserve( sizes, m );
+	parallel_for( 0, n, [&]( size_t i )
+	{
+		std::copy( columns[i].begin(), columns[i].end(), C.m_column.begin() + C.m_offset[i] );
+		std::copy( values[i].begin(),  values[i].end(),  C.m_value.begin()  + C.m_offset[i] );
+		std::vector<int>().swap( columns[i] );
+		std::vector<double>().swap( values[i] );
+	} );
+};
+
+inline void CSparseMatrix::transpose( CSparseMatrix & T ) const
+{
+	std::vector<int> sizes( m_cols, 0 );
+	for( size_t k = 0; k < m_column.size(); k ++ ) sizes[ m_column[k] ] ++;
+	T.reserve( sizes, rows() );
+
+	//rows in increasing order, such that the columns of T are sorted
+	std::vector<size_t> next( T.m_offset.begin(), T.m_offset.end() - 1 );
+	for( int i = 0; i < rows(); i ++ )
+	{
+		for( size_t k = m_offset[i]; k < m_offset[i+1]; k ++ )
+		{
+			size_t e = next[ m_column[k] ] ++;
+			T.m_column[e] = i;
+			T.m_value[e]  = m_value[k];
+		}
+	}
+};
+
+}//name space MeshLib
+
+#endif //_MESHLIB_SPARSE_MATRIX_H_ defined
@@ -0,0 +1,128 @@
+/*!
+*      \file TestAttributes.cpp
+*      \brief Tests of CAttributes, CParser and CTraitTable
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Mesh/Attributes.h"
+#include "Parser/parser.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include <string>
+#include <utility>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the tag of the attribute aI
+template<int I>
+struct CAttrN
+{
+	typedef double value_type;
+	static const char * name()
+	{
+		static const std::string key = "a" + std::to_string( I );
+		return key.c_str();
+	};
+};
+
+//the attributes of the tags CAttrN<0>, ..., CAttrN<n-1>
+template<typename Sequence> struct CAttributesN;
+template<int... I>
+struct CAttributesN< std::integer_sequence<int, I...> >
+{
+	typedef CAttributes< CAttrN<I>... > type;
+};
+
+//an element with more attributes than the bits of an int
+typedef CAttributesN< std::make_integer_sequence<int, 34> >::type CWideElement;
+
+MESHLIB_ATTRIBUTE( CAttrWeight, double,  "weight" )
+MESHLIB_ATTRIBUTE( CAttrCount,  int,     "count"  )
+MESHLIB_ATTRIBUTE( CAttrDir,    CPoint,  "dir"    )
+MESHLIB_ATTRIBUTE( CAttrTex,    CPoint2, "tex"    )
+
+//an element with an attribute of every value type
+class CTypedElement : public CAttributes<CAttrWeight, CAttrCount, CAttrDir, CAttrTex>
+{
+};
+
+}
+
+TEST( attributes_beyond_32_tags )
+{
+	//the first token of a key wins, for every tag
+	CWideElement e;
+	std::string trait( "a33=(5) a1=(3) a32=(4) a33=(6) a0=(1) a1=(7) other=(2)" );
+	bool other = e._attributes_from_trait( CStringView( trait.c_str(), trait.c_str() + trait.size() ) );
+	CHECK( other );
+	CHECK( e.attr< CAttrN<0> >()  == 1 );
+	CHECK( e.attr< CAttrN<1> >()  == 3 );
+	CHECK( e.attr< CAttrN<32> >() == 4 );
+	CHECK( e.attr< CAttrN<33> >() == 5 );
+	CHECK( e.attr< CAttrN<2> >()  == 0 );
+}
+
+TEST( attributes_typed_access )
+{
+	CTypedElement e;
+	CHECK( e.attr<CAttrWeight>() == 0 && e.attr<CAttrCount>() == 0 );
+	CHECK( e.attr<CAttrDir>()[0] == 0 && e.attr<CAttrTex>()[1] == 0 );
+
+	e.attr<CAttrWeight>() = 0.1;
+	e.attr<CAttrCount>()  = 7;
+	e.attr<CAttrDir>()    = CPoint( 1, -2, 0.5 );
+	e.attr<CAttrTex>()    = CPoint2( 0.25, 1e-20 );
+
+	//the tokens of the attributes are replaced, the other traits kept
+	std::string str( "rgb=(1 0 0) weight=(5)" );
+	e._attributes_to_string( str );
+	CHECK( str == "rgb=(1 0 0) weight=(0.1) count=(7) dir=(1 -2 0.5) tex=(0.25 1e-20)" );
+
+	//and read back to the same values
+	CTypedElement f;
+	f._attributes_from_string( str );
+	CHECK( f.attr<CAttrWeight>() == 0.1 && f.attr<CAttrCount>() == 7 );
+	CHECK( f.attr<CAttrDir>()[0] == 1 && f.attr<CAttrDir>()[1] == -2 && f.attr<CAttrDir>()[2] == 0.5 );
+	CHECK( f.attr<CAttrTex>()[0] == 0.25 && f.attr<CAttrTex>()[1] == 1e-20 );
+}
+
+TEST( parser_keeps_empty_values )
+{
+	CParser parser( "uv=(0.5 1) sharp empty=() rgb=(1 0 0)" );
+	std::string str;
+	parser._toString( str );
+	CHECK( str == "uv=(0.5 1) sharp empty=() rgb=(1 0 0)" );
+}
+
+TEST( trait_table_lifetime )
+{
+	size_t before = CTraitTable<CVertex>::size();
+
+	//a mesh without traits creates no entry, neither does writing it
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	{
+		CGCMesh mesh;
+		mesh.read_m( "test_torus.m" );
+		mesh.write_m( "test_torus_out.m" );
+		CHECK( CTraitTable<CVertex>::size() == before );
+		CHECK( !mesh.idVertex( 1 )->has_string() );
+		CTraitTable<CVertex>::set( mesh.idVertex( 1 ), std::string() );
+		CHECK( CTraitTable<CVertex>::size() == before );
+	}
+
+	//the traits which are no attributes are kept, and released with their elements
+	{
+		FILE * fp = fopen( "test_traits.m", "w" );
+		fprintf( fp, "Vertex 1 0 0 0 {k=(1) rgb=(1 0 0)}\nVertex 2 1 0 0 {k=(2)}\nVertex 3 0 1 0\nFace 1 1 2 3\n" );
+		fclose( fp );
+		CGCMesh mesh;
+		mesh.read_m( "test_traits.m" );
+		CHECK( CTraitTable<CVertex>::size() == before + 1 );
+		CHECK( mesh.idVertex( 1 )->k() == 1 && mesh.idVertex( 2 )->k() == 2 );
+		CHECK( mesh.idVertex( 1 )->has_string() && !mesh.idVertex( 2 )->has_string() );
+	}
+	CHECK( CTraitTable<CVertex>::size() == before );
+}
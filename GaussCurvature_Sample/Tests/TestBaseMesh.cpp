@@ -0,0 +1,173 @@
+/*!
+*      \file TestBaseMesh.cpp
+*      \brief Tests of CBaseMesh
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include <fstream>
+#include <iterator>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//every edge is found by its ends and sits in the edge list of the end with the smaller id
+void check_edge_lists( CGCMesh & mesh )
+{
+	size_t listed = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+	{
+		listed += mesh.vertexEdges( *viter ).size();
+	}
+	CHECK( listed == (size_t) mesh.numEdges() );
+
+	int found = 0;
+	for( CGCMesh::MeshEdgeIterator eiter( &mesh ); !eiter.end(); ++ eiter )
+	{
+		CGaussEdge   * e  = *eiter;
+		CGaussVertex * v1 = mesh.edgeVertex1( e );
+		CGaussVertex * v2 = mesh.edgeVertex2( e );
+		if( mesh.vertexEdge( v1, v2 ) == e && mesh.vertexEdge( v2, v1 ) == e ) found ++;
+	}
+	CHECK( found == mesh.numEdges() );
+}
+
+//the renumbered mesh has the counts, ids and edges of the input
+void check_compaction( const char * filename )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	int nv = mesh.numVertices(), ne = mesh.numEdges(), nf = mesh.numFaces();
+	check_edge_lists( mesh );
+
+	mesh.compact_and_reorder();
+	CHECK( mesh.numVertices() == nv );
+	CHECK( mesh.numEdges()    == ne );
+	CHECK( mesh.numFaces()    == nf );
+
+	int id = 1;
+	bool consecutive = true;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+	{
+		consecutive = consecutive && ( *viter )->id() == id ++ && mesh.idVertex( ( *viter )->id() ) == *viter;
+	}
+	CHECK( consecutive );
+	check_edge_lists( mesh );
+
+	//the edges survive a write and a read of the renumbered mesh
+	mesh.write_m( "test_compact_out.m" );
+	CGCMesh copy;
+	copy.read_m( "test_compact_out.m" );
+	CHECK( copy.numEdges() == ne );
+	check_edge_lists( copy );
+}
+
+}
+
+TEST( compact_and_reorder_edge_lists )
+{
+	Tests::write_torus( "test_torus.m", 24, 40 );
+	check_compaction( "test_torus.m" );
+
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_grid.m", 30, holes );
+	check_compaction( "test_grid.m" );
+}
+
+TEST( read_ply_truncated_vertices )
+{
+	Tests::write_torus( "test_torus.m", 12, 20 );
+	CGCMesh mesh;
+	mesh.read_m( "test_torus.m" );
+	mesh.write_ply( "test_torus.ply" );
+
+	//cut the file in the middle of the vertex records
+	std::ifstream in( "test_torus.ply", std::ios::binary );
+	std::string data( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+	size_t body = data.find( "end_header\n" ) + 11;
+	std::ofstream out( "test_truncated.ply", std::ios::binary );
+	out.write( data.data(), body + ( data.size() - body ) / 8 );
+	out.close();
+
+	//nothing after the truncated vertex is read as faces
+	CGCMesh truncated;
+	truncated.read_ply( "test_truncated.ply" );
+	CHECK( truncated.numVertices() < mesh.numVertices() );
+	CHECK( truncated.numFaces() == 0 );
+}
+
+TEST( read_mb_round_trip_and_bad_index )
+{
+	std::vector<int> holes;
+	holes.push_back( 17 );
+	Tests::write_grid( "test_grid.m", 20, holes );
+	CGCMesh mesh;
+	mesh.read_m( "test_grid.m" );
+	mesh.write_mb( "test_grid.mb" );
+
+	CGCMesh copy;
+	CHECK( copy.read_mb( "test_grid.mb" ) );
+	CHECK( copy.numVertices() == mesh.numVertices() );
+	CHECK( copy.numEdges()    == mesh.numEdges() );
+	CHECK( copy.numFaces()    == mesh.numFaces() );
+	int same = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+	{
+		CGaussVertex * v = *viter;
+		CGaussVertex * w = copy.idVertex( v->id() );
+		if( w != NULL && w->boundary() == v->boundary() && ( w->point() - v->point() ).norm() == 0 ) same ++;
+	}
+	CHECK( same == mesh.numVertices() );
+	check_edge_lists( copy );
+
+	//a corner naming a vertex beyond the file fails the read, nothing is created
+	CBinaryMeshHeader h;
+	std::fstream file( "test_grid.mb", std::ios::in | std::ios::out | std::ios::binary );
+	file.read( (char*) &h, sizeof( h ) );
+	int index = mesh.numVertices() + 3;
+	file.seekp( (std::streamoff)( h.corner_offset + 5 * sizeof(int) ) );
+	file.write( (const char*) &index, sizeof(int) );
+	file.close();
+
+	CGCMesh bad;
+	CHECK( !bad.read_mb( "test_grid.mb" ) );
+	CHECK( bad.numVertices() == 0 && bad.numFaces() == 0 );
+}
+
+TEST( write_ply_large_polygon )
+{
+	//a disk of a 300-gon and a triangle, the lists need uint lengths
+	const int n = 300;
+	FILE * fp = fopen( "test_polygon.m", "w" );
+	for( int i = 0; i < n; i ++ )
+		fprintf( fp, "Vertex %d %.17g %.17g 0\n", i + 1, cos( 2 * 3.14159265358979 * i / n ), sin( 2 * 3.14159265358979 * i / n ) );
+	fprintf( fp, "Vertex %d 2 0 0\nFace 1", n + 1 );
+	for( int i = 0; i < n; i ++ ) fprintf( fp, " %d", i + 1 );
+	fprintf( fp, "\nFace 2 1 %d 2\n", n + 1 );
+	fclose( fp );
+
+	CGCMesh mesh;
+	mesh.read_m( "test_polygon.m" );
+	CHECK( mesh.numFaces() == 2 );
+	mesh.write_ply( "test_polygon.ply" );
+
+	CGCMesh copy;
+	copy.read_ply( "test_polygon.ply" );
+	CHECK( copy.numVertices() == n + 1 );
+	CHECK( copy.numFaces() == 2 );
+	CHECK( copy.numEdges() == mesh.numEdges() );
+
+	//triangles keep the uchar lengths
+	Tests::write_torus( "test_torus.m", 6, 8 );
+	CGCMesh torus;
+	torus.read_m( "test_torus.m" );
+	torus.write_ply( "test_torus.ply" );
+	std::ifstream in( "test_torus.ply", std::ios::binary );
+	std::string data( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+	CHECK( data.find( "property list uchar int vertex_indices" ) != std::string::npos );
+}
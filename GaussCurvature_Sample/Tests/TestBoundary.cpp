@@ -0,0 +1,109 @@
+/*!
+*      \file TestBoundary.cpp
+*      \brief Tests of CBoundary and CLoop
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include <stdio.h>
+#include <string.h>
+
+using namespace MeshLib;
+
+namespace
+{
+
+typedef CBoundary<CGCMesh> CGCBoundary;
+typedef CLoop<CGCMesh>     CGCLoop;
+
+//a copy of a .m file with every id multiplied by scale, sparse ids for the map of CBoundary
+void scale_ids( const char * input, const char * output, int scale )
+{
+	FILE * in  = fopen( input, "r" );
+	FILE * out = fopen( output, "w" );
+	char line[1024];
+	while( fgets( line, sizeof( line ), in ) )
+	{
+		int id, a, b, c;
+		if( sscanf( line, "Face %d %d %d %d", &id, &a, &b, &c ) == 4 )
+		{
+			fprintf( out, "Face %d %d %d %d\n", id, a * scale, b * scale, c * scale );
+		}
+		else if( sscanf( line, "Vertex %d", &id ) == 1 )
+		{
+			const char * rest = strchr( line + 7, ' ' );
+			fprintf( out, "Vertex %d%s", id * scale, rest );
+		}
+	}
+	fclose( in );
+	fclose( out );
+}
+
+//the loops cover every boundary edge once, are closed chains, longest first, and each is the
+//loop CLoop traces from its first halfedge
+void check_loops( const char * filename, size_t nloops, size_t outer, size_t inner )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	CGCBoundary boundary( &mesh );
+	std::vector<CGCLoop*> & loops = boundary.loops();
+	CHECK( loops.size() == nloops );
+
+	size_t total = 0;
+	for( size_t l = 0; l < loops.size(); l ++ )
+	{
+		std::list<CGaussHalfEdge*> & hes = loops[l]->halfedges();
+		total += hes.size();
+		CHECK( hes.size() == ( l == 0 ? outer : inner ) );
+		if( l > 0 ) CHECK( loops[l-1]->length() >= loops[l]->length() );
+
+		int chained = 0;
+		double length = 0;
+		for( std::list<CGaussHalfEdge*>::iterator hiter = hes.begin(); hiter != hes.end(); ++ hiter )
+		{
+			std::list<CGaussHalfEdge*>::iterator next = hiter;
+			if( ++ next == hes.end() ) next = hes.begin();
+			CHECK( mesh.isBoundary( *hiter ) );
+			if( mesh.halfedgeTarget( *hiter ) == mesh.halfedgeSource( *next ) ) chained ++;
+			length += mesh.edgeLength( (CGaussEdge*) (*hiter)->edge() );
+		}
+		CHECK( chained == (int) hes.size() );
+		CHECK_NEAR( loops[l]->length(), length, 1e-12 );
+
+		CGCLoop traced( &mesh, hes.back() );
+		CHECK( traced.halfedges() == hes );
+	}
+
+	int nboundary = 0;
+	for( CGCMesh::MeshEdgeIterator eiter( &mesh ); !eiter.end(); ++ eiter )
+	{
+		if( mesh.isBoundary( *eiter ) ) nboundary ++;
+	}
+	CHECK( total == (size_t) nboundary );
+}
+
+}
+
+TEST( boundary_loops )
+{
+	//the outer boundary and two holes apart
+	std::vector<int> holes;
+	holes.push_back( 45 );
+	holes.push_back( 250 );
+	Tests::write_grid( "test_boundary.m", 21, holes );
+	check_loops( "test_boundary.m", 3, 80, 4 );
+
+	//the same with sparse ids
+	scale_ids( "test_boundary.m", "test_boundary_sparse.m", 1000 );
+	check_loops( "test_boundary_sparse.m", 3, 80, 4 );
+
+	//two holes touching at a corner, one loop through the vertex they share
+	holes[1] = 45 + 20 + 1;
+	Tests::write_grid( "test_boundary.m", 21, holes );
+	check_loops( "test_boundary.m", 2, 80, 8 );
+
+	//no boundary
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	check_loops( "test_torus.m", 0, 0, 0 );
+}
@@ -0,0 +1,147 @@
+/*!
+*      \file TestCodec.cpp
+*      \brief Tests of the .mc files of CCompressedMesh and CEdgebreaker
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include "Mesh/CompressedMesh.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the faces as vertex id triples, rotated to start with the smallest id, orientation kept
+std::set< std::vector<int> > face_set( CGCMesh & mesh, const std::vector<int> & id )
+{
+	std::set< std::vector<int> > faces;
+	for( CGCMesh::MeshFaceIterator fiter( &mesh ); !fiter.end(); ++ fiter )
+	{
+		std::array<CGaussVertex*,3> v = mesh.faceVertices( *fiter );
+		std::vector<int> f( 3 );
+		for( int i = 0; i < 3; i ++ ) f[i] = id.empty() ? v[i]->id() : id[ v[i]->id() ];
+		while( f[0] > f[1] || f[0] > f[2] ) std::rotate( f.begin(), f.begin() + 1, f.end() );
+		faces.insert( f );
+	}
+	return faces;
+}
+
+//write and read back the mesh of filename, compare the connectivity and the points
+void round_trip( const char * filename, int bits )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	mesh.write_mc( "test_codec.mc", bits );
+
+	CGCMesh decoded;
+	CHECK( decoded.read_mc( "test_codec.mc" ) );
+	CHECK( decoded.numVertices() == mesh.numVertices() );
+	CHECK( decoded.numEdges() == mesh.numEdges() );
+	CHECK( decoded.numFaces() == mesh.numFaces() );
+	CGCMesh::CBoundary boundary( &mesh ), decoded_boundary( &decoded );
+	CHECK( decoded_boundary.loops().size() == boundary.loops().size() );
+
+	//the quantization error is at most half a step of the bounding box on every axis
+	CPoint lo( 1e300, 1e300, 1e300 ), hi( -1e300, -1e300, -1e300 );
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+	for( int k = 0; k < 3; k ++ )
+	{
+		lo[k] = std::min( lo[k], (*viter)->point()[k] );
+		hi[k] = std::max( hi[k], (*viter)->point()[k] );
+	}
+	CPoint step;
+	for( int k = 0; k < 3; k ++ ) step[k] = ( hi[k] - lo[k] ) / ( ( 1 << bits ) - 1 ) / 2 + 1e-12;
+
+	//the vertices are renumbered, match every decoded vertex with the nearest original one
+	std::vector<int> id( decoded.numVertices() + 1, 0 );
+	int              within = 0;
+	for( CGCMesh::MeshVertexIterator viter( &decoded ); !viter.end(); ++ viter )
+	{
+		CGaussVertex * pV   = *viter;
+		CGaussVertex * best = NULL;
+		for( CGCMesh::MeshVertexIterator witer( &mesh ); !witer.end(); ++ witer )
+		{
+			if( best == NULL || ( (*witer)->point() - pV->point() ).norm() < ( best->point() - pV->point() ).norm() ) best = *witer;
+		}
+		id[ pV->id() ] = best->id();
+		CPoint d = best->point() - pV->point();
+		if( fabs( d[0] ) <= step[0] && fabs( d[1] ) <= step[1] && fabs( d[2] ) <= step[2] ) within ++;
+	}
+	CHECK( within == decoded.numVertices() );
+	CHECK( face_set( decoded, id ) == face_set( mesh, std::vector<int>() ) );
+}
+
+//the bytes of a file
+std::string read_bytes( const char * filename )
+{
+	std::string data;
+	FILE * fp = fopen( filename, "rb" );
+	char   buffer[4096];
+	size_t n;
+	while( ( n = fread( buffer, 1, sizeof( buffer ), fp ) ) > 0 ) data.append( buffer, n );
+	fclose( fp );
+	return data;
+}
+
+//write the bytes to a file and read it, the read must fail and leave the mesh empty
+bool rejected( const std::string & data )
+{
+	FILE * fp = fopen( "test_damaged.mc", "wb" );
+	fwrite( data.data(), 1, data.size(), fp );
+	fclose( fp );
+	CGCMesh mesh;
+	return !mesh.read_mc( "test_damaged.mc" ) && mesh.numVertices() == 0 && mesh.numFaces() == 0;
+}
+
+}
+
+TEST( codec_round_trip )
+{
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	round_trip( "test_torus.m", 16 );
+	round_trip( "test_torus.m", 8 );
+
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_holes.m", 31, holes );
+	round_trip( "test_holes.m", 16 );
+}
+
+TEST( codec_rejects_damaged_streams )
+{
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_holes.m", 31, holes );
+	CGCMesh mesh;
+	mesh.read_m( "test_holes.m" );
+	mesh.write_mc( "test_codec.mc" );
+	std::string data = read_bytes( "test_codec.mc" );
+	CHECK( data.size() > sizeof( CCompressedMeshHeader ) );
+
+	//every truncation, the header included
+	int truncated = 0;
+	for( size_t n = 0; n < data.size(); n ++ ) if( rejected( data.substr( 0, n ) ) ) truncated ++;
+	CHECK( truncated == (int) data.size() );
+
+	//a flipped bit anywhere, and trailing garbage
+	int flipped = 0, tries = 0;
+	for( size_t i = 0; i < data.size(); i += 7 )
+	{
+		std::string damaged = data;
+		damaged[i] ^= (char)( 1 << ( i % 8 ) );
+		tries ++;
+		if( rejected( damaged ) ) flipped ++;
+	}
+	CHECK( flipped == tries );
+	CHECK( rejected( data + std::string( 16, '\0' ) ) );
+}
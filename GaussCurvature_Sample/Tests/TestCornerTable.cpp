@@ -0,0 +1,125 @@
+/*!
+*      \file TestCornerTable.cpp
+*      \brief Tests of CCornerTable
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include "Mesh/CornerTable.h"
+#include <stdio.h>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the opposites and the boundary flags of the table are the adjacency of the halfedge mesh
+void check_table( CGCMesh & mesh, CCornerTable & table )
+{
+	CHECK( table.numVertices() == mesh.numVertices() );
+	CHECK( table.numFaces() == mesh.numFaces() );
+	CHECK( table.numEdges() == mesh.numEdges() );
+
+	int same = 0;
+	for( int c = 0; c < table.numCorners(); c ++ )
+	{
+		//the edge facing c runs from the vertex of next(c) to that of prev(c)
+		CGaussVertex * a = mesh.idVertex( table.vertexId( table.V( CCornerTable::next( c ) ) ) );
+		CGaussVertex * b = mesh.idVertex( table.vertexId( table.V( CCornerTable::prev( c ) ) ) );
+		CGaussEdge   * e = mesh.vertexEdge( a, b );
+		if( e == NULL ) continue;
+
+		int o = table.O( c );
+		if( o < 0 )
+		{
+			if( mesh.isBoundary( e ) ) same ++;
+			continue;
+		}
+		if( !mesh.isBoundary( e ) && table.O( o ) == c
+			&& table.V( CCornerTable::next( o ) ) == table.V( CCornerTable::prev( c ) )
+			&& table.V( CCornerTable::prev( o ) ) == table.V( CCornerTable::next( c ) ) ) same ++;
+	}
+	CHECK( same == table.numCorners() );
+
+	int labeled = 0;
+	for( int v = 0; v < table.numVertices(); v ++ )
+	{
+		if( table.vertexBoundary( v ) == mesh.idVertex( table.vertexId( v ) )->boundary() ) labeled ++;
+	}
+	CHECK( labeled == table.numVertices() );
+}
+
+//overwrite the int at index i of the block at offset of an .mb file
+void patch_int( const char * filename, unsigned long long offset, int i, int value )
+{
+	FILE * fp = fopen( filename, "r+b" );
+	fseek( fp, (long)( offset + i * sizeof(int) ), SEEK_SET );
+	fwrite( &value, sizeof(int), 1, fp );
+	fclose( fp );
+}
+
+//the header of an .mb file
+CBinaryMeshHeader read_header( const char * filename )
+{
+	CBinaryMeshHeader h;
+	FILE * fp = fopen( filename, "rb" );
+	size_t n = fread( &h, sizeof( h ), 1, fp );
+	fclose( fp );
+	CHECK( n == 1 );
+	return h;
+}
+
+}
+
+TEST( corner_table_adjacency )
+{
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_grid.m", 31, holes );
+	CGCMesh mesh;
+	mesh.read_m( "test_grid.m" );
+
+	CCornerTable table;
+	table.from_mesh( &mesh );
+	check_table( mesh, table );
+
+	//the .mb file keeps the table
+	table.write_mb( "test_corner_table.mb" );
+	CCornerTable copy;
+	CHECK( copy.read_mb( "test_corner_table.mb" ) );
+	CHECK( copy.corners() == table.corners() && copy.opposites() == table.opposites() );
+	check_table( mesh, copy );
+}
+
+TEST( corner_table_rejects_bad_indices )
+{
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	CCornerTable table;
+	CHECK( table.read_m( "test_torus.m" ) );
+	int nv = table.numVertices();
+	table.write_mb( "test_corner_bad.mb" );
+	CBinaryMeshHeader h = read_header( "test_corner_bad.mb" );
+
+	//a corner beyond the vertices
+	patch_int( "test_corner_bad.mb", h.corner_offset, 7, nv + 5 );
+	CCornerTable bad;
+	CHECK( !bad.read_mb( "test_corner_bad.mb" ) );
+	CHECK( bad.numVertices() == 0 && bad.numFaces() == 0 );
+
+	//an opposite which does not point back
+	table.write_mb( "test_corner_bad.mb" );
+	int o = table.O( 7 );
+	patch_int( "test_corner_bad.mb", h.opposite_offset, 7, o == 0 ? 1 : 0 );
+	CHECK( !bad.read_mb( "test_corner_bad.mb" ) );
+
+	//an opposite beyond the corners
+	table.write_mb( "test_corner_bad.mb" );
+	patch_int( "test_corner_bad.mb", h.opposite_offset, 7, 3 * table.numFaces() );
+	CHECK( !bad.read_mb( "test_corner_bad.mb" ) );
+
+	table.write_mb( "test_corner_bad.mb" );
+	CHECK( bad.read_mb( "test_corner_bad.mb" ) );
+	CHECK( bad.numFaces() == table.numFaces() );
+}
@@ -0,0 +1,292 @@
+/*!
+*      \file TestCurvature.cpp
+*      \brief Tests of CGaussCurvature and the curvature kernel
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include "Conformal/GaussCurvature/GaussCurvature.h"
+#include "Conformal/GaussCurvature/StreamingCurvature.h"
+#include "Delaunay/DelaunayTriangulation.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the torus and a bumped grid with two holes, numbers of faces which are no multiple of a block
+void write_meshes()
+{
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_grid.m", 31, holes );
+}
+
+//the angles of the blocks are those of the serial triangle_angles, bit for bit
+void check_kernel( const char * filename )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	face_corner_angles( &mesh );
+
+	int equal = 0;
+	for( CGCMesh::MeshFaceIterator fiter( &mesh ); !fiter.end(); ++ fiter )
+	{
+		std::array<CGaussVertex*,3>   v = mesh.faceVertices( *fiter );
+		std::array<CGaussHalfEdge*,3> h = mesh.faceHalfedges( *fiter );
+		double angle[3];
+		triangle_angles( v[0]->point(), v[1]->point(), v[2]->point(), angle );
+		if( h[0]->angle() == angle[0] && h[1]->angle() == angle[1] && h[2]->angle() == angle[2] ) equal ++;
+	}
+	CHECK( equal == mesh.numFaces() );
+}
+
+//the lengths are those of the points, the total curvature is 2 PI times the Euler characteristic,
+//and write_m writes none of the attributes
+void check_curvature( const char * filename, int euler )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	CGaussCurvature<CGCMesh> curvature( &mesh );
+	curvature._calculate_curvature();
+	CHECK_NEAR( curvature._total_curvature(), 2 * PI * euler, 1e-9 );
+
+	int measured = 0;
+	for( CGCMesh::MeshEdgeIterator eiter( &mesh ); !eiter.end(); ++ eiter )
+	{
+		CGaussVertex * v1 = mesh.edgeVertex1( *eiter );
+		CGaussVertex * v2 = mesh.edgeVertex2( *eiter );
+		double length = ( v1->point() - v2->point() ).norm();
+		if( length > 0 && fabs( ( *eiter )->length() - length ) <= 1e-12 * length ) measured ++;
+	}
+	CHECK( measured == mesh.numEdges() );
+
+	mesh.write_m( "test_curvature_out.m" );
+	FILE * fp = fopen( "test_curvature_out.m", "r" );
+	char line[1024];
+	int attributes = 0;
+	while( fp != NULL && fgets( line, sizeof( line ), fp ) )
+	{
+		if( strstr( line, "k=" ) || strstr( line, "length=" ) || strstr( line, "angle=" ) || strstr( line, "area=" ) ) attributes ++;
+	}
+	if( fp != NULL ) fclose( fp );
+	CHECK( attributes == 0 );
+}
+
+//run f on one thread, the parallel loops inside a task of the pool execute on its thread
+template<typename F>
+void serially( const F & f )
+{
+	CThreadPool::instance().run( 2, [&]( size_t task, int ){ if( task == 0 ) f(); } );
+}
+
+//curvature, normals and total of a mesh
+struct CResult
+{
+	std::vector<double> k, area;
+	std::vector<CPoint> face_normal, vertex_normal;
+	double              total;
+
+	void compute( const char * filename )
+	{
+		CGCMesh mesh;
+		mesh.read_m( filename );
+		CGaussCurvature<CGCMesh> curvature( &mesh );
+		curvature._calculate_face_normal();
+		curvature._calculate_vertex_normal();
+		curvature._calculate_curvature();
+		total = curvature._total_curvature();
+		for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+		{
+			k.push_back( ( *viter )->k() );
+			vertex_normal.push_back( ( *viter )->normal() );
+		}
+		for( CGCMesh::MeshFaceIterator fiter( &mesh ); !fiter.end(); ++ fiter )
+		{
+			area.push_back( ( *fiter )->area() );
+			face_normal.push_back( ( *fiter )->normal() );
+		}
+	};
+	bool operator==( const CResult & r ) const
+	{
+		return k == r.k && area == r.area && total == r.total
+			&& std::equal( face_normal.begin(), face_normal.end(), r.face_normal.begin(), _same )
+			&& std::equal( vertex_normal.begin(), vertex_normal.end(), r.vertex_normal.begin(), _same );
+	};
+	static bool _same( const CPoint & a, const CPoint & b ) { return a[0] == b[0] && a[1] == b[1] && a[2] == b[2]; };
+};
+
+//a copy of a .m file with the faces before the vertices, the faces wait for their vertices
+void faces_first( const char * input, const char * output )
+{
+	FILE * in  = fopen( input, "r" );
+	std::vector<std::string> vertices, faces;
+	char line[1024];
+	while( fgets( line, sizeof( line ), in ) )
+	{
+		if( strncmp( line, "Face", 4 ) == 0 ) faces.push_back( line );
+		else vertices.push_back( line );
+	}
+	fclose( in );
+	FILE * out = fopen( output, "w" );
+	for( size_t i = 0; i < faces.size(); i ++ )    fputs( faces[i].c_str(), out );
+	for( size_t i = 0; i < vertices.size(); i ++ ) fputs( vertices[i].c_str(), out );
+	fclose( out );
+}
+
+//the streaming counts and total are those of the mesh in memory
+void check_streaming( const char * filename )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	CGaussCurvature<CGCMesh> curvature( &mesh );
+	curvature._calculate_curvature();
+	CBoundary<CGCMesh> boundary( &mesh );
+	int euler = mesh.numVertices() - mesh.numEdges() + mesh.numFaces();
+
+	CStreamingCurvature streaming;
+	CHECK( streaming.read( filename ) );
+	CHECK( streaming.vertices() == mesh.numVertices() );
+	CHECK( streaming.edges() == mesh.numEdges() );
+	CHECK( streaming.faces() == mesh.numFaces() );
+	CHECK( streaming.euler() == euler );
+	CHECK( streaming.boundaries() == (int) boundary.loops().size() );
+	CHECK( streaming.genus() == ( 2 - (int) boundary.loops().size() - euler ) / 2 );
+	CHECK( streaming.nonmanifold() == 0 );
+	CHECK_NEAR( streaming.total_curvature(), curvature._total_curvature(), 1e-9 );
+	CHECK_NEAR( streaming.total_curvature(), 2 * PI * euler, 1e-9 );
+}
+
+}
+
+TEST( curvature_kernel_matches_serial_angles )
+{
+	write_meshes();
+	check_kernel( "test_torus.m" );
+	check_kernel( "test_grid.m" );
+}
+
+TEST( curvature_edge_lengths )
+{
+	write_meshes();
+	check_curvature( "test_torus.m", 0 );
+	//the hole at the side of the grid opens its boundary, the other one is a loop of its own
+	check_curvature( "test_grid.m", 0 );
+}
+
+TEST( curvature_does_not_depend_on_threads )
+{
+	//enough faces for many chunks of the parallel loops
+	Tests::write_torus( "test_big_torus.m", 97, 103 );
+	CResult parallel, serial;
+	parallel.compute( "test_big_torus.m" );
+	serially( [&](){ serial.compute( "test_big_torus.m" ); } );
+	CHECK( parallel.k.size() == 97 * 103 );
+	CHECK( parallel == serial );
+	CHECK_NEAR( parallel.total, 0, 1e-9 );
+}
+
+//the incremental curvature equals the curvature computed from scratch
+void check_incremental( CGCMesh & mesh, CGaussCurvature<CGCMesh> & curvature )
+{
+	std::vector<double> k;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter ) k.push_back( ( *viter )->k() );
+	double total = curvature._total_curvature();
+
+	curvature._calculate_curvature();
+	size_t i = 0, equal = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter, ++ i )
+	{
+		if( fabs( k[i] - ( *viter )->k() ) <= 1e-12 ) equal ++;
+	}
+	CHECK( equal == k.size() );
+	CHECK_NEAR( total, curvature._total_curvature(), 1e-9 );
+}
+
+TEST( curvature_follows_the_edits )
+{
+	//a height field, triangulated point by point, the curvature observes the splits and flips
+	CGCMesh mesh;
+	CDelaunayTriangulation<CGCMesh> triangulation( &mesh );
+	CGaussCurvature<CGCMesh> curvature( &mesh );
+	triangulation.observer() = [&]( CGaussFace * f[], int n ){ curvature._update_faces( f, n ); };
+
+	std::vector<CPoint> points;
+	for( int j = 0; j <= 8; j ++ )
+	for( int i = 0; i <= 8; i ++ )
+		points.push_back( CPoint( i / 8.0, j / 8.0, 0 ) );
+	srand( 11 );
+	for( int i = 0; i < 400; i ++ )
+		points.push_back( CPoint( (double) rand() / RAND_MAX, (double) rand() / RAND_MAX, 0 ) );
+	for( size_t i = 0; i < points.size(); i ++ )
+		points[i][2] = 0.3 * sin( 3 * points[i][0] ) * cos( 2 * points[i][1] );
+
+	CPoint2 lo( 0, 0 ), hi( 1, 1 );
+	triangulation._create_frame( lo, hi );
+	triangulation._insert_batch( points, lo, hi );
+	CHECK( triangulation.inserted() + triangulation.duplicates() == (int) points.size() );
+
+	//the triangulation with its frame is a disk
+	CHECK_NEAR( curvature._total_curvature(), 2 * PI, 1e-9 );
+	check_incremental( mesh, curvature );
+
+	//moving a vertex updates its ring
+	CGaussVertex * v = triangulation.frame().empty() ? NULL : mesh.idVertex( 40 );
+	CHECK( v != NULL && !v->boundary() );
+	if( v == NULL ) return;
+	v->point()[2] += 0.25;
+	curvature._update_vertex( v );
+	check_incremental( mesh, curvature );
+}
+
+TEST( streaming_curvature_matches_the_mesh )
+{
+	write_meshes();
+	check_streaming( "test_torus.m" );
+	check_streaming( "test_grid.m" );
+	faces_first( "test_grid.m", "test_grid_faces_first.m" );
+	check_streaming( "test_grid_faces_first.m" );
+
+	//two holes inside the grid, three loops
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 500 );
+	Tests::write_grid( "test_grid_holes.m", 31, holes );
+	check_streaming( "test_grid_holes.m" );
+}
+
+TEST( streaming_curvature_pinched_loops )
+{
+	//two squares touching at vertex 3, each has a loop of its own
+	FILE * fp = fopen( "test_pinched.m", "w" );
+	fprintf( fp, "Vertex 1 0 0 0\nVertex 2 1 0 0\nVertex 3 1 1 0\nVertex 4 0 1 0\nVertex 5 2 1 0\nVertex 6 2 2 0\nVertex 7 1 2 0\n" );
+	fprintf( fp, "Face 1 1 2 3\nFace 2 1 3 4\nFace 3 3 5 6\nFace 4 3 6 7\n" );
+	fclose( fp );
+
+	//two holes touching at a corner, the faces around the vertex join them into one loop
+	std::vector<int> holes;
+	holes.push_back( 45 );
+	holes.push_back( 45 + 20 + 1 );
+	Tests::write_grid( "test_grid_touching.m", 21, holes );
+
+	const char * files[] = { "test_pinched.m", "test_grid_touching.m" };
+	int expected[] = { 2, 2 };
+	for( int k = 0; k < 2; k ++ )
+	{
+		CGCMesh mesh;
+		mesh.read_m( files[k] );
+		CBoundary<CGCMesh> boundary( &mesh );
+		CStreamingCurvature streaming;
+		CHECK( streaming.read( files[k] ) );
+		CHECK( streaming.boundaries() == expected[k] );
+		CHECK( streaming.boundaries() == (int) boundary.loops().size() );
+		CHECK( streaming.edges() == mesh.numEdges() );
+	}
+}
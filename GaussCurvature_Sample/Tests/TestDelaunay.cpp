@@ -0,0 +1,216 @@
+/*!
+*      \file TestDelaunay.cpp
+*      \brief Tests of CDelaunayTriangulation
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Mesh/BaseMesh.h"
+#include "Mesh/Vertex.h"
+#include "Mesh/HalfEdge.h"
+#include "Mesh/Edge.h"
+#include "Mesh/Face.h"
+#include "Mesh/MeshJournal.h"
+#include "Delaunay/DelaunayTriangulation.h"
+#include <stdlib.h>
+#include <set>
+#include <filesystem>
+
+using namespace MeshLib;
+
+namespace
+{
+
+typedef CBaseMesh<CVertex, CEdge, CFace, CHalfEdge> CPlanarMesh;
+typedef CDelaunayTriangulation<CPlanarMesh>         CTriangulation;
+
+//the points of an n x n grid of step 1, every point after the first few lies on an edge or
+//on the circle of a face, the degenerate cases of the insertion
+std::vector<CPoint> grid_points( int n )
+{
+	std::vector<CPoint> points;
+	for( int j = 0; j < n; j ++ )
+	for( int i = 0; i < n; i ++ )
+		points.push_back( CPoint( i, j, 0 ) );
+	return points;
+}
+
+//no vertex lies strictly inside the circle of the face across an interior edge
+bool is_delaunay( CPlanarMesh & mesh )
+{
+	for( std::list<CEdge*>::iterator eiter = mesh.edges().begin(); eiter != mesh.edges().end(); ++ eiter )
+	{
+		CEdge * e = *eiter;
+		if( mesh.isBoundary( e ) ) continue;
+		CHalfEdge * h = mesh.edgeHalfedge( e, 0 );
+		CHalfEdge * t = mesh.edgeHalfedge( e, 1 );
+		CPoint2 a = mesh.halfedgeSource( h )->uv();
+		CPoint2 b = mesh.halfedgeTarget( h )->uv();
+		CPoint2 c = mesh.halfedgeTarget( mesh.halfedgeNext( h ) )->uv();
+		CPoint2 d = mesh.halfedgeTarget( mesh.halfedgeNext( t ) )->uv();
+
+		//d is inside the circle of the ccw triangle abc if the determinant is positive
+		double m[3][3];
+		CPoint2 p[3] = { a, b, c };
+		for( int i = 0; i < 3; i ++ )
+		{
+			double x = p[i][0] - d[0], y = p[i][1] - d[1];
+			m[i][0] = x; m[i][1] = y; m[i][2] = x * x + y * y;
+		}
+		double det = m[0][0] * ( m[1][1] * m[2][2] - m[1][2] * m[2][1] )
+		           - m[0][1] * ( m[1][0] * m[2][2] - m[1][2] * m[2][0] )
+		           + m[0][2] * ( m[1][0] * m[2][1] - m[1][1] * m[2][0] );
+		double scale = m[0][2] * m[1][2] * m[2][2];
+		if( det > 1e-9 * ( scale > 1 ? scale : 1 ) ) return false;
+	}
+	return true;
+}
+
+//every face is ccw in the plane
+bool is_ccw( CPlanarMesh & mesh )
+{
+	for( std::list<CFace*>::iterator fiter = mesh.faces().begin(); fiter != mesh.faces().end(); ++ fiter )
+	{
+		std::array<CVertex*,3> v = mesh.faceVertices( *fiter );
+		if( CTriangulation::_area( v[0]->uv(), v[1]->uv(), v[2]->uv() ) <= 0 ) return false;
+	}
+	return true;
+}
+
+//the faces as sorted vertex id triples
+std::set< std::array<int,3> > face_set( CPlanarMesh & mesh )
+{
+	std::set< std::array<int,3> > faces;
+	for( std::list<CFace*>::iterator fiter = mesh.faces().begin(); fiter != mesh.faces().end(); ++ fiter )
+	{
+		std::array<CVertex*,3> v = mesh.faceVertices( *fiter );
+		std::array<int,3> ids = {{ v[0]->id(), v[1]->id(), v[2]->id() }};
+		std::sort( ids.begin(), ids.end() );
+		faces.insert( ids );
+	}
+	return faces;
+}
+
+}
+
+TEST( delaunay_degenerate_points )
+{
+	const int n = 11;
+	CPlanarMesh mesh;
+	CTriangulation triangulation( &mesh );
+	CPoint2 lo( 0, 0 ), hi( n - 1, n - 1 );
+	triangulation._create_frame( lo, hi );
+
+	//points on edges are inserted by splitting the edge, the second copy of every point is a duplicate
+	std::vector<CPoint> points = grid_points( n );
+	triangulation._insert_batch( points, lo, hi );
+	CHECK( triangulation.inserted() == n * n );
+	CHECK( triangulation.duplicates() == 0 );
+	triangulation._insert_batch( points, lo, hi );
+	CHECK( triangulation.inserted() == n * n );
+	CHECK( triangulation.duplicates() == n * n );
+
+	std::vector<CPoint> outside( 1, CPoint( n, 0, 0 ) );
+	triangulation._insert_batch( outside, lo, hi );
+	CHECK( triangulation.outside() == 1 );
+
+	CHECK( mesh.numVertices() == n * n + 3 );
+	CHECK( is_ccw( mesh ) );
+	CHECK( is_delaunay( mesh ) );
+
+	//without the frame, the triangulation of a convex polygon with h points on its boundary
+	//has 2V - h - 2 faces and 3V - h - 3 edges
+	triangulation._remove_frame();
+	CHECK( triangulation.frame().empty() );
+	int v = n * n, h = 4 * ( n - 1 );
+	CHECK( mesh.numVertices() == v );
+	CHECK( mesh.numFaces() == 2 * v - h - 2 );
+	CHECK( mesh.numEdges() == 3 * v - h - 3 );
+	CHECK( mesh.numVertices() - mesh.numEdges() + mesh.numFaces() == 1 );
+	bool inside = true;
+	for( std::list<CVertex*>::iterator viter = mesh.vertices().begin(); viter != mesh.vertices().end(); ++ viter )
+	{
+		CPoint2 uv = ( *viter )->uv();
+		inside = inside && uv[0] >= 0 && uv[0] <= n - 1 && uv[1] >= 0 && uv[1] <= n - 1;
+	}
+	CHECK( inside );
+	CHECK( is_ccw( mesh ) );
+	CHECK( is_delaunay( mesh ) );
+
+	//the frameless mesh is written and read like any other
+	mesh.compact_and_reorder();
+	mesh.write_m( "test_delaunay_out.m" );
+	CPlanarMesh copy;
+	copy.read_m( "test_delaunay_out.m" );
+	CHECK( copy.numFaces() == mesh.numFaces() );
+	CHECK( copy.numEdges() == mesh.numEdges() );
+}
+
+TEST( delaunay_journal_replay )
+{
+	//random points and grid points, such that the journal has splits, edge splits and flips
+	std::vector<CPoint> points = grid_points( 6 );
+	srand( 7 );
+	for( int i = 0; i < 300; i ++ )
+		points.push_back( CPoint( 5.0 * rand() / RAND_MAX, 5.0 * rand() / RAND_MAX, 0 ) );
+	CPoint2 lo( 0, 0 ), hi( 5, 5 );
+
+	remove( "test_delaunay.journal" );
+	CPlanarMesh mesh;
+	{
+		CMeshJournal<CPlanarMesh> journal( &mesh );
+		CHECK( journal.open( "test_delaunay.journal" ) );
+		CTriangulation triangulation( &mesh );
+		triangulation.journal() = &journal;
+		triangulation._create_frame( lo, hi );
+		triangulation._insert_batch( points, lo, hi );
+		CHECK( is_delaunay( mesh ) );
+	}
+
+	CPlanarMesh restored;
+	CMeshJournal<CPlanarMesh> journal( &restored );
+	CHECK( journal.open( "test_delaunay.journal" ) );
+	CHECK( restored.numVertices() == mesh.numVertices() );
+	CHECK( face_set( restored ) == face_set( mesh ) );
+	journal.close();
+	remove( "test_delaunay.journal" );
+}
+
+TEST( delaunay_journal_failed_checkpoint )
+{
+	std::vector<CPoint> points = grid_points( 5 );
+	srand( 11 );
+	for( int i = 0; i < 100; i ++ )
+		points.push_back( CPoint( 4.0 * rand() / RAND_MAX, 4.0 * rand() / RAND_MAX, 0 ) );
+	std::vector<CPoint> first( points.begin(), points.begin() + 60 ), second( points.begin() + 60, points.end() );
+	CPoint2 lo( 0, 0 ), hi( 4, 4 );
+
+	remove( "test_checkpoint.journal" );
+	remove( "test_checkpoint.journal.1.mb" );
+	CPlanarMesh mesh;
+	{
+		CMeshJournal<CPlanarMesh> journal( &mesh );
+		CHECK( journal.open( "test_checkpoint.journal" ) );
+		CTriangulation triangulation( &mesh );
+		triangulation.journal() = &journal;
+		triangulation._create_frame( lo, hi );
+		triangulation._insert_batch( first, lo, hi );
+		CHECK( journal.checkpoint() );
+		triangulation._insert_batch( second, lo, hi );
+
+		//the next snapshot cannot be written, a directory is in the way of its file
+		std::filesystem::create_directory( "test_checkpoint.journal.2.mb.tmp" );
+		CHECK( !journal.checkpoint() );
+		std::filesystem::remove( "test_checkpoint.journal.2.mb.tmp" );
+	}
+
+	//the first generation and the edits after it are kept
+	CHECK( std::filesystem::exists( "test_checkpoint.journal.1.mb" ) );
+	CPlanarMesh restored;
+	CMeshJournal<CPlanarMesh> journal( &restored );
+	CHECK( journal.open( "test_checkpoint.journal" ) );
+	CHECK( face_set( restored ) == face_set( mesh ) );
+	journal.close();
+	remove( "test_checkpoint.journal" );
+	remove( "test_checkpoint.journal.1.mb" );
+}
@@ -0,0 +1,59 @@
+/*!
+*      \file TestIterators.cpp
+*      \brief Tests of the ranges of iterators.h, CIteratorRange and CArrayRange
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+using namespace MeshLib;
+
+TEST( iterator_and_array_ranges )
+{
+	//the ranges visit the elements of the wrapped iterators, in their order
+	std::vector<int> holes;
+	holes.push_back( 12 );
+	Tests::write_grid( "test_ranges.m", 6, holes );
+	CGCMesh mesh;
+	mesh.read_m( "test_ranges.m" );
+
+	int same = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+	{
+		CGaussVertex * v = *viter;
+		std::vector<CGaussVertex*> expected, ranged;
+		for( CGCMesh::VertexVertexIterator vviter( v ); !vviter.end(); ++ vviter ) expected.push_back( *vviter );
+		for( CGaussVertex * w : vertex_vertices<CGCMesh>( v ) ) ranged.push_back( w );
+
+		//a range restarts from its first element, and works with the standard algorithms
+		CIteratorRange< VertexVertexIterator<CGCMesh> > ring = vertex_vertices<CGCMesh>( v );
+		std::vector<CGaussVertex*> again( ring.begin(), ring.end() );
+		if( ranged == expected && again == expected && std::distance( ring.begin(), ring.end() ) == (ptrdiff_t) expected.size() ) same ++;
+	}
+	CHECK( same == mesh.numVertices() );
+
+	int triangles = 0;
+	for( CGCMesh::MeshFaceIterator fiter( &mesh ); !fiter.end(); ++ fiter )
+	{
+		std::array<CGaussVertex*,3> v = mesh.faceVertices( *fiter );
+		std::vector<CGaussVertex*> ranged( face_vertices<CGCMesh>( *fiter ).begin(), face_vertices<CGCMesh>( *fiter ).end() );
+		if( ranged.size() == 3 && ranged[0] == v[0] && ranged[1] == v[1] && ranged[2] == v[2] ) triangles ++;
+	}
+	CHECK( triangles == mesh.numFaces() );
+
+	//an array range is a random access view of its elements
+	std::vector<int> values( 10 );
+	std::iota( values.begin(), values.end(), 1 );
+	CArrayRange<int> all( values.data(), values.data() + values.size() ), none( values.data(), values.data() );
+	CHECK( all.size() == 10 && !all.empty() );
+	CHECK( none.size() == 0 && none.empty() && none.begin() == none.end() );
+	CHECK( all[0] == 1 && all[9] == 10 );
+	int sum = 0;
+	for( int x : all ) sum += x;
+	CHECK( sum == 55 );
+	CHECK( std::accumulate( all.begin() + 2, all.end(), 0 ) == 52 );
+}
@@ -0,0 +1,31 @@
+/*!
+*      \file TestMain.cpp
+*      \brief Runs the MeshLib regression tests
+*      \date 10/19/2026
+*
+*	MeshTests [name ...] runs the tests given by name, all of them without arguments. The
+*	test meshes are written to the working directory. The exit code is 1 if a check failed.
+*/
+
+#include <string.h>
+#include "Tests.h"
+
+using namespace MeshLib::Tests;
+
+int main( int argc, char * argv[] )
+{
+	int run = 0;
+	for( size_t t = 0; t < tests().size(); t ++ )
+	{
+		bool selected = ( argc < 2 );
+		for( int i = 1; i < argc; i ++ ) selected = selected || strcmp( argv[i], tests()[t].name ) == 0;
+		if( !selected ) continue;
+
+		int before = failures();
+		tests()[t].run();
+		printf( "%s %s\n", failures() == before ? "passed" : "FAILED", tests()[t].name );
+		run ++;
+	}
+	printf( "%d tests run, %d checks failed\n", run, failures() );
+	return failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/*!
+*      \file TestOneRing.cpp
+*      \brief Tests of COneRing
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include "Delaunay/DelaunayTriangulation.h"
+#include <vector>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the snapshot has the vertices of the mesh and their rings as walked by the iterators
+bool matches( CGCMesh & mesh, COneRing<CGCMesh> & ring )
+{
+	if( ring.size() != mesh.numVertices() ) return false;
+	for( int i = 0; i < ring.size(); i ++ )
+	{
+		CGaussVertex * v = ring.vertex( i );
+		if( ring.index( v ) != i ) return false;
+
+		std::vector<CGaussVertex*> expected( vertex_vertices<CGCMesh>( v ).begin(), vertex_vertices<CGCMesh>( v ).end() );
+		CArrayRange<int> vertices = ring.vertices( i );
+		if( vertices.size() != expected.size() ) return false;
+		for( size_t k = 0; k < expected.size(); k ++ ) if( ring.vertex( vertices[k] ) != expected[k] ) return false;
+
+		std::vector<CGaussFace*> faces( vertex_faces<CGCMesh>( v ).begin(), vertex_faces<CGCMesh>( v ).end() );
+		if( std::vector<CGaussFace*>( ring.faces( i ).begin(), ring.faces( i ).end() ) != faces ) return false;
+	}
+	return true;
+}
+
+}
+
+TEST( one_ring_follows_the_topology_version )
+{
+	CGCMesh mesh;
+	CDelaunayTriangulation<CGCMesh> triangulation( &mesh );
+	std::vector<CPoint> points;
+	for( int j = 0; j <= 6; j ++ )
+	for( int i = 0; i <= 6; i ++ )
+		points.push_back( CPoint( i / 6.0 + 0.01 * j, j / 6.0, 0 ) );
+	CPoint2 lo( 0, 0 ), hi( 1.1, 1 );
+	triangulation._create_frame( lo, hi );
+	triangulation._insert_batch( points, lo, hi );
+
+	COneRing<CGCMesh> ring( &mesh );
+	CHECK( !ring.valid() );
+	ring.update();
+	CHECK( ring.valid() && matches( mesh, ring ) );
+
+	//positions are not part of the snapshot, a valid snapshot is not rebuilt
+	const int * first = ring.vertices( 0 ).begin();
+	ring.vertex( 0 )->point()[2] += 1;
+	CHECK( ring.valid() );
+	ring.update();
+	CHECK( ring.vertices( 0 ).begin() == first );
+
+	//an insertion splits faces and flips edges, the snapshot is stale until the update
+	CGaussVertex * v = NULL;
+	CHECK( triangulation._insert_point( CPoint2( 0.53, 0.41 ), CPoint( 0.53, 0.41, 0 ), v ) == CDelaunayTriangulation<CGCMesh>::INSERTED );
+	CHECK( v != NULL && !ring.valid() && ring.index( v ) == -1 );
+	ring.update();
+	CHECK( ring.valid() && ring.index( v ) >= 0 && matches( mesh, ring ) );
+
+	//deleting the frame removes vertices and faces
+	triangulation._remove_frame();
+	CHECK( !ring.valid() );
+	ring.update();
+	CHECK( ring.valid() && matches( mesh, ring ) );
+}
@@ -0,0 +1,125 @@
+/*!
+*      \file TestPairedMesh.cpp
+*      \brief Tests of CPairedHalfEdgeMesh and its curvature
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include "Conformal/GaussCurvature/GaussCurvature.h"
+#include "Mesh/PairedHalfEdgeMesh.h"
+#include <chrono>
+#include <algorithm>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the rings of the paired mesh are those of the halfedge mesh, in the same ccw order, an interior
+//ring may start at another neighbour
+void check_rings( const char * filename )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	CPairedHalfEdgeMesh paired;
+	paired.from_mesh( &mesh );
+	CHECK( paired.numVertices() == mesh.numVertices() );
+	CHECK( paired.numEdges() == mesh.numEdges() );
+	CHECK( paired.numFaces() == mesh.numFaces() );
+
+	int same = 0, v = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter, ++ v )
+	{
+		std::vector<int> ring, paired_ring;
+		for( CGCMesh::VertexVertexIterator vviter( *viter ); !vviter.end(); ++ vviter ) ring.push_back( ( *vviter )->id() );
+		for( PairedVertexVertexIterator vviter( &paired, v ); !vviter.end(); ++ vviter ) paired_ring.push_back( paired.vertexId( *vviter ) );
+		if( !( *viter )->boundary() && !ring.empty() )
+		{
+			std::vector<int>::iterator first = std::find( paired_ring.begin(), paired_ring.end(), ring[0] );
+			if( first != paired_ring.end() ) std::rotate( paired_ring.begin(), first, paired_ring.end() );
+		}
+		if( paired.vertexId( v ) == ( *viter )->id() && ring == paired_ring && paired.vertexBoundary( v ) == ( *viter )->boundary() ) same ++;
+	}
+	CHECK( same == mesh.numVertices() );
+}
+
+//the curvature and the normals on the paired mesh are those of CGaussCurvature<CGCMesh>
+void check_curvature( const char * filename, int euler )
+{
+	CGCMesh mesh;
+	mesh.read_m( filename );
+	CGaussCurvature<CGCMesh> curvature( &mesh );
+	curvature._calculate_curvature();
+	curvature._calculate_face_normal();
+	curvature._calculate_vertex_normal();
+
+	CPairedHalfEdgeMesh paired;
+	paired.from_mesh( &mesh );
+	CGaussCurvature<CPairedHalfEdgeMesh> paired_curvature( &paired );
+	paired_curvature._calculate_curvature();
+	paired_curvature._calculate_vertex_normal();
+	CHECK_NEAR( paired_curvature._total_curvature(), 2 * PI * euler, 1e-9 );
+
+	int same = 0, v = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter, ++ v )
+	{
+		double dk = fabs( paired.vertexCurvatures()[v] - ( *viter )->k() );
+		double dn = ( paired.vertexNormals()[v] - ( *viter )->normal() ).norm();
+		if( dk <= 1e-12 && dn <= 1e-12 ) same ++;
+	}
+	CHECK( same == mesh.numVertices() );
+}
+
+}
+
+TEST( paired_mesh_rings )
+{
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	check_rings( "test_torus.m" );
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_grid.m", 31, holes );
+	check_rings( "test_grid.m" );
+}
+
+TEST( paired_mesh_curvature )
+{
+	Tests::write_torus( "test_torus.m", 13, 29 );
+	check_curvature( "test_torus.m", 0 );
+	std::vector<int> holes;
+	holes.push_back( 40 );
+	holes.push_back( 300 );
+	Tests::write_grid( "test_grid.m", 31, holes );
+	check_curvature( "test_grid.m", 0 );
+}
+
+TEST( paired_mesh_one_ring_timing )
+{
+	//the sum of the neighbour positions of every vertex, over both layouts, prints the times
+	Tests::write_torus( "test_big_torus.m", 300, 400 );
+	CGCMesh mesh;
+	mesh.read_m( "test_big_torus.m" );
+	CPairedHalfEdgeMesh paired;
+	paired.from_mesh( &mesh );
+
+	typedef std::chrono::steady_clock clock;
+	const int rounds = 5;
+	CPoint sum( 0, 0, 0 ), paired_sum( 0, 0, 0 );
+
+	clock::time_point start = clock::now();
+	for( int r = 0; r < rounds; r ++ )
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+		for( CGCMesh::VertexVertexIterator vviter( *viter ); !vviter.end(); ++ vviter ) sum += ( *vviter )->point();
+	double pointer_time = std::chrono::duration<double>( clock::now() - start ).count();
+
+	start = clock::now();
+	for( int r = 0; r < rounds; r ++ )
+	for( int v = 0; v < paired.numVertices(); v ++ )
+		for( PairedVertexVertexIterator vviter( &paired, v ); !vviter.end(); ++ vviter ) paired_sum += paired.vertexPoint( *vviter );
+	double paired_time = std::chrono::duration<double>( clock::now() - start ).count();
+
+	printf( "one ring of %d vertices x %d: halfedge mesh %.3fs, paired mesh %.3fs\n", paired.numVertices(), rounds, pointer_time, paired_time );
+	CHECK( ( sum - paired_sum ).norm() <= 1e-6 * sum.norm() + 1e-6 );
+}
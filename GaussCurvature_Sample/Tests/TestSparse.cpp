@@ -0,0 +1,140 @@
+/*!
+*      \file TestSparse.cpp
+*      \brief Tests of the sparse solver and CHarmonicMap
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Conformal/GaussCurvature/GaussCurvatureMesh.h"
+#include "Conformal/HarmonicMap/HarmonicMap.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <fstream>
+#include <string>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the 5 point Laplacian of an n x n grid with zero boundary values, symmetric positive definite
+void poisson( int n, CSparseMatrix & A )
+{
+	std::vector<int> sizes( n * n );
+	for( int j = 0; j < n; j ++ )
+	for( int i = 0; i < n; i ++ )
+		sizes[j*n+i] = 1 + ( i > 0 ) + ( i + 1 < n ) + ( j > 0 ) + ( j + 1 < n );
+	A.reserve( sizes, n * n );
+
+	for( int j = 0; j < n; j ++ )
+	for( int i = 0; i < n; i ++ )
+	{
+		int    r = j * n + i;
+		size_t e = A.offset( r );
+		A.column( e ) = r; A.value( e ) = 4;
+		int neighbors[4][2] = { { i - 1, j }, { i + 1, j }, { i, j - 1 }, { i, j + 1 } };
+		for( int k = 0; k < 4; k ++ )
+		{
+			int x = neighbors[k][0], y = neighbors[k][1];
+			if( x < 0 || x >= n || y < 0 || y >= n ) continue;
+			e ++;
+			A.column( e ) = y * n + x; A.value( e ) = -1;
+		}
+	}
+}
+
+//solve A x = A x0 for a random x0, the iterations, -1 if the solver did not converge
+int solve( const CSparseMatrix & A, CPreconditioner * P, double & error )
+{
+	std::vector<double> x0( A.rows() ), b, x;
+	srand( 5 );
+	for( size_t i = 0; i < x0.size(); i ++ ) x0[i] = (double) rand() / RAND_MAX - 0.5;
+	A.multiply( x0, b );
+
+	CConjugateGradient solver( A, P );
+	int iterations = solver.solve( b, x );
+	error = 0;
+	for( size_t i = 0; i < x.size(); i ++ ) error = std::max( error, fabs( x[i] - x0[i] ) );
+	return ( solver.residual() <= 1e-10 ) ? iterations : -1;
+}
+
+}
+
+TEST( conjugate_gradient_converges )
+{
+	const int sizes[2] = { 40, 120 };
+	for( int s = 0; s < 2; s ++ )
+	{
+		CSparseMatrix A;
+		poisson( sizes[s], A );
+
+		double error;
+		int jacobi = solve( A, NULL, error );
+		CHECK( jacobi > 0 );
+		CHECK( error < 1e-6 );
+	}
+}
+
+TEST( harmonic_map_to_the_disk )
+{
+	const int n = 41;
+	Tests::write_grid( "test_disk.m", n );
+	CGCMesh mesh;
+	mesh.read_m( "test_disk.m" );
+	CHarmonicMap<CGCMesh> mapper( &mesh );
+	CHECK( mapper._map() );
+
+	//the boundary is on the unit circle, the interior inside it
+	int placed = 0;
+	for( CGCMesh::MeshVertexIterator viter( &mesh ); !viter.end(); ++ viter )
+	{
+		CGaussVertex * v = *viter;
+		double r = v->uv().norm();
+		if( v->boundary() ? fabs( r - 1 ) < 1e-12 : r < 1 ) placed ++;
+	}
+	CHECK( placed == mesh.numVertices() );
+
+	//no face flips and the faces cover the inscribed polygon of the boundary vertices
+	int    positive = 0, negative = 0;
+	double area = 0;
+	for( CGCMesh::MeshFaceIterator fiter( &mesh ); !fiter.end(); ++ fiter )
+	{
+		std::array<CGaussVertex*,3> v = mesh.faceVertices( *fiter );
+		CPoint2 a = v[1]->uv() - v[0]->uv(), b = v[2]->uv() - v[0]->uv();
+		double s = ( a[0] * b[1] - a[1] * b[0] ) / 2;
+		if( s > 0 ) positive ++;
+		if( s < 0 ) negative ++;
+		area += s;
+	}
+	CHECK( positive == mesh.numFaces() || negative == mesh.numFaces() );
+	//the polygon of 4 ( n - 1 ) vertices spaced by arc length misses a little of the disk
+	CHECK( fabs( area ) < PI && fabs( area ) > PI - 1e-2 );
+}
+
+TEST( harmonic_map_rejects_components )
+{
+	//two disks in one file, the ids of the second one follow those of the first
+	Tests::write_grid( "test_disk.m", 11 );
+	std::ifstream in( "test_disk.m" );
+	FILE * fp = fopen( "test_two_disks.m", "w" );
+	std::string line;
+	while( std::getline( in, line ) )
+	{
+		fprintf( fp, "%s\n", line.c_str() );
+		char   kind[16];
+		int    id, a, b, c;
+		double x, y, z;
+		if( sscanf( line.c_str(), "%15s %d", kind, &id ) != 2 ) continue;
+		if( std::string( kind ) == "Vertex" && sscanf( line.c_str(), "%*s %*d %lf %lf %lf", &x, &y, &z ) == 3 )
+			fprintf( fp, "Vertex %d %.17g %.17g %.17g\n", id + 1000, x + 2, y, z );
+		if( std::string( kind ) == "Face" && sscanf( line.c_str(), "%*s %*d %d %d %d", &a, &b, &c ) == 3 )
+			fprintf( fp, "Face %d %d %d %d\n", id + 1000, a + 1000, b + 1000, c + 1000 );
+	}
+	fclose( fp );
+
+	CGCMesh mesh;
+	mesh.read_m( "test_two_disks.m" );
+	CHECK( mesh.numFaces() == 2 * 2 * 10 * 10 );
+	CHarmonicMap<CGCMesh> mapper( &mesh );
+	CHECK( !mapper._map() );
+}
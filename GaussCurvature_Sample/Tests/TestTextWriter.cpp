@@ -0,0 +1,83 @@
+/*!
+*      \file TestTextWriter.cpp
+*      \brief Tests of the number formatting and the parallel output of TextWriter.h
+*      \date 10/19/2026
+*/
+
+#include "Tests.h"
+#include "Parser/TextWriter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <fstream>
+#include <iterator>
+
+using namespace MeshLib;
+
+namespace
+{
+
+//the text of a file
+std::string read_file( const char * filename )
+{
+	std::ifstream in( filename, std::ios::binary );
+	return std::string( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+}
+
+//a double from random bits, NaN and infinity excluded
+double random_double()
+{
+	unsigned long long bits = 0;
+	for( int k = 0; k < 4; k ++ ) bits = ( bits << 16 ) ^ (unsigned long long)( rand() & 0xffff );
+	double v;
+	memcpy( &v, &bits, sizeof( v ) );
+	return ( v - v == 0 ) ? v : 1.0;
+}
+
+}
+
+TEST( format_double_round_trip )
+{
+	std::vector<double> values;
+	double special[] = { 0.0, -0.0, 0.1, 1.0 / 3.0, -2.5, 1e-300, 4.9e-324, DBL_MIN, DBL_MAX, 123456789012345678.0, 1e22, 0.3 - 0.1 };
+	values.assign( special, special + sizeof( special ) / sizeof( special[0] ) );
+	srand( 5 );
+	for( int i = 0; i < 20000; i ++ ) values.push_back( random_double() );
+
+	//both the shortest form of to_chars and %.17g read back to the same bits
+	int same = 0;
+	for( size_t i = 0; i < values.size(); i ++ )
+	{
+		char text[33], wide[32];
+		text[ format_double( text, values[i] ) ] = 0;
+		snprintf( wide, sizeof( wide ), "%.17g", values[i] );
+		double a = strtod( text, NULL ), b = strtod( wide, NULL );
+		if( memcmp( &a, &values[i], sizeof( a ) ) == 0 && memcmp( &b, &values[i], sizeof( b ) ) == 0
+			&& strlen( text ) <= strlen( wide ) ) same ++;
+	}
+	CHECK( same == (int) values.size() );
+}
+
+TEST( format_parallel_matches_serial )
+{
+	//several rounds of chunks, the last one partial
+	size_t n = 5 * ( 1 << 15 ) + 123;
+	const char * names[] = { "test_format_1.txt", "test_format_3.txt", "test_format_0.txt" };
+	int threads[] = { 1, 3, 0 };
+	for( int k = 0; k < 3; k ++ )
+	{
+		CTextWriter writer;
+		CHECK( writer.open( names[k] ) );
+		format_parallel( writer, n, []( CTextBuffer & buffer, size_t i ){
+			buffer.put_int( (long long) i );
+			buffer.put( ' ' );
+			buffer.put_double( i / 7.0 );
+			buffer.put( '\n' );
+		}, threads[k] );
+		CHECK( writer.close() );
+	}
+	std::string serial = read_file( names[0] );
+	CHECK( std::count( serial.begin(), serial.end(), '\n' ) == (long) n );
+	CHECK( read_file( names[1] ) == serial );
+	CHECK( read_file( names[2] ) == serial );
+}
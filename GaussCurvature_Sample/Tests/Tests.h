@@ -0,0 +1,142 @@
+/*!
+*      \file Tests.h
+*      \brief Registry, checks and test meshes of the MeshLib regression tests
+*      \date 10/19/2026
+*
+*	A test is a function declared by TEST( name ) in one of the Test*.cpp files, TestMain.cpp
+*	runs all of them or those named on the command line. CHECK records a failure with its file
+*	and line and lets the test go on, such that one run reports every broken check.
+*/
+
+#ifndef _MESHLIB_TESTS_H_
+#define _MESHLIB_TESTS_H_
+
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include <vector>
+
+namespace MeshLib
+{
+namespace Tests
+{
+
+/*!	\brief CTest, a registered test */
+struct CTest
+{
+	/*! name of the test, as given to TEST */
+	const char * name;
+	/*! the test function */
+	void (*run)();
+};
+
+/*! The registered tests, in the order of registration. */
+inline std::vector<CTest> & tests()
+{
+	static std::vector<CTest> registry;
+	return registry;
+};
+
+/*! Number of failed checks. */
+inline int & failures()
+{
+	static int count = 0;
+	return count;
+};
+
+/*!	\brief CTestRegistrar, registers a test at static initialization */
+struct CTestRegistrar
+{
+	CTestRegistrar( const char * name, void (*run)() )
+	{
+		CTest test = { name, run };
+		tests().push_back( test );
+	};
+};
+
+/*! Record the result of a check, print it if it failed. */
+inline bool check( bool passed, const char * expression, const char * file, int line )
+{
+	if( passed ) return true;
+	fprintf( stderr, "%s(%d): check failed: %s\n", file, line, expression );
+	failures() ++;
+	return false;
+};
+
+/*!
+	Write a torus of n x m vertices in .m format, the faces are the two triangles of every quad.
+	\param filename output file
+	\param n number of vertices around the tube
+	\param m number of vertices around the axis
+*/
+inline void write_torus( const char * filename, int n, int m )
+{
+	FILE * fp = fopen( filename, "w" );
+	const double pi = 3.14159265358979323846;
+	for( int j = 0; j < m; j ++ )
+	for( int i = 0; i < n; i ++ )
+	{
+		double u = 2 * pi * i / n, v = 2 * pi * j / m;
+		fprintf( fp, "Vertex %d %.17g %.17g %.17g\n", j * n + i + 1, ( 3 + cos( u ) ) * cos( v ), ( 3 + cos( u ) ) * sin( v ), sin( u ) );
+	}
+	int f = 1;
+	for( int j = 0; j < m; j ++ )
+	for( int i = 0; i < n; i ++ )
+	{
+		int a = j * n + i + 1,                 b = j * n + ( i + 1 ) % n + 1;
+		int c = ( j + 1 ) % m * n + i + 1,     d = ( j + 1 ) % m * n + ( i + 1 ) % n + 1;
+		fprintf( fp, "Face %d %d %d %d\n", f ++, a, c, d );
+		fprintf( fp, "Face %d %d %d %d\n", f ++, a, d, b );
+	}
+	fclose( fp );
+};
+
+/*!
+	Write a planar grid of n x n vertices on [0,1]^2 in .m format, lifted by a bump, with
+	the quads listed in holes left out, every hole is a boundary loop of its own if the holes
+	are apart.
+	\param filename output file
+	\param n number of vertices per side
+	\param holes indices j * ( n - 1 ) + i of the quads to leave out
+*/
+inline void write_grid( const char * filename, int n, const std::vector<int> & holes = std::vector<int>() )
+{
+	FILE * fp = fopen( filename, "w" );
+	for( int j = 0; j < n; j ++ )
+	for( int i = 0; i < n; i ++ )
+	{
+		double x = (double) i / ( n - 1 ), y = (double) j / ( n - 1 );
+		fprintf( fp, "Vertex %d %.17g %.17g %.17g {uv=(%.17g %.17g)}\n", j * n + i + 1, x, y, 0.25 * sin( 3 * x ) * cos( 2 * y ), x, y );
+	}
+	int f = 1;
+	for( int j = 0; j + 1 < n; j ++ )
+	for( int i = 0; i + 1 < n; i ++ )
+	{
+		bool hole = false;
+		for( size_t h = 0; h < holes.size(); h ++ ) hole = hole || holes[h] == j * ( n - 1 ) + i;
+		if( hole ) continue;
+		int a = j * n + i + 1, b = a + 1, c = a + n, d = c + 1;
+		fprintf( fp, "Face %d %d %d %d\n", f ++, a, b, d );
+		fprintf( fp, "Face %d %d %d %d\n", f ++, a, d, c );
+	}
+	fclose( fp );
+};
+
+}//name space Tests
+}//name space MeshLib
+
+/*! Declare and register a test. */
+#define TEST( name ) \
+	static void name(); \
+	static MeshLib::Tests::CTestRegistrar name##_registrar( #name, name ); \
+	static void name()
+
+/*! Check a condition, the test goes on if it fails. */
+#define CHECK( condition ) \
+	MeshLib::Tests::check( ( condition ) ? true : false, #condition, __FILE__, __LINE__ )
+
+/*! Check that two numbers differ by at most eps. */
+#define CHECK_NEAR( a, b, eps ) \
+	MeshLib::Tests::check( fabs( (double)( a ) - (double)( b ) ) <= ( eps ), #a " == " #b " +- " #eps, __FILE__, __LINE__ )
+
+#endif //_MESHLIB_TESTS_H_ defined